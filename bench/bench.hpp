@@ -0,0 +1,151 @@
+#ifndef MTP_BENCH_HPP
+#define MTP_BENCH_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace bench {
+
+template <typename T>
+inline auto
+do_not_optimize(T const& value) noexcept -> void
+{
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static_cast<void>(*static_cast<T const volatile*>(&value));
+#endif
+}
+
+struct bench_case
+{
+  char const* name;
+  void (*fn)();
+};
+
+// one measurement, kept so that all of them can be written out as json at the end
+struct result
+{
+  std::string bench_case;
+  std::string name;
+  double ns_per_op;
+  std::size_t iterations;
+};
+
+inline auto
+cases() -> std::vector<bench_case>&
+{
+  static auto registered = std::vector<bench_case>{};
+  return registered;
+}
+
+inline auto
+results() -> std::vector<result>&
+{
+  static auto measured = std::vector<result>{};
+  return measured;
+}
+
+// the case that `run` attributes its results to, set by `main`
+inline auto
+current_case() -> std::string&
+{
+  static auto name = std::string{};
+  return name;
+}
+
+struct registrar
+{
+  registrar(char const* name, void (*fn)())
+  {
+    cases().push_back({ name, fn });
+  }
+};
+
+// calls `op(i)` for `i = 0, 1, ...` and reports the best time per call out of several runs
+template <typename Op>
+auto
+run(std::string_view name, Op&& op) -> double
+{
+  using clock = std::chrono::steady_clock;
+  constexpr auto min_run_time = std::chrono::milliseconds{ 20 };
+  constexpr auto runs = 5;
+
+  auto iterations = std::size_t{ 1 };
+  auto const time = [&] {
+    auto const start = clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+      op(i);
+    }
+    return clock::now() - start;
+  };
+
+  while (time() < min_run_time) {
+    iterations *= 2;
+  }
+
+  auto best = clock::duration::max();
+  for (auto r = 0; r < runs; ++r) {
+    best = std::min(best, time());
+  }
+
+  auto const ns = std::chrono::duration<double, std::nano>{ best }.count()
+                  / static_cast<double>(iterations);
+  std::printf("  %-56.*s %10.3f ns/op\n", static_cast<int>(name.size()), name.data(), ns);
+  results().push_back({ current_case(), std::string{ name }, ns, iterations });
+  return ns;
+}
+
+inline auto
+write_json_string(std::FILE* file, std::string_view str) -> void
+{
+  std::fputc('"', file);
+  for (auto const ch : str) {
+    if (ch == '"' || ch == '\\') {
+      std::fprintf(file, "\\%c", ch);
+    }
+    else if (static_cast<unsigned char>(ch) < 0x20) {
+      std::fprintf(file, "\\u%04x", static_cast<unsigned>(ch));
+    }
+    else {
+      std::fputc(ch, file);
+    }
+  }
+  std::fputc('"', file);
+}
+
+// all results as `{"benchmarks": [{"case", "name", "ns_per_op", "iterations"}, ...]}`
+inline auto
+write_json(std::FILE* file) -> void
+{
+  std::fprintf(file, "{\n  \"benchmarks\": [");
+  auto separator = "\n";
+  for (auto const& r : results()) {
+    std::fprintf(file, "%s    {\"case\": ", separator);
+    write_json_string(file, r.bench_case);
+    std::fprintf(file, ", \"name\": ");
+    write_json_string(file, r.name);
+    std::fprintf(file, ", \"ns_per_op\": %.3f, \"iterations\": %zu}", r.ns_per_op, r.iterations);
+    separator = ",\n";
+  }
+  std::fprintf(file, "\n  ]\n}\n");
+}
+
+} // namespace bench
+
+#define BENCH_CAT_IMPL(a, b) a##b
+#define BENCH_CAT(a, b) BENCH_CAT_IMPL(a, b)
+#define BENCH_CASE_IMPL(fn, name)                                                                  \
+  static void fn();                                                                                \
+  static bench::registrar const BENCH_CAT(fn, _registrar){ name, fn };                             \
+  static void fn()
+#define BENCH_CASE(name) BENCH_CASE_IMPL(BENCH_CAT(bench_case_, __LINE__), name)
+
+#endif // MTP_BENCH_HPP
@@ -0,0 +1,80 @@
+#include "bench.hpp"
+
+#ifdef MTP_AS_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+// header names as they arrive, in the casing of several clients
+constexpr auto headers = std::array<std::string_view, 8>{
+  "Content-Type",   "content-type",   "CONTENT-LENGTH",    "Content-Length",
+  "x-request-id",   "X-Request-Id",   "Transfer-Encoding", "transfer-encoding",
+};
+
+auto
+to_lower(std::string_view str) -> std::string
+{
+  auto lower = std::string{ str };
+  std::ranges::transform(lower, lower.begin(), [](char ch) {
+    return ch >= 'A' && ch <= 'Z' ? static_cast<char>(ch - 'A' + 'a') : ch;
+  });
+  return lower;
+}
+
+template <mtp::basic_fixed_string Name>
+auto
+bench_iequals() -> void
+{
+  auto const prefix = std::string{ Name.view() } + " ";
+  auto const at = [](std::size_t i) { return headers[i % headers.size()]; };
+
+  bench::run(prefix + "to_lower() == view()", [&](std::size_t i) {
+    bench::do_not_optimize(to_lower(at(i)) == Name.view());
+  });
+  bench::run(prefix + "iequals(view(), view())", [&](std::size_t i) {
+    bench::do_not_optimize(mtp::iequals(at(i), Name.view()));
+  });
+  bench::run(prefix + "iequals<Name>(view())", [&](std::size_t i) {
+    bench::do_not_optimize(mtp::iequals<Name>(at(i)));
+  });
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+BENCH_CASE("case_insensitive")
+{
+  bench_iequals<"content-type">();
+  bench_iequals<"transfer-encoding">();
+
+  auto const at = [](std::size_t i) { return headers[i % headers.size()]; };
+  bench::run("std::hash(to_lower())", [&](std::size_t i) {
+    bench::do_not_optimize(std::hash<std::string>{}(to_lower(at(i))));
+  });
+  bench::run("mtp::hash(to_lower())", [&](std::size_t i) {
+    bench::do_not_optimize(mtp::hash<>{}(to_lower(at(i))));
+  });
+  bench::run("ihash", [&](std::size_t i) { bench::do_not_optimize(mtp::ihash{}(at(i))); });
+
+  auto const long_header = std::string(200, 'A');
+  auto const long_lower = std::string(200, 'a');
+  bench::run("to_lower() == view() (200 chars)", [&](std::size_t) {
+    bench::do_not_optimize(to_lower(long_header) == long_lower);
+  });
+  bench::run("iequals (200 chars)", [&](std::size_t) {
+    bench::do_not_optimize(mtp::iequals(long_header, long_lower));
+  });
+}
@@ -0,0 +1,109 @@
+#include "bench.hpp"
+
+#ifdef MTP_AS_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+constexpr auto pool_size = std::size_t{ 64 };
+
+// strings that share a long common prefix and differ in the last character, which is the worst case
+// for an early-exit comparison
+template <typename CharT, std::size_t N, typename Layout>
+auto
+make_pool() -> std::vector<mtp::basic_fixed_string<CharT, N, Layout>>
+{
+  auto pool = std::vector<mtp::basic_fixed_string<CharT, N, Layout>>{};
+  pool.reserve(pool_size);
+  for (std::size_t i = 0; i < pool_size; ++i) {
+    auto chars = std::array<CharT, N>{};
+    for (std::size_t j = 0; j < N; ++j) {
+      chars[j] = static_cast<CharT>('a' + j % 26);
+    }
+    if constexpr (N > 0) {
+      chars[N - 1] = static_cast<CharT>('a' + i % 4);
+    }
+    pool.emplace_back(chars.begin(), chars.end());
+  }
+  return pool;
+}
+
+template <typename CharT, std::size_t N, typename Layout = mtp::layout::packed>
+auto
+bench_compare(char const* type, char const* layout = "") -> void
+{
+  auto const lhs = make_pool<CharT, N, Layout>();
+  auto const rhs = make_pool<CharT, N, Layout>();
+  auto const longer = make_pool<CharT, N + 1, Layout>();
+  auto const prefix = std::string{ type } + "<" + std::to_string(N) + layout + "> ";
+
+  auto const at = [](std::size_t i) { return i % pool_size; };
+
+  auto const strings = [&] {
+    auto pool = std::vector<std::basic_string<CharT>>{};
+    for (auto const& fs : rhs) {
+      pool.emplace_back(fs.view());
+    }
+    return pool;
+  }();
+  auto const lhs_strings = std::vector<std::basic_string<CharT>>(strings);
+
+  bench::run(prefix + "std::basic_string ==", [&](std::size_t i) {
+    bench::do_not_optimize(lhs_strings[at(i)] == strings[at(i + 1)]);
+  });
+  bench::run(prefix + "view() == view()", [&](std::size_t i) {
+    bench::do_not_optimize(lhs[at(i)].view() == rhs[at(i + 1)].view());
+  });
+  bench::run(prefix + "==", [&](std::size_t i) {
+    bench::do_not_optimize(lhs[at(i)] == rhs[at(i + 1)]);
+  });
+  bench::run(prefix + "view() == view() (size mismatch)", [&](std::size_t i) {
+    bench::do_not_optimize(lhs[at(i)].view() == longer[at(i + 1)].view());
+  });
+  bench::run(prefix + "== (size mismatch)", [&](std::size_t i) {
+    bench::do_not_optimize(lhs[at(i)] == longer[at(i + 1)]);
+  });
+  bench::run(prefix + "std::basic_string <=>", [&](std::size_t i) {
+    bench::do_not_optimize(lhs_strings[at(i)] <=> strings[at(i + 1)]);
+  });
+  bench::run(prefix + "view() <=> view()", [&](std::size_t i) {
+    bench::do_not_optimize(lhs[at(i)].view() <=> rhs[at(i + 1)].view());
+  });
+  bench::run(prefix + "<=>", [&](std::size_t i) {
+    bench::do_not_optimize(lhs[at(i)] <=> rhs[at(i + 1)]);
+  });
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+BENCH_CASE("compare")
+{
+  bench_compare<char, 4>("fixed_string");
+  bench_compare<char, 8>("fixed_string");
+  bench_compare<char, 12>("fixed_string");
+  bench_compare<char, 16>("fixed_string");
+  bench_compare<char, 24>("fixed_string");
+  bench_compare<char, 32>("fixed_string");
+  bench_compare<char, 64>("fixed_string");
+  bench_compare<char, 128>("fixed_string");
+  bench_compare<char, 12, mtp::layout::simd<16>>("fixed_string", ", simd<16>");
+  bench_compare<char, 24, mtp::layout::simd<32>>("fixed_string", ", simd<32>");
+  bench_compare<char, 32, mtp::layout::simd<32, false>>("fixed_string", ", simd<32, false>");
+  bench_compare<char, 64, mtp::layout::simd<32>>("fixed_string", ", simd<32>");
+  bench_compare<char16_t, 8>("fixed_u16string");
+  bench_compare<char16_t, 32>("fixed_u16string");
+  bench_compare<char32_t, 16>("fixed_u32string");
+}
@@ -0,0 +1,54 @@
+# Compiler launcher for the compile benchmarks: runs the compiler command following `--` and writes
+# its wall time and peak memory to REPORT as a cmake script read by report.cmake.
+#
+#   cmake -DREPORT=<file> [-DTIME=<GNU time>] -P measure.cmake -- <compiler> <args>...
+
+set(command)
+set(object)
+set(in_command FALSE)
+set(previous)
+math(EXPR last "${CMAKE_ARGC} - 1")
+foreach(i RANGE ${last})
+  set(arg "${CMAKE_ARGV${i}}")
+  if(in_command)
+    list(APPEND command "${arg}")
+    # -o <file> for gcc and clang, /Fo<file> for msvc
+    if(previous STREQUAL "-o")
+      set(object "${arg}")
+    elseif(arg MATCHES "^[-/]Fo(.+)$")
+      set(object "${CMAKE_MATCH_1}")
+    endif()
+    set(previous "${arg}")
+  elseif(arg STREQUAL "--")
+    set(in_command TRUE)
+  endif()
+endforeach()
+
+set(memory_file "${REPORT}.memory")
+if(TIME)
+  get_filename_component(report_dir "${REPORT}" DIRECTORY)
+  file(MAKE_DIRECTORY "${report_dir}")
+  list(PREPEND command "${TIME}" -f %M -o "${memory_file}")
+endif()
+
+string(TIMESTAMP start "%s%f" UTC)
+execute_process(COMMAND ${command} RESULT_VARIABLE result)
+string(TIMESTAMP stop "%s%f" UTC)
+
+if(NOT result EQUAL 0)
+  message(FATAL_ERROR "compiler failed: ${result}")
+endif()
+
+# module dependency scanning goes through the launcher as well, only object compiles are measured
+if(NOT object MATCHES "\\.(o|obj)$")
+  return()
+endif()
+
+math(EXPR microseconds "${stop} - ${start}")
+set(peak_kib "")
+if(TIME AND EXISTS "${memory_file}")
+  file(STRINGS "${memory_file}" peak_kib REGEX "^[0-9]+$")
+  file(REMOVE "${memory_file}")
+endif()
+
+file(WRITE "${REPORT}" "set(compile_us ${microseconds})\nset(peak_kib \"${peak_kib}\")\n")
@@ -0,0 +1,152 @@
+# Prints the compile benchmark results and writes them to JSON as
+# `{"benchmarks": [{"case", "build", "instantiations", "compile_ms", "peak_kib", "object_bytes",
+# "code_bytes", "symbols", "symbol_bytes"}, ...]}`. Peak memory is null when GNU time was not found,
+# code and symbol sizes when there is no nm.
+#
+#   cmake -DOBJECTS=<case|build|object|...> -DREPORT_DIR=<dir> -DCOUNT=<n> [-DNM=<nm>]
+#         -DJSON=<file> -P report.cmake
+
+function(pad out value width)
+  string(LENGTH "${value}" length)
+  if(length LESS width)
+    math(EXPR fill "${width} - ${length}")
+    string(REPEAT " " ${fill} spaces)
+    set(value "${spaces}${value}")
+  endif()
+  set(${out}
+      "${value}"
+      PARENT_SCOPE)
+endfunction()
+
+# defined symbols and the bytes their (mangled) names take in the string table
+function(symbol_table object symbols_out bytes_out)
+  set(symbols "")
+  set(bytes "")
+  if(NM)
+    execute_process(
+      COMMAND ${NM} --defined-only ${object}
+      OUTPUT_VARIABLE listing
+      RESULT_VARIABLE result
+      ERROR_QUIET)
+    if(result EQUAL 0)
+      string(REGEX REPLACE "(^|\n)[0-9a-fA-F]* *[A-Za-z?] " "\\1" names "${listing}")
+      string(REGEX MATCHALL "\n" newlines "${names}")
+      list(LENGTH newlines symbols)
+      string(LENGTH "${names}" bytes)
+      math(EXPR bytes "${bytes} - ${symbols}")
+    endif()
+  endif()
+  set(${symbols_out}
+      "${symbols}"
+      PARENT_SCOPE)
+  set(${bytes_out}
+      "${bytes}"
+      PARENT_SCOPE)
+endfunction()
+
+# bytes of machine code, the sizes of all defined function symbols
+function(code_size object bytes_out)
+  set(bytes "")
+  if(NM)
+    execute_process(
+      COMMAND ${NM} --defined-only --print-size ${object}
+      OUTPUT_VARIABLE listing
+      RESULT_VARIABLE result
+      ERROR_QUIET)
+    if(result EQUAL 0)
+      set(bytes 0)
+      string(REGEX MATCHALL "(^|\n)[0-9a-fA-F]+ [0-9a-fA-F]+ [tTwW] " functions "${listing}")
+      foreach(function IN LISTS functions)
+        string(REGEX MATCH "[0-9a-fA-F]+ [tTwW] $" size "${function}")
+        string(REGEX REPLACE " .*" "" size "${size}")
+        math(EXPR bytes "${bytes} + 0x${size}")
+      endforeach()
+    endif()
+  endif()
+  set(${bytes_out}
+      "${bytes}"
+      PARENT_SCOPE)
+endfunction()
+
+string(REPLACE "|" ";" entries "${OBJECTS}")
+list(LENGTH entries length)
+math(EXPR last "${length} - 1")
+
+message("compile (${COUNT} instantiations per case)")
+message(
+  "  case            build    compile ms   peak MiB   object KiB   code KiB    symbols  symbol KiB")
+
+set(json "{\n  \"benchmarks\": [")
+set(separator "\n")
+foreach(i RANGE 0 ${last} 3)
+  math(EXPR build_index "${i} + 1")
+  math(EXPR object_index "${i} + 2")
+  list(GET entries ${i} case)
+  list(GET entries ${build_index} build)
+  list(GET entries ${object_index} object)
+
+  set(compile_us "")
+  set(peak_kib "")
+  if(EXISTS "${REPORT_DIR}/${case}_${build}.cmake")
+    include("${REPORT_DIR}/${case}_${build}.cmake")
+  endif()
+  if(compile_us STREQUAL "" OR NOT EXISTS "${object}")
+    message(WARNING "no measurement for ${case} (${build}), build its target first")
+    continue()
+  endif()
+
+  file(SIZE "${object}" object_bytes)
+  symbol_table("${object}" symbols symbol_bytes)
+  code_size("${object}" code_bytes)
+
+  math(EXPR compile_ms "${compile_us} / 1000")
+  math(EXPR compile_frac "${compile_us} % 1000 / 100")
+  math(EXPR object_kib "${object_bytes} / 1024")
+  set(peak_mib "n/a")
+  set(peak_json "null")
+  if(NOT peak_kib STREQUAL "")
+    math(EXPR peak_mib "${peak_kib} / 1024")
+    set(peak_json "${peak_kib}")
+  endif()
+  set(code_kib "n/a")
+  set(code_json "null")
+  if(NOT code_bytes STREQUAL "")
+    math(EXPR code_kib "${code_bytes} / 1024")
+    set(code_json "${code_bytes}")
+  endif()
+  set(symbol_kib "n/a")
+  set(symbols_json "null")
+  set(symbol_bytes_json "null")
+  if(NOT symbols STREQUAL "")
+    math(EXPR symbol_kib "${symbol_bytes} / 1024")
+    set(symbols_json "${symbols}")
+    set(symbol_bytes_json "${symbol_bytes}")
+  else()
+    set(symbols "n/a")
+  endif()
+
+  string(SUBSTRING "${case}                " 0 16 case_column)
+  string(SUBSTRING "${build}         " 0 7 build_column)
+  pad(compile_column "${compile_ms}.${compile_frac}" 12)
+  pad(peak_column "${peak_mib}" 11)
+  pad(object_column "${object_kib}" 13)
+  pad(code_column "${code_kib}" 11)
+  pad(symbols_column "${symbols}" 11)
+  pad(symbol_column "${symbol_kib}" 12)
+  message(
+    "  ${case_column}${build_column}${compile_column}${peak_column}${object_column}"
+    "${code_column}${symbols_column}${symbol_column}")
+
+  string(
+    APPEND
+    json
+    "${separator}    {\"case\": \"compile/${case}\", \"build\": \"${build}\", "
+    "\"instantiations\": ${COUNT}, \"compile_ms\": ${compile_ms}.${compile_frac}, "
+    "\"peak_kib\": ${peak_json}, \"object_bytes\": ${object_bytes}, \"code_bytes\": ${code_json}, "
+    "\"symbols\": ${symbols_json}, \"symbol_bytes\": ${symbol_bytes_json}}")
+  set(separator ",\n")
+endforeach()
+
+string(APPEND json "\n  ]\n}\n")
+file(WRITE "${JSON}" "${json}")
+message("results written to ${JSON}")
@@ -0,0 +1,67 @@
+#include "bench.hpp"
+
+#ifdef MTP_AS_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+constexpr auto regions =
+    std::array{ mtp::fixed_string<7>{ "eu-west" }, mtp::fixed_string<7>{ "us-east" } };
+constexpr auto services =
+    std::array{ mtp::fixed_string<6>{ "orders" }, mtp::fixed_string<6>{ "stocks" } };
+constexpr auto prod = mtp::fixed_string<5>{ ".prod" };
+constexpr auto domain = mtp::fixed_string<22>{ ".prod.example.internal" };
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+BENCH_CASE("concat")
+{
+  auto const region_strings = std::array{ std::string{ regions[0].view() },
+                                          std::string{ regions[1].view() } };
+  auto const service_strings = std::array{ std::string{ services[0].view() },
+                                           std::string{ services[1].view() } };
+
+  // "<service>.<region>.prod", short enough for the small string buffer
+  bench::run("std::string + std::string", [&](std::size_t i) {
+    bench::do_not_optimize(service_strings[i % 2] + "." + region_strings[(i / 2) % 2] + ".prod");
+  });
+  bench::run("std::string::append(std::string_view)", [&](std::size_t i) {
+    auto str = std::string{};
+    str.reserve(19);
+    str.append(services[i % 2].view()).append(".").append(regions[(i / 2) % 2].view());
+    bench::do_not_optimize(str.append(".prod"));
+  });
+  bench::run("fixed_string + fixed_string", [&](std::size_t i) {
+    bench::do_not_optimize(services[i % 2] + '.' + regions[(i / 2) % 2] + prod);
+  });
+  bench::run("mtp::concat", [&](std::size_t i) {
+    bench::do_not_optimize(mtp::concat(services[i % 2], '.', regions[(i / 2) % 2], prod));
+  });
+  bench::run("mtp::join", [&](std::size_t i) {
+    bench::do_not_optimize(mtp::join<".">(services[i % 2], regions[(i / 2) % 2], "prod"));
+  });
+
+  // past the small string buffer
+  auto const suffix = std::string{ domain.view() };
+  bench::run("std::string + std::string (long)", [&](std::size_t i) {
+    bench::do_not_optimize(service_strings[i % 2] + "." + region_strings[(i / 2) % 2] + suffix);
+  });
+  bench::run("fixed_string + fixed_string (long)", [&](std::size_t i) {
+    bench::do_not_optimize(services[i % 2] + '.' + regions[(i / 2) % 2] + domain);
+  });
+  bench::run("mtp::concat (long)", [&](std::size_t i) {
+    bench::do_not_optimize(mtp::concat(services[i % 2], '.', regions[(i / 2) % 2], domain));
+  });
+}
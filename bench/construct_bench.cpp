@@ -0,0 +1,90 @@
+#include "bench.hpp"
+
+#ifdef MTP_AS_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+constexpr auto pool_size = std::size_t{ 64 };
+
+// `pool_size` strings of `N` characters laid out back to back, as read from a buffer
+template <std::size_t N>
+auto
+make_chars() -> std::vector<char>
+{
+  auto chars = std::vector<char>(pool_size * N);
+  for (std::size_t i = 0; i < chars.size(); ++i) {
+    chars[i] = static_cast<char>('a' + (i * 7 + i / N) % 26);
+  }
+  return chars;
+}
+
+template <std::size_t N>
+auto
+bench_construct() -> void
+{
+  auto const chars = make_chars<N>();
+  auto const ranges = [&] {
+    auto arrays = std::vector<std::array<char, N>>(pool_size);
+    for (std::size_t i = 0; i < pool_size; ++i) {
+      std::copy_n(chars.begin() + static_cast<std::ptrdiff_t>(i * N), N, arrays[i].begin());
+    }
+    return arrays;
+  }();
+  auto const prefix = "size " + std::to_string(N) + ", ";
+  auto const at = [&](std::size_t i) { return chars.data() + i % pool_size * N; };
+
+  bench::run(prefix + "std::string(first, last)", [&](std::size_t i) {
+    bench::do_not_optimize(std::string(at(i), at(i) + N));
+  });
+  bench::run(prefix + "std::string_view(first, count)", [&](std::size_t i) {
+    bench::do_not_optimize(std::string_view(at(i), N));
+  });
+  bench::run(prefix + "fixed_string(first, last)", [&](std::size_t i) {
+    bench::do_not_optimize(mtp::fixed_string<N>(at(i), at(i) + N));
+  });
+  bench::run(prefix + "std::string(range.begin(), range.end())", [&](std::size_t i) {
+    auto const& range = ranges[i % pool_size];
+    bench::do_not_optimize(std::string(range.begin(), range.end()));
+  });
+  bench::run(prefix + "fixed_string(from_range, range)", [&](std::size_t i) {
+    bench::do_not_optimize(mtp::fixed_string<N>(std::from_range, ranges[i % pool_size]));
+  });
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+BENCH_CASE("construct")
+{
+  // from a literal both `fixed_string` and `string_view` are constants, `std::string` is not
+  bench::run("std::string(literal)", [](std::size_t) {
+    bench::do_not_optimize(std::string("orders.eu-west.prod"));
+  });
+  bench::run("std::string(long literal)", [](std::size_t) {
+    bench::do_not_optimize(std::string("orders.eu-west.prod.example.internal"));
+  });
+  bench::run("std::string_view(literal)", [](std::size_t) {
+    bench::do_not_optimize(std::string_view("orders.eu-west.prod"));
+  });
+  bench::run("fixed_string(literal)", [](std::size_t) {
+    bench::do_not_optimize(mtp::fixed_string<19>{ "orders.eu-west.prod" });
+  });
+
+  bench_construct<8>();
+  bench_construct<32>();
+  bench_construct<128>();
+}
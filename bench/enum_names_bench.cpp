@@ -0,0 +1,158 @@
+#include "bench.hpp"
+
+#ifdef MTP_AS_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+using namespace std::string_view_literals;
+
+// the order status codes of an order entry protocol
+enum class ord_status : std::uint8_t
+{
+  fresh,
+  partially_filled,
+  filled,
+  done_for_day,
+  canceled,
+  replaced,
+  pending_cancel,
+  stopped,
+  rejected,
+  suspended,
+  pending_new,
+  calculated,
+  expired,
+  accepted_for_bidding,
+  pending_replace,
+};
+
+using statuses = mtp::enum_names<ord_status, "NEW", "PARTIALLY_FILLED", "FILLED", "DONE_FOR_DAY",
+                                 "CANCELED", "REPLACED", "PENDING_CANCEL", "STOPPED", "REJECTED",
+                                 "SUSPENDED", "PENDING_NEW", "CALCULATED", "EXPIRED",
+                                 "ACCEPTED_FOR_BIDDING", "PENDING_REPLACE">;
+
+constexpr auto status_count = std::size_t{ 15 };
+
+// the hand written version this replaces
+auto
+switch_name(ord_status s) -> std::string_view
+{
+  switch (s) {
+  case ord_status::fresh: return "NEW";
+  case ord_status::partially_filled: return "PARTIALLY_FILLED";
+  case ord_status::filled: return "FILLED";
+  case ord_status::done_for_day: return "DONE_FOR_DAY";
+  case ord_status::canceled: return "CANCELED";
+  case ord_status::replaced: return "REPLACED";
+  case ord_status::pending_cancel: return "PENDING_CANCEL";
+  case ord_status::stopped: return "STOPPED";
+  case ord_status::rejected: return "REJECTED";
+  case ord_status::suspended: return "SUSPENDED";
+  case ord_status::pending_new: return "PENDING_NEW";
+  case ord_status::calculated: return "CALCULATED";
+  case ord_status::expired: return "EXPIRED";
+  case ord_status::accepted_for_bidding: return "ACCEPTED_FOR_BIDDING";
+  case ord_status::pending_replace: return "PENDING_REPLACE";
+  }
+  return {};
+}
+
+auto
+make_map() -> std::unordered_map<std::string_view, ord_status>
+{
+  auto map = std::unordered_map<std::string_view, ord_status>{};
+  for (std::size_t i = 0; i < status_count; ++i) {
+    map.emplace(switch_name(static_cast<ord_status>(i)), static_cast<ord_status>(i));
+  }
+  return map;
+}
+
+// every name and a near miss of each, shuffled deterministically
+auto
+make_queries() -> std::vector<std::string>
+{
+  auto queries = std::vector<std::string>{};
+  for (std::size_t i = 0; i < status_count; ++i) {
+    auto const name = std::string{ switch_name(static_cast<ord_status>(i)) };
+    queries.push_back(name);
+    queries.push_back(name.substr(0, name.size() - 1) + "X");
+  }
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    std::swap(queries[i], queries[(i * 7919) % queries.size()]);
+  }
+  return queries;
+}
+
+enum class side_flags : std::uint16_t
+{
+};
+
+using sides = mtp::flag_names<side_flags, "BUY", "SELL", "SHORT", "EXEMPT", "CROSS", "AGENCY",
+                              "PRINCIPAL", "RISKLESS">;
+
+auto
+concat_flags(side_flags value) -> std::string
+{
+  constexpr auto names = std::array{ "BUY"sv,    "SELL"sv,   "SHORT"sv,     "EXEMPT"sv,
+                                     "CROSS"sv,  "AGENCY"sv, "PRINCIPAL"sv, "RISKLESS"sv };
+  auto result = std::string{};
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    if ((static_cast<unsigned>(value) >> i & 1u) != 0) {
+      if (!result.empty()) {
+        result += '|';
+      }
+      result += names[i];
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+BENCH_CASE("enum_names")
+{
+  auto const status = [](std::size_t i) { return static_cast<ord_status>((i * 7) % status_count); };
+
+  bench::run("mtp::enum_names::name", [&](std::size_t i) {
+    bench::do_not_optimize(statuses::name(status(i)).size());
+  });
+  bench::run("switch returning string_view", [&](std::size_t i) {
+    bench::do_not_optimize(switch_name(status(i)).size());
+  });
+
+  auto const queries = make_queries();
+  auto const at = [&](std::size_t i) { return std::string_view{ queries[i % queries.size()] }; };
+  auto const map = make_map();
+
+  bench::run("mtp::enum_names::value", [&](std::size_t i) {
+    bench::do_not_optimize(statuses::value(at(i)).has_value());
+  });
+  bench::run("std::unordered_map<string_view, enum>::find", [&](std::size_t i) {
+    bench::do_not_optimize(map.find(at(i)) != map.end());
+  });
+
+  auto const flags = [](std::size_t i) { return static_cast<side_flags>((i * 37) & 0xFF); };
+
+  bench::run("mtp::flag_names::format", [&](std::size_t i) {
+    bench::do_not_optimize(sides::format(flags(i)).size());
+  });
+  bench::run("std::string concatenation", [&](std::size_t i) {
+    bench::do_not_optimize(concat_flags(flags(i)).size());
+  });
+}
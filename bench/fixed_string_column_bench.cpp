@@ -0,0 +1,120 @@
+#include "bench.hpp"
+
+#ifdef MTP_AS_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+constexpr auto rows = std::size_t{ 4096 };
+
+// isin-like codes, about one in eight from the same issuer country and one in 64 the same code
+auto
+make_codes() -> std::vector<mtp::fixed_string<12>>
+{
+  auto codes = std::vector<mtp::fixed_string<12>>{};
+  auto state = std::uint32_t{ 7 };
+  for (std::size_t i = 0; i < rows; ++i) {
+    auto code = std::string{ i % 8 == 0 ? "US" : "GB" };
+    for (std::size_t j = 2; j < 12; ++j) {
+      state = state * 1664525u + 1013904223u;
+      code += static_cast<char>('0' + (i % 64 == 0 ? j : (state >> 24) % 10));
+    }
+    codes.push_back(mtp::fixed_string<12>{ code.begin(), code.end() });
+  }
+  return codes;
+}
+
+template <typename Column>
+auto
+bench_column(std::string_view name, std::vector<mtp::fixed_string<12>> const& codes) -> void
+{
+  auto column = Column{};
+  for (auto const& code : codes) {
+    column.push_back(code);
+  }
+  auto bitmap = std::vector<std::uint64_t>(column.bitmap_size());
+  auto hashes = std::vector<std::size_t>(column.size());
+
+  bench::run(std::string{ "4096 isins ==, " } + std::string{ name }, [&](std::size_t) {
+    bench::do_not_optimize(column.equals(codes[0], bitmap.data()));
+  });
+  bench::run(std::string{ "4096 isins starts_with \"US\", " } + std::string{ name },
+             [&](std::size_t) {
+               bench::do_not_optimize(column.starts_with("US", bitmap.data()));
+             });
+  bench::run(std::string{ "4096 isins hash, " } + std::string{ name }, [&](std::size_t) {
+    column.hash_to(hashes.data());
+    bench::do_not_optimize(hashes.data());
+  });
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+BENCH_CASE("fixed_string_column")
+{
+  auto const codes = make_codes();
+  auto bitmap = std::vector<std::uint64_t>((rows + 63) / 64);
+  auto hashes = std::vector<std::size_t>(rows);
+
+  // the same kernels element by element over the array of strings
+  bench::run("4096 isins ==, std::vector<fixed_string<12>>", [&](std::size_t) {
+    std::fill(bitmap.begin(), bitmap.end(), 0);
+    auto count = std::size_t{ 0 };
+    for (std::size_t i = 0; i < codes.size(); ++i) {
+      auto const match = codes[i] == codes[0];
+      bitmap[i / 64] |= std::uint64_t{ match } << (i % 64);
+      count += match;
+    }
+    bench::do_not_optimize(count);
+  });
+  bench::run("4096 isins starts_with \"US\", std::vector<fixed_string<12>>", [&](std::size_t) {
+    std::fill(bitmap.begin(), bitmap.end(), 0);
+    auto count = std::size_t{ 0 };
+    for (std::size_t i = 0; i < codes.size(); ++i) {
+      auto const match = codes[i].view().starts_with("US");
+      bitmap[i / 64] |= std::uint64_t{ match } << (i % 64);
+      count += match;
+    }
+    bench::do_not_optimize(count);
+  });
+  bench::run("4096 isins hash, std::vector<fixed_string<12>>", [&](std::size_t) {
+    for (std::size_t i = 0; i < codes.size(); ++i) {
+      hashes[i] = mtp::hash<>{}(codes[i]);
+    }
+    bench::do_not_optimize(hashes.data());
+  });
+
+  bench_column<mtp::fixed_string_column<12>>("fixed_string_column<12>", codes);
+  bench_column<mtp::fixed_string_column<12, mtp::layout::simd<16>>>(
+      "fixed_string_column<12, simd<16>>", codes);
+
+  auto column = mtp::fixed_string_column<12>{};
+  for (auto const& code : codes) {
+    column.push_back(code);
+  }
+  auto indices = std::vector<std::size_t>{};
+  for (std::size_t i = 0; i < rows; i += 3) {
+    indices.push_back((i * 2654435761u) % rows);
+  }
+  auto gathered = mtp::fixed_string_column<12>{};
+  gathered.reserve(indices.size());
+  bench::run("gather 1366 isins, fixed_string_column<12>", [&](std::size_t) {
+    gathered.clear();
+    column.gather(indices.data(), indices.size(), gathered);
+    bench::do_not_optimize(gathered.data());
+  });
+}
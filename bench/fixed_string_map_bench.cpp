@@ -0,0 +1,110 @@
+#include "bench.hpp"
+
+#ifdef MTP_AS_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+using key = mtp::fixed_string<12>;
+
+// isin-like keys: two letters, nine alphanumerics and a digit from a fixed sequence
+auto
+make_keys(std::size_t count, std::uint64_t seed) -> std::vector<key>
+{
+  constexpr auto alnum = std::string_view{ "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ" };
+  auto keys = std::vector<key>{};
+  keys.reserve(count);
+  auto state = seed;
+  for (std::size_t i = 0; i < count; ++i) {
+    auto chars = std::array<char, 12>{};
+    for (std::size_t j = 0; j < chars.size(); ++j) {
+      state = state * 6364136223846793005u + 1442695040888963407u;
+      auto const r = static_cast<std::size_t>(state >> 33);
+      chars[j] = j < 2 ? static_cast<char>('A' + r % 26) : j < 11 ? alnum[r % alnum.size()]
+                                                                  : static_cast<char>('0' + r % 10);
+    }
+    keys.emplace_back(chars.begin(), chars.end());
+  }
+  return keys;
+}
+
+// half the queries hit, half miss, shuffled deterministically
+auto
+make_queries(std::vector<key> const& keys) -> std::vector<key>
+{
+  auto queries = keys;
+  auto const misses = make_keys(keys.size(), 2);
+  queries.insert(queries.end(), misses.begin(), misses.end());
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    std::swap(queries[i], queries[(i * 7919) % queries.size()]);
+  }
+  return queries;
+}
+
+template <typename Map, typename MakeKey>
+auto
+bench_map(std::string const& name, std::vector<key> const& keys, std::vector<key> const& queries,
+          MakeKey make_key) -> void
+{
+  auto map = Map{};
+  map.reserve(keys.size());
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    map.try_emplace(make_key(keys[i]), i);
+  }
+
+  bench::run(name + "::find", [&](std::size_t i) {
+    auto const it = map.find(make_key(queries[i % queries.size()]));
+    bench::do_not_optimize(it != map.end() ? it->second : 0);
+  });
+
+  // steady state churn: each key leaves and comes back
+  bench::run(name + "::erase + try_emplace", [&](std::size_t i) {
+    auto const n = (i * 7919) % keys.size();
+    map.erase(make_key(keys[n]));
+    bench::do_not_optimize(map.try_emplace(make_key(keys[n]), n).second);
+  });
+}
+
+auto
+bench_sizes(std::size_t count) -> void
+{
+  auto const keys = make_keys(count, 1);
+  auto const queries = make_queries(keys);
+  auto const suffix = " (" + std::to_string(count) + " keys)";
+  auto const same = [](key const& k) -> key const& { return k; };
+
+  bench_map<mtp::fixed_string_map<12, std::size_t>>("mtp::fixed_string_map" + suffix, keys,
+                                                     queries, same);
+  bench_map<std::unordered_map<key, std::size_t>>("std::unordered_map<fixed_string>" + suffix,
+                                                   keys, queries, same);
+  bench_map<std::unordered_map<key, std::size_t, mtp::hash<key>>>(
+      "std::unordered_map<fixed_string, mtp::hash>" + suffix, keys, queries, same);
+  bench_map<std::unordered_map<std::string, std::size_t>>(
+      "std::unordered_map<std::string>" + suffix, keys, queries,
+      [](key const& k) { return std::string{ k.view() }; });
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+BENCH_CASE("fixed_string_map")
+{
+  bench_sizes(1'000);
+  bench_sizes(1'000'000);
+}
@@ -0,0 +1,115 @@
+#include "bench.hpp"
+
+#ifdef MTP_AS_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#  include <filesystem>
+#  define BENCH_HAS_MMAP
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+// 32 byte records: a 12 character isin, a 4 character currency and an 8 byte price
+constexpr auto record_size = std::size_t{ 32 };
+constexpr auto rows = std::size_t{ 1 } << 20;
+
+auto
+make_records() -> std::vector<unsigned char>
+{
+  auto bytes = std::vector<unsigned char>(rows * record_size);
+  auto state = std::uint32_t{ 3 };
+  for (std::size_t i = 0; i < rows; ++i) {
+    auto* const record = bytes.data() + i * record_size;
+    std::memcpy(record, i % 4 == 0 ? "US" : "GB", 2);
+    for (std::size_t j = 2; j < 12; ++j) {
+      state = state * 1664525u + 1013904223u;
+      record[j] = static_cast<unsigned char>('0' + (state >> 24) % 10);
+    }
+    std::memcpy(record + 12, i % 4 == 0 ? "USD " : "GBP ", 4);
+    auto const price = static_cast<std::int64_t>(state % 100'000);
+    std::memcpy(record + 16, &price, sizeof(price));
+  }
+  return bytes;
+}
+
+// isins starting with "US" and priced in dollars, over `count` records at `data`
+auto
+count_by_copy(unsigned char const* data, std::size_t count) -> std::size_t
+{
+  auto matches = std::size_t{ 0 };
+  for (std::size_t i = 0; i < count; ++i) {
+    auto const* const chars = reinterpret_cast<char const*>(data + i * record_size);
+    auto const isin = mtp::fixed_string<12>{ chars, chars + 12 };
+    auto const currency = mtp::fixed_string<4>{ chars + 12, chars + 16 };
+    matches += isin.starts_with("US") && currency == mtp::fixed_string<4>{ "USD " };
+  }
+  return matches;
+}
+
+auto
+count_by_ref(unsigned char const* data, std::size_t count) -> std::size_t
+{
+  auto matches = std::size_t{ 0 };
+  for (auto const record : mtp::records<record_size>(data, count * record_size)) {
+    matches += record.field<0, 12>().starts_with("US")
+               && record.field<12, 4>() == mtp::fixed_string<4>{ "USD " };
+  }
+  return matches;
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+BENCH_CASE("fixed_string_ref")
+{
+  auto const bytes = make_records();
+
+  bench::run("1M records, copy fields into fixed_string", [&](std::size_t) {
+    bench::do_not_optimize(count_by_copy(bytes.data(), rows));
+  });
+  bench::run("1M records, fixed_string_ref fields", [&](std::size_t) {
+    bench::do_not_optimize(count_by_ref(bytes.data(), rows));
+  });
+
+#ifdef BENCH_HAS_MMAP
+  auto const path =
+      (std::filesystem::temp_directory_path() / "mtp_fixed_string_bench.bin").string();
+  if (auto* const out = std::fopen(path.c_str(), "wb"); out != nullptr) {
+    std::fwrite(bytes.data(), 1, bytes.size(), out);
+    std::fclose(out);
+  }
+
+  // the mapping is opened per run, so the time includes mapping and faulting the pages in
+  bench::run("1M records, fread into a vector", [&](std::size_t) {
+    auto buffer = std::vector<unsigned char>(bytes.size());
+    if (auto* const in = std::fopen(path.c_str(), "rb"); in != nullptr) {
+      bench::do_not_optimize(std::fread(buffer.data(), 1, buffer.size(), in));
+      std::fclose(in);
+    }
+    bench::do_not_optimize(count_by_ref(buffer.data(), rows));
+  });
+  bench::run("1M records, mapped_file", [&](std::size_t) {
+    auto const file = mtp::mapped_file{ path.c_str() };
+    bench::do_not_optimize(count_by_ref(file.data(), file.size() / record_size));
+  });
+  bench::run("1M records, mapped_file populated", [&](std::size_t) {
+    auto const file = mtp::mapped_file{ path.c_str(), { .populate = true } };
+    bench::do_not_optimize(count_by_ref(file.data(), file.size() / record_size));
+  });
+  std::filesystem::remove(path);
+#endif
+}
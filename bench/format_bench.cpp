@@ -0,0 +1,123 @@
+#include "bench.hpp"
+
+#ifdef MTP_AS_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#if __has_include(<format>)
+#  include <format>
+#endif
+#ifdef BENCH_HAS_FMT
+#  include <fmt/format.h>
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+// a log line: "<host>:<port> <status> <latency>ms <path>"
+constexpr auto hosts =
+    std::array{ mtp::fixed_string<8>{ "db-01.eu" }, mtp::fixed_string<8>{ "gw-17.us" } };
+constexpr auto paths = std::array{ std::string_view{ "/api/v1/orders" }, std::string_view{ "/" } };
+
+auto
+write_by_hand(char* out, std::size_t i) -> char*
+{
+  auto const host = hosts[i % 2].view();
+  out = std::copy(host.begin(), host.end(), out);
+  *out++ = ':';
+  out = std::to_chars(out, out + 8, 8000 + i % 100).ptr;
+  *out++ = ' ';
+  out = std::to_chars(out, out + 8, 200 + i % 4).ptr;
+  *out++ = ' ';
+  out = std::to_chars(out, out + 32, static_cast<double>(i % 1000) / 8,
+                      std::chars_format::fixed, 3).ptr;
+  *out++ = 'm';
+  *out++ = 's';
+  *out++ = ' ';
+  auto const path = paths[i % 2];
+  return std::copy(path.begin(), path.end(), out);
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+BENCH_CASE("format")
+{
+  auto buffer = std::array<char, 512>{};
+
+  bench::run("std::snprintf", [&](std::size_t i) {
+    auto const host = hosts[i % 2].view();
+    auto const path = paths[i % 2];
+    bench::do_not_optimize(std::snprintf(buffer.data(), buffer.size(), "%.*s:%zu %zu %.3fms %.*s",
+                                         static_cast<int>(host.size()), host.data(), 8000 + i % 100,
+                                         200 + i % 4, static_cast<double>(i % 1000) / 8,
+                                         static_cast<int>(path.size()), path.data()));
+  });
+  bench::run("std::to_chars by hand", [&](std::size_t i) {
+    bench::do_not_optimize(write_by_hand(buffer.data(), i));
+  });
+#ifdef __cpp_lib_format
+  bench::run("std::format_to", [&](std::size_t i) {
+    bench::do_not_optimize(std::format_to(buffer.data(), "{}:{} {} {:.3f}ms {}",
+                                          hosts[i % 2].view(), 8000 + i % 100, 200 + i % 4,
+                                          static_cast<double>(i % 1000) / 8, paths[i % 2]));
+  });
+#endif
+#ifdef BENCH_HAS_FMT
+  bench::run("fmt::format_to", [&](std::size_t i) {
+    bench::do_not_optimize(fmt::format_to(buffer.data(), "{}:{} {} {:.3f}ms {}",
+                                          hosts[i % 2].view(), 8000 + i % 100, 200 + i % 4,
+                                          static_cast<double>(i % 1000) / 8, paths[i % 2]));
+  });
+#endif
+  bench::run("mtp::format_to", [&](std::size_t i) {
+    bench::do_not_optimize(mtp::format_to<"{}:{} {} {:.3f}ms {}">(
+        buffer.data(), hosts[i % 2], 8000 + i % 100, 200 + i % 4,
+        static_cast<double>(i % 1000) / 8, paths[i % 2]));
+  });
+
+  bench::run("integers, std::snprintf", [&](std::size_t i) {
+    bench::do_not_optimize(
+        std::snprintf(buffer.data(), buffer.size(), "%zu,%zu,%zu", i, i * 7, i * 31));
+  });
+#ifdef __cpp_lib_format
+  bench::run("integers, std::format_to", [&](std::size_t i) {
+    bench::do_not_optimize(std::format_to(buffer.data(), "{},{},{}", i, i * 7, i * 31));
+  });
+#endif
+#ifdef BENCH_HAS_FMT
+  bench::run("integers, fmt::format_to", [&](std::size_t i) {
+    bench::do_not_optimize(fmt::format_to(buffer.data(), "{},{},{}", i, i * 7, i * 31));
+  });
+#endif
+  bench::run("integers, mtp::format", [&](std::size_t i) {
+    bench::do_not_optimize(mtp::format<"{},{},{}">(i, i * 7, i * 31));
+  });
+
+#ifdef __cpp_lib_format
+  // the `std::formatter` of `fixed_string` against those of the standard strings
+  auto const host_strings = std::array{ std::string{ hosts[0].view() },
+                                        std::string{ hosts[1].view() } };
+  bench::run("one string, std::format_to(std::string)", [&](std::size_t i) {
+    bench::do_not_optimize(std::format_to(buffer.data(), "host={:>12}", host_strings[i % 2]));
+  });
+  bench::run("one string, std::format_to(std::string_view)", [&](std::size_t i) {
+    bench::do_not_optimize(std::format_to(buffer.data(), "host={:>12}", hosts[i % 2].view()));
+  });
+  bench::run("one string, std::format_to(fixed_string)", [&](std::size_t i) {
+    bench::do_not_optimize(std::format_to(buffer.data(), "host={:>12}", hosts[i % 2]));
+  });
+#endif
+}
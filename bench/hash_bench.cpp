@@ -0,0 +1,74 @@
+#include "bench.hpp"
+
+#ifdef MTP_AS_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+constexpr auto pool_size = std::size_t{ 64 };
+
+template <std::size_t N>
+auto
+bench_hash() -> void
+{
+  auto pool = std::vector<mtp::fixed_string<N>>{};
+  for (std::size_t i = 0; i < pool_size; ++i) {
+    auto chars = std::array<char, N>{};
+    for (std::size_t j = 0; j < N; ++j) {
+      chars[j] = static_cast<char>('a' + (i + j) % 26);
+    }
+    pool.emplace_back(chars.begin(), chars.end());
+  }
+  auto const prefix = "fixed_string<" + std::to_string(N) + "> ";
+  auto const at = [&](std::size_t i) -> auto const& { return pool[i % pool_size]; };
+
+  auto const strings = [&] {
+    auto copies = std::vector<std::string>{};
+    for (auto const& fs : pool) {
+      copies.emplace_back(fs.view());
+    }
+    return copies;
+  }();
+
+  bench::run(prefix + "std::hash<std::string>", [&](std::size_t i) {
+    bench::do_not_optimize(std::hash<std::string>{}(strings[i % pool_size]));
+  });
+  bench::run(prefix + "std::hash<std::string_view>", [&](std::size_t i) {
+    bench::do_not_optimize(std::hash<std::string_view>{}(at(i).view()));
+  });
+  bench::run(prefix + "std::hash", [&](std::size_t i) {
+    bench::do_not_optimize(std::hash<mtp::fixed_string<N>>{}(at(i)));
+  });
+  bench::run(prefix + "mtp::hash", [&](std::size_t i) {
+    bench::do_not_optimize(mtp::hash<mtp::fixed_string<N>>{}(at(i)));
+  });
+  bench::run(prefix + "mtp::hash (as std::string_view)", [&](std::size_t i) {
+    bench::do_not_optimize(mtp::hash<std::string_view>{}(at(i).view()));
+  });
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+BENCH_CASE("hash")
+{
+  bench_hash<4>();
+  bench_hash<8>();
+  bench_hash<16>();
+  bench_hash<32>();
+  bench_hash<64>();
+  bench_hash<256>();
+}
@@ -0,0 +1,63 @@
+#include "bench.hpp"
+
+#ifdef MTP_AS_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+using namespace std::string_view_literals;
+
+constexpr auto hosts = std::array{ "db"sv, "cache-primary"sv, "gateway"sv, "orders-replica"sv };
+constexpr auto domain = ".prod.example.internal"sv;
+
+// build "<host>-<two digits><domain>", long enough to spill out of the small string buffer
+template <typename Str>
+auto
+build(std::size_t i) -> Str
+{
+  auto str = Str{};
+  str.append(hosts[i % hosts.size()]);
+  str.push_back('-');
+  str.push_back(static_cast<char>('0' + i / 10 % 10));
+  str.push_back(static_cast<char>('0' + i % 10));
+  str.append(domain);
+  return str;
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+BENCH_CASE("inplace_string")
+{
+  bench::run("std::string build", [](std::size_t i) {
+    auto const str = build<std::string>(i);
+    bench::do_not_optimize(str.data());
+  });
+  bench::run("mtp::inplace_string<63> build", [](std::size_t i) {
+    auto const str = build<mtp::inplace_string<63>>(i);
+    bench::do_not_optimize(str.data());
+  });
+
+  auto const sources = std::array{ build<std::string>(1), build<std::string>(2) };
+  auto const inplace_sources =
+      std::array{ build<mtp::inplace_string<63>>(1), build<mtp::inplace_string<63>>(2) };
+  bench::run("std::string copy", [&](std::size_t i) {
+    auto const str = sources[i % 2];
+    bench::do_not_optimize(str.data());
+  });
+  bench::run("mtp::inplace_string<63> copy", [&](std::size_t i) {
+    auto const str = inplace_sources[i % 2];
+    bench::do_not_optimize(str.data());
+  });
+}
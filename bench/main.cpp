@@ -0,0 +1,42 @@
+#include "bench.hpp"
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+auto
+main(int argc, char** argv) -> int
+{
+  // optional arguments: a filter, only cases whose name contains it run, and `--json <file>` to
+  // write all results to `file` once the cases have run
+  auto filter = std::string_view{};
+  auto json = std::string_view{};
+  for (auto i = 1; i < argc; ++i) {
+    if (std::string_view{ argv[i] } == "--json" && i + 1 < argc) {
+      json = argv[++i];
+    }
+    else {
+      filter = argv[i];
+    }
+  }
+
+  for (auto const& c : bench::cases()) {
+    if (std::string_view{ c.name }.find(filter) == std::string_view::npos) {
+      continue;
+    }
+    std::printf("%s\n", c.name);
+    bench::current_case() = c.name;
+    c.fn();
+  }
+
+  if (!json.empty()) {
+    auto* const file = std::fopen(std::string{ json }.c_str(), "w");
+    if (file == nullptr) {
+      std::perror("fixed_string_bench: --json");
+      return 1;
+    }
+    bench::write_json(file);
+    std::fclose(file);
+  }
+  return 0;
+}
@@ -0,0 +1,91 @@
+#include "bench.hpp"
+
+#ifdef MTP_AS_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+// log-like text with one of `keywords` in about one line in sixty four
+template <std::size_t K>
+auto
+make_log(std::size_t size, std::array<std::string_view, K> const& keywords) -> std::string
+{
+  constexpr auto words = std::array<std::string_view, 8>{ "GET ",         "status=200 ",
+                                                          "user=alice ",  "latency_ms=12 ",
+                                                          "path=/api/v1 ", "bytes=5120 ",
+                                                          "host=web-03 ", "INFO " };
+  auto log = std::string{};
+  auto state = std::uint32_t{ 1 };
+  while (log.size() < size) {
+    for (std::size_t w = 0; w < 6; ++w) {
+      state = state * 1664525u + 1013904223u;
+      log += words[(state >> 16) % words.size()];
+    }
+    state = state * 1664525u + 1013904223u;
+    if ((state >> 16) % 64 == 0) {
+      log += keywords[(state >> 8) % K];
+    }
+    log += '\n';
+  }
+  return log;
+}
+
+template <mtp::basic_fixed_string... Keywords>
+auto
+bench_keywords(std::size_t size) -> void
+{
+  constexpr auto keywords = std::array<std::string_view, sizeof...(Keywords)>{ Keywords.view()... };
+  auto const log = make_log(size, keywords);
+  auto const sv = std::string_view{ log };
+  auto const prefix =
+      std::to_string(size) + " bytes, " + std::to_string(keywords.size()) + " keywords ";
+
+  bench::run(prefix + "std::string_view::find per keyword", [&](std::size_t) {
+    auto count = std::size_t{ 0 };
+    for (auto const keyword : keywords) {
+      for (auto pos = sv.find(keyword); pos != sv.npos; pos = sv.find(keyword, pos + 1)) {
+        ++count;
+      }
+    }
+    bench::do_not_optimize(count);
+  });
+  bench::run(prefix + "mtp::find per keyword", [&](std::size_t) {
+    auto count = std::size_t{ 0 };
+    auto const count_one = [&]<mtp::basic_fixed_string Keyword>() {
+      for (auto pos = mtp::find<Keyword>(sv); pos != sv.npos;
+           pos = mtp::find<Keyword>(sv, pos + 1)) {
+        ++count;
+      }
+    };
+    (count_one.template operator()<Keywords>(), ...);
+    bench::do_not_optimize(count);
+  });
+  bench::run(prefix + "mtp::multi_search", [&](std::size_t) {
+    auto count = std::size_t{ 0 };
+    mtp::multi_search<Keywords...>::for_each(sv, [&](mtp::multi_match const&) { ++count; });
+    bench::do_not_optimize(count);
+  });
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+BENCH_CASE("multi_search")
+{
+  bench_keywords<"ERROR", "FATAL", "WARN">(1 << 16);
+  bench_keywords<"ERROR", "FATAL", "WARN", "panic", "timeout", "refused", "segfault", "deadlock",
+                 "corrupt", "denied", "overflow", "abort">(1 << 16);
+}
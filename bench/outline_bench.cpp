@@ -0,0 +1,134 @@
+#include "bench.hpp"
+
+#ifdef MTP_AS_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <string>
+#include <utility>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+// a mixed size workload: each operation goes to the next of `size_count` distinct sizes, so that
+// every size's comparison and swap code competes for the instruction cache as with many sizes in a
+// real binary. sizes up to MTP_OUTLINE_BYTES use their inline paths, the rest the shared kernels
+constexpr auto size_count = std::size_t{ 64 };
+constexpr auto pool_size = std::size_t{ 4 };
+
+template <std::size_t First, std::size_t Step>
+constexpr auto size_at = [](std::size_t i) { return First + i * Step; };
+
+// strings that differ only in their last character, the worst case for an early-exit comparison
+template <std::size_t N>
+auto
+pool() -> std::array<mtp::fixed_string<N>, pool_size>&
+{
+  static auto strings = [] {
+    auto chars = std::array<char, N>{};
+    for (std::size_t j = 0; j < N; ++j) {
+      chars[j] = static_cast<char>('a' + j % 26);
+    }
+    return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      return std::array{ (chars[N - 1] = static_cast<char>('a' + Is),
+                          mtp::fixed_string<N>{ chars.begin(), chars.end() })... };
+    }(std::make_index_sequence<pool_size>{});
+  }();
+  return strings;
+}
+
+template <std::size_t N>
+auto
+equal(std::size_t i) -> bool
+{
+  auto const& strings = pool<N>();
+  return strings[i % pool_size] == strings[(i + 1) % pool_size];
+}
+
+template <std::size_t N>
+auto
+view_equal(std::size_t i) -> bool
+{
+  auto const& strings = pool<N>();
+  return strings[i % pool_size].view() == strings[(i + 1) % pool_size].view();
+}
+
+template <std::size_t N>
+auto
+less(std::size_t i) -> bool
+{
+  auto const& strings = pool<N>();
+  return (strings[i % pool_size] <=> strings[(i + 1) % pool_size]) < 0;
+}
+
+template <std::size_t N>
+auto
+swap(std::size_t i) -> bool
+{
+  auto& strings = pool<N>();
+  strings[i % pool_size].swap(strings[(i + 1) % pool_size]);
+  return strings[0][0] == 'a';
+}
+
+template <std::size_t N>
+struct equal_op
+{
+  static constexpr auto fn = &equal<N>;
+};
+
+template <std::size_t N>
+struct view_equal_op
+{
+  static constexpr auto fn = &view_equal<N>;
+};
+
+template <std::size_t N>
+struct less_op
+{
+  static constexpr auto fn = &less<N>;
+};
+
+template <std::size_t N>
+struct swap_op
+{
+  static constexpr auto fn = &swap<N>;
+};
+
+// one instantiation of `Op` per size
+template <auto Size, template <std::size_t> typename Op>
+constexpr auto table = []<std::size_t... Is>(std::index_sequence<Is...>) {
+  return std::array{ Op<Size(Is)>::fn... };
+}(std::make_index_sequence<size_count>{});
+
+template <auto Size>
+auto
+bench_mixed(std::string const& sizes) -> void
+{
+  auto const run = [&](char const* name, auto const& ops) {
+    bench::run("mixed " + sizes + " " + name, [&](std::size_t i) {
+      bench::do_not_optimize(ops[i % size_count](i));
+    });
+  };
+
+  run("view() == view()", table<Size, view_equal_op>);
+  run("==", table<Size, equal_op>);
+  run("<=>", table<Size, less_op>);
+  run("swap", table<Size, swap_op>);
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+BENCH_CASE("outline")
+{
+  bench_mixed<size_at<1, 1>>("[1, 64]");
+  bench_mixed<size_at<65, 1>>("[65, 128]");
+  bench_mixed<size_at<16, 16>>("[16, 1024]");
+}
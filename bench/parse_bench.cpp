@@ -0,0 +1,86 @@
+#include "bench.hpp"
+
+#ifdef MTP_AS_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+// decimal integers of 1 to 20 digits, cycled through so the length is not predictable
+auto
+make_numbers() -> std::vector<std::string>
+{
+  auto numbers = std::vector<std::string>{};
+  auto state = std::uint64_t{ 0x9E3779B97F4A7C15 };
+  for (std::size_t i = 0; i < 1024; ++i) {
+    state = state * 6364136223846793005 + 1442695040888963407;
+    numbers.push_back(std::to_string(state >> (state % 64)));
+  }
+  return numbers;
+}
+
+// "YYYYMMDDhhmmssff" timestamps
+auto
+make_timestamps() -> std::vector<std::string>
+{
+  auto stamps = std::vector<std::string>{};
+  for (std::size_t i = 0; i < 1024; ++i) {
+    stamps.push_back(std::to_string(2024101700000000 + i * 1013904223 % 100000000));
+  }
+  return stamps;
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+BENCH_CASE("parse")
+{
+  auto const numbers = make_numbers();
+  bench::run("mixed lengths, std::from_chars", [&](std::size_t i) {
+    auto const& str = numbers[i % numbers.size()];
+    auto value = std::uint64_t{};
+    std::from_chars(str.data(), str.data() + str.size(), value);
+    bench::do_not_optimize(value);
+  });
+  bench::run("mixed lengths, mtp::from_chars", [&](std::size_t i) {
+    auto value = std::uint64_t{};
+    mtp::from_chars(numbers[i % numbers.size()], value);
+    bench::do_not_optimize(value);
+  });
+
+  auto const stamps = make_timestamps();
+  auto const fixed_width = [&]<std::size_t Width>() {
+    auto const label = std::to_string(Width) + " digits, ";
+    bench::run(label + "std::from_chars", [&](std::size_t i) {
+      auto const& str = stamps[i % stamps.size()];
+      auto value = std::uint64_t{};
+      std::from_chars(str.data(), str.data() + Width, value);
+      bench::do_not_optimize(value);
+    });
+    bench::run(label + "mtp::from_chars", [&](std::size_t i) {
+      auto value = std::uint64_t{};
+      mtp::from_chars(std::string_view{ stamps[i % stamps.size()] }.substr(0, Width), value);
+      bench::do_not_optimize(value);
+    });
+    bench::run(label + "mtp::from_chars<Width>", [&](std::size_t i) {
+      auto value = std::uint64_t{};
+      mtp::from_chars<Width>(stamps[i % stamps.size()], value);
+      bench::do_not_optimize(value);
+    });
+  };
+  fixed_width.operator()<4>();
+  fixed_width.operator()<8>();
+  fixed_width.operator()<16>();
+}
@@ -0,0 +1,106 @@
+#include "bench.hpp"
+
+#ifdef MTP_AS_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+// identifiers of the form `[A-Z]{3}[0-9]{4}`, one in four with a character out of place
+auto
+make_identifiers() -> std::vector<std::string>
+{
+  auto ids = std::vector<std::string>{};
+  auto state = std::uint32_t{ 1 };
+  for (std::size_t i = 0; i < 1024; ++i) {
+    auto id = std::string{};
+    for (std::size_t j = 0; j < 7; ++j) {
+      state = state * 1664525u + 1013904223u;
+      id += j < 3 ? static_cast<char>('A' + (state >> 16) % 26)
+                  : static_cast<char>('0' + (state >> 16) % 10);
+    }
+    if (i % 4 == 3) {
+      id[(state >> 8) % 7] = '-';
+    }
+    ids.push_back(id);
+  }
+  return ids;
+}
+
+// log lines, one in eight with a date in it
+auto
+make_lines() -> std::vector<std::string>
+{
+  auto lines = std::vector<std::string>{};
+  for (std::size_t i = 0; i < 256; ++i) {
+    auto line = std::string{ "GET /api/v1/orders status=200 user=alice latency_ms=12" };
+    if (i % 8 == 0) {
+      line += " at 2024-03-" + std::to_string(10 + i % 20);
+    }
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+template <mtp::basic_fixed_string Pattern>
+auto
+bench_match(char const* name, std::vector<std::string> const& inputs) -> void
+{
+  auto const at = [&](std::size_t i) -> std::string const& { return inputs[i % inputs.size()]; };
+
+  bench::run(std::string{ "mtp::regex_match " } + name, [&](std::size_t i) {
+    auto const result = mtp::regex_match<Pattern>(at(i));
+    bench::do_not_optimize(result ? result[result.size() - 1].size() : 0);
+  });
+
+  auto const re = std::regex{ Pattern.data(), Pattern.size() };
+  bench::run(std::string{ "std::regex_match " } + name, [&](std::size_t i) {
+    auto groups = std::smatch{};
+    bench::do_not_optimize(std::regex_match(at(i), groups, re) ? groups.length(0) : 0);
+  });
+}
+
+template <mtp::basic_fixed_string Pattern>
+auto
+bench_search(char const* name, std::vector<std::string> const& inputs) -> void
+{
+  auto const at = [&](std::size_t i) -> std::string const& { return inputs[i % inputs.size()]; };
+
+  bench::run(std::string{ "mtp::regex_search " } + name, [&](std::size_t i) {
+    auto const result = mtp::regex_search<Pattern>(at(i));
+    bench::do_not_optimize(result ? result[0].size() : 0);
+  });
+
+  auto const re = std::regex{ Pattern.data(), Pattern.size() };
+  bench::run(std::string{ "std::regex_search " } + name, [&](std::size_t i) {
+    auto groups = std::smatch{};
+    bench::do_not_optimize(std::regex_search(at(i), groups, re) ? groups.length(0) : 0);
+  });
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+BENCH_CASE("regex")
+{
+  auto const ids = make_identifiers();
+  bench_match<"[A-Z]{3}[0-9]{4}">("[A-Z]{3}[0-9]{4}", ids);
+  bench_match<"([A-Z]+)(\\d+)">("([A-Z]+)(\\d+)", ids);
+
+  auto const lines = make_lines();
+  bench_search<"(\\d{4})-(\\d\\d)-(\\d\\d)">("(\\d{4})-(\\d\\d)-(\\d\\d)", lines);
+  bench_search<"user=(\\w+)">("user=(\\w+)", lines);
+  bench_search<"(?:/\\w+)+">("(?:/\\w+)+", lines);
+}
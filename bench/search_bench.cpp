@@ -0,0 +1,85 @@
+#include "bench.hpp"
+
+#ifdef MTP_AS_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+using namespace std::string_view_literals;
+
+// log-like text with the needle only at the very end
+auto
+make_haystack(std::size_t size, std::string_view needle) -> std::string
+{
+  constexpr auto words = std::string_view{ "GET POST status=200 status=404 user=alice user=bob "
+                                           "latency_ms=12 path=/api/v1/orders ERR WARN INFO\n" };
+  auto hay = std::string{};
+  auto state = std::uint32_t{ 1 };
+  while (hay.size() + needle.size() < size) {
+    state = state * 1664525u + 1013904223u;
+    hay += words[(state >> 16) % words.size()];
+  }
+  hay += needle;
+  return hay;
+}
+
+template <mtp::basic_fixed_string Needle>
+auto
+bench_find(std::size_t size) -> void
+{
+  auto const hay = make_haystack(size, Needle.view());
+  auto const sv = std::string_view{ hay };
+  auto const prefix = std::to_string(size) + " bytes, \"" + std::string{ Needle.view() } + "\" ";
+  auto const searcher = std::boyer_moore_horspool_searcher{ Needle.begin(), Needle.end() };
+
+  bench::run(prefix + "std::string_view::find", [&](std::size_t) {
+    bench::do_not_optimize(sv.find(Needle.view()));
+  });
+  bench::run(prefix + "std::boyer_moore_horspool", [&](std::size_t) {
+    bench::do_not_optimize(std::search(sv.begin(), sv.end(), searcher));
+  });
+  bench::run(prefix + "mtp::find", [&](std::size_t) {
+    bench::do_not_optimize(mtp::find<Needle>(sv));
+  });
+}
+
+auto
+bench_find_first_of(std::size_t size) -> void
+{
+  auto const hay = make_haystack(size, "\"");
+  auto const sv = std::string_view{ hay };
+  auto const prefix = std::to_string(size) + " bytes, find_first_of \"\\\"\\\\<>\" ";
+
+  bench::run(prefix + "std::string_view", [&](std::size_t) {
+    bench::do_not_optimize(sv.find_first_of("\"\\<>"sv));
+  });
+  bench::run(prefix + "mtp::find_first_of", [&](std::size_t) {
+    bench::do_not_optimize(mtp::find_first_of<"\"\\<>">(sv));
+  });
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+BENCH_CASE("search")
+{
+  bench_find<"latency_ms=999">(1 << 16);
+  bench_find<"status=500">(1 << 16);
+  bench_find<"ERROR">(1 << 16);
+  bench_find<"user=mallory, path=/api/v1/admin">(1 << 16);
+  bench_find<"ERROR">(256);
+  bench_find_first_of(1 << 16);
+}
@@ -0,0 +1,79 @@
+#include "bench.hpp"
+
+#ifdef MTP_AS_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#ifdef BENCH_HAS_TBB
+#  include <execution>
+#endif
+#include <string>
+#include <vector>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+// isin-like codes: a few country prefixes, the rest digits
+auto
+make_codes(std::size_t count) -> std::vector<mtp::fixed_string<12>>
+{
+  constexpr char const* countries[] = { "US", "US", "US", "GB", "DE", "FR", "JP", "CA" };
+  auto codes = std::vector<mtp::fixed_string<12>>{};
+  codes.reserve(count);
+  auto state = std::uint64_t{ 42 };
+  for (std::size_t i = 0; i < count; ++i) {
+    state = state * 6364136223846793005u + 1442695040888963407u;
+    auto code = std::string{ countries[state >> 61] };
+    for (std::size_t j = 2; j < 12; ++j) {
+      state = state * 6364136223846793005u + 1442695040888963407u;
+      code += static_cast<char>('0' + (state >> 32) % 10);
+    }
+    codes.push_back(mtp::fixed_string<12>{ code.begin(), code.end() });
+  }
+  return codes;
+}
+
+// every run sorts a fresh copy, the copy is part of the time
+template <typename Sort>
+auto
+bench_sort(std::string const& name, std::vector<mtp::fixed_string<12>> const& codes, Sort sort)
+    -> void
+{
+  auto work = codes;
+  bench::run(name, [&](std::size_t) {
+    std::copy(codes.begin(), codes.end(), work.begin());
+    sort(work);
+    bench::do_not_optimize(work.data());
+  });
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+BENCH_CASE("sort")
+{
+  for (auto const count : { std::size_t{ 1'000'000 }, std::size_t{ 10'000'000 } }) {
+    auto const codes = make_codes(count);
+    auto const label = std::to_string(count / 1'000'000) + "M isins, ";
+
+    bench_sort(label + "std::sort", codes, [](auto& v) { std::sort(v.begin(), v.end()); });
+#ifdef BENCH_HAS_TBB
+    bench_sort(label + "std::sort(par)", codes,
+               [](auto& v) { std::sort(std::execution::par, v.begin(), v.end()); });
+#endif
+    bench_sort(label + "std::stable_sort", codes,
+               [](auto& v) { std::stable_sort(v.begin(), v.end()); });
+    bench_sort(label + "mtp::sort", codes, [](auto& v) { mtp::sort(v); });
+    bench_sort(label + "mtp::stable_sort", codes, [](auto& v) { mtp::stable_sort(v); });
+#ifdef MTP_PARALLEL_SORT
+    bench_sort(label + "mtp::parallel_sort", codes, [](auto& v) { mtp::parallel_sort(v); });
+#endif
+  }
+}
@@ -0,0 +1,88 @@
+#include "bench.hpp"
+
+#ifdef MTP_AS_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+using headers =
+    mtp::static_map<std::size_t, "accept", "accept-charset", "accept-encoding", "accept-language",
+                    "authorization", "cache-control", "connection", "content-encoding",
+                    "content-length", "content-type", "cookie", "date", "expect", "forwarded",
+                    "from", "host", "if-match", "if-modified-since", "if-none-match", "if-range",
+                    "if-unmodified-since", "max-forwards", "origin", "pragma",
+                    "proxy-authorization", "range", "referer", "te", "trailer",
+                    "transfer-encoding", "upgrade", "user-agent", "via", "warning">;
+
+// every key once plus as many misses, shuffled deterministically
+auto
+make_queries() -> std::vector<std::string>
+{
+  auto queries = std::vector<std::string>{};
+  for (auto const key : headers::keys()) {
+    queries.emplace_back(key);
+    queries.emplace_back(std::string{ key } + "-x");
+  }
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    std::swap(queries[i], queries[(i * 7919) % queries.size()]);
+  }
+  return queries;
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+BENCH_CASE("static_map")
+{
+  auto const queries = make_queries();
+  auto const views = std::vector<std::string_view>(queries.begin(), queries.end());
+  auto const at = [&](std::size_t i) { return views[i % views.size()]; };
+
+  auto values = std::array<std::size_t, headers::size()>{};
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = i;
+  }
+
+  auto const map = std::apply([](auto... vs) { return headers{ vs... }; }, values);
+  bench::run("mtp::static_map::find", [&](std::size_t i) {
+    auto const* value = map.find(at(i));
+    bench::do_not_optimize(value ? *value : 0);
+  });
+
+  auto umap = std::unordered_map<std::string_view, std::size_t>{};
+  for (std::size_t i = 0; i < headers::size(); ++i) {
+    umap.emplace(headers::keys()[i], i);
+  }
+  bench::run("std::unordered_map<std::string_view, V>::find", [&](std::size_t i) {
+    auto const it = umap.find(at(i));
+    bench::do_not_optimize(it != umap.end() ? it->second : 0);
+  });
+
+  using entry = std::pair<std::string_view, std::size_t>;
+  auto sorted = std::array<entry, headers::size()>{};
+  for (std::size_t i = 0; i < headers::size(); ++i) {
+    sorted[i] = { headers::keys()[i], i };
+  }
+  std::ranges::sort(sorted);
+  bench::run("sorted std::array + std::lower_bound", [&](std::size_t i) {
+    auto const key = at(i);
+    auto const it = std::ranges::lower_bound(sorted, key, {}, &entry::first);
+    bench::do_not_optimize(it != sorted.end() && it->first == key ? it->second : 0);
+  });
+}
@@ -0,0 +1,44 @@
+#include "bench.hpp"
+
+#ifdef MTP_AS_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+#include <array>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+// -------------------------------------------------------------------------------------------------
+
+BENCH_CASE("stream")
+{
+  constexpr auto fixed = std::array{ mtp::fixed_string<12>{ "US0378331005" },
+                                     mtp::fixed_string<12>{ "GB0002634946" } };
+  auto const strings = std::array{ std::string{ fixed[0].view() }, std::string{ fixed[1].view() } };
+  auto const views = std::array{ fixed[0].view(), fixed[1].view() };
+
+  // the stream is rewound every so often so that it does not grow without bound
+  auto os = std::ostringstream{};
+  auto const rewind = [&](std::size_t i) {
+    if (i % 1024 == 0) {
+      os.seekp(0);
+    }
+  };
+
+  bench::run("os << std::string", [&](std::size_t i) {
+    rewind(i);
+    bench::do_not_optimize(&(os << strings[i % 2]));
+  });
+  bench::run("os << std::string_view", [&](std::size_t i) {
+    rewind(i);
+    bench::do_not_optimize(&(os << views[i % 2]));
+  });
+  bench::run("os << fixed_string", [&](std::size_t i) {
+    rewind(i);
+    bench::do_not_optimize(&(os << fixed[i % 2]));
+  });
+}
@@ -0,0 +1,151 @@
+#include "bench.hpp"
+
+#ifdef MTP_AS_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+#define HEADERS                                                                                    \
+  "accept", "accept-charset", "accept-encoding", "accept-language", "authorization",               \
+      "cache-control", "connection", "content-encoding", "content-length", "content-type",         \
+      "cookie", "date", "expect", "forwarded", "from", "host", "if-match", "if-modified-since",    \
+      "if-none-match", "if-range", "if-unmodified-since", "max-forwards", "origin", "pragma",      \
+      "proxy-authorization", "range", "referer", "te", "trailer", "transfer-encoding", "upgrade",  \
+      "user-agent", "via", "warning"
+
+constexpr auto keys = std::array<std::string_view, 34>{ HEADERS };
+
+template <std::size_t... Is>
+auto
+switch_dispatch(std::string_view sv, std::index_sequence<Is...>) -> std::size_t
+{
+  return mtp::string_switch<HEADERS>(sv, [] { return Is; }..., [] { return keys.size(); });
+}
+
+template <std::size_t... Is>
+auto
+if_chain_dispatch(std::string_view sv, std::index_sequence<Is...>) -> std::size_t
+{
+  auto result = keys.size();
+  static_cast<void>((... || (sv == keys[Is] && (result = Is, true))));
+  return result;
+}
+
+// many cases of the same length, like fixed width protocol tags
+constexpr auto tag_count = std::size_t{ 256 };
+
+template <std::size_t I>
+constexpr auto tag = mtp::fixed_string<6>{ 't', 'a', 'g', static_cast<char>('a' + I % 26),
+                                           static_cast<char>('a' + I / 26 % 26), 'x' };
+
+template <std::size_t... Is>
+auto
+tag_switch_dispatch(std::string_view sv, std::index_sequence<Is...>) -> std::size_t
+{
+  return mtp::string_switch<tag<Is>...>(sv, [] { return Is; }..., [] { return tag_count; });
+}
+
+template <std::size_t... Is>
+auto
+tag_if_chain_dispatch(std::string_view sv, std::index_sequence<Is...>) -> std::size_t
+{
+  auto result = tag_count;
+  static_cast<void>((... || (sv == tag<Is>.view() && (result = Is, true))));
+  return result;
+}
+
+template <std::size_t... Is>
+auto
+tag_map(std::index_sequence<Is...>) -> std::unordered_map<std::string_view, std::size_t>
+{
+  return { { tag<Is>.view(), Is }... };
+}
+
+template <std::size_t... Is>
+auto
+tag_queries(std::index_sequence<Is...>) -> std::vector<std::string>
+{
+  auto queries = std::vector<std::string>{ std::string{ tag<Is>.view() }... };
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    std::swap(queries[i], queries[(i * 7919) % queries.size()]);
+  }
+  return queries;
+}
+
+auto
+make_queries() -> std::vector<std::string>
+{
+  auto queries = std::vector<std::string>{};
+  for (auto const key : keys) {
+    queries.emplace_back(key);
+    queries.emplace_back(std::string{ key } + "-x");
+  }
+  for (std::size_t i = 0; i < queries.size(); ++i) {
+    std::swap(queries[i], queries[(i * 7919) % queries.size()]);
+  }
+  return queries;
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+BENCH_CASE("string_switch")
+{
+  auto const queries = make_queries();
+  auto const views = std::vector<std::string_view>(queries.begin(), queries.end());
+  auto const at = [&](std::size_t i) { return views[i % views.size()]; };
+  constexpr auto indices = std::make_index_sequence<keys.size()>{};
+
+  bench::run("mtp::string_switch", [&](std::size_t i) {
+    bench::do_not_optimize(switch_dispatch(at(i), indices));
+  });
+
+  bench::run("if (sv == ...) else if chain", [&](std::size_t i) {
+    bench::do_not_optimize(if_chain_dispatch(at(i), indices));
+  });
+
+  auto map = std::unordered_map<std::string_view, std::size_t>{};
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    map.emplace(keys[i], i);
+  }
+  bench::run("std::unordered_map<std::string_view, std::size_t>", [&](std::size_t i) {
+    auto const it = map.find(at(i));
+    bench::do_not_optimize(it != map.end() ? it->second : keys.size());
+  });
+}
+
+BENCH_CASE("string_switch (256 tags of equal length)")
+{
+  constexpr auto indices = std::make_index_sequence<tag_count>{};
+  auto const queries = tag_queries(indices);
+  auto const views = std::vector<std::string_view>(queries.begin(), queries.end());
+  auto const at = [&](std::size_t i) { return views[i % views.size()]; };
+
+  bench::run("mtp::string_switch", [&](std::size_t i) {
+    bench::do_not_optimize(tag_switch_dispatch(at(i), indices));
+  });
+
+  bench::run("if (sv == ...) else if chain", [&](std::size_t i) {
+    bench::do_not_optimize(tag_if_chain_dispatch(at(i), indices));
+  });
+
+  auto const map = tag_map(indices);
+  bench::run("std::unordered_map<std::string_view, std::size_t>", [&](std::size_t i) {
+    auto const it = map.find(at(i));
+    bench::do_not_optimize(it != map.end() ? it->second : tag_count);
+  });
+}
@@ -0,0 +1,75 @@
+#include "bench.hpp"
+
+#ifdef MTP_AS_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+using events = mtp::symbol_table<"mouse_down", "mouse_up", "mouse_move", "key_down", "key_up",
+                                 "focus_in", "focus_out", "resize", "scroll", "close">;
+
+constexpr auto names = std::array<std::string_view, 10>{
+  "mouse_down", "mouse_up", "mouse_move", "key_down", "key_up",
+  "focus_in",   "focus_out", "resize",    "scroll",   "close"
+};
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+BENCH_CASE("symbol")
+{
+  // an event queue holding names as strings or as ids, filtered for one kind of event
+  auto strings = std::vector<std::string>{};
+  auto ids = std::vector<mtp::symbol_id>{};
+  for (std::size_t i = 0; i < 1024; ++i) {
+    auto const name = names[(i * 7) % names.size()];
+    strings.emplace_back(name);
+    ids.push_back(*events::find(name));
+  }
+
+  bench::run("filter 1024 events, std::string ==", [&](std::size_t) {
+    auto count = std::size_t{ 0 };
+    for (auto const& name : strings) {
+      count += name == "mouse_move";
+    }
+    bench::do_not_optimize(count);
+  });
+  bench::run("filter 1024 events, mtp::symbol_id ==", [&](std::size_t) {
+    auto const mouse_move = mtp::symbol<"mouse_move">::id();
+    auto count = std::size_t{ 0 };
+    for (auto const id : ids) {
+      count += id == mouse_move;
+    }
+    bench::do_not_optimize(count);
+  });
+
+  auto by_string = std::unordered_map<std::string, std::size_t>{};
+  auto by_id = std::unordered_map<mtp::symbol_id, std::size_t>{};
+  for (std::size_t i = 0; i < names.size(); ++i) {
+    by_string.emplace(names[i], i);
+    by_id.emplace(*events::find(names[i]), i);
+  }
+  bench::run("count by name, std::unordered_map<std::string>", [&](std::size_t i) {
+    ++by_string[strings[i % strings.size()]];
+  });
+  bench::run("count by name, std::unordered_map<mtp::symbol_id>", [&](std::size_t i) {
+    ++by_id[ids[i % ids.size()]];
+  });
+
+  bench::run("intern, mtp::symbol_table::find", [&](std::size_t i) {
+    bench::do_not_optimize(events::find(names[i % names.size()]));
+  });
+}
@@ -0,0 +1,99 @@
+#include "bench.hpp"
+
+#ifdef MTP_AS_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+constexpr auto text_size = std::size_t{ 1 } << 16;
+
+// log lines, one in `accented_every` carrying a few non-ascii characters
+auto
+make_log(std::size_t accented_every) -> std::string
+{
+  auto log = std::string{};
+  for (std::size_t i = 0; log.size() < text_size; ++i) {
+    log += "2024-05-01T12:00:00Z INFO request handled path=/api/v1/orders status=200 ";
+    log += i % accented_every == 0 ? "user=Zoë city=Köln amount=12€\n" : "user=alice amount=12\n";
+  }
+  log.resize(text_size);
+  while ((static_cast<unsigned char>(log.back()) & 0xC0) == 0x80
+         || static_cast<unsigned char>(log.back()) >= 0xC0) {
+    log.pop_back();
+  }
+  return log;
+}
+
+// a straightforward decode and encode loop without validation
+auto
+naive_utf8_to_utf16(std::string_view str, char16_t* out) -> char16_t*
+{
+  for (std::size_t i = 0; i < str.size();) {
+    auto const lead = static_cast<unsigned char>(str[i]);
+    auto const length = lead < 0x80 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+    auto cp = static_cast<char32_t>(length == 1   ? lead
+                                    : length == 2 ? lead & 0x1F
+                                    : length == 3 ? lead & 0x0F
+                                                  : lead & 0x07);
+    for (auto j = 1; j < length; ++j) {
+      cp = (cp << 6) | (static_cast<unsigned char>(str[i + static_cast<std::size_t>(j)]) & 0x3Fu);
+    }
+    if (cp < 0x10000) {
+      *out++ = static_cast<char16_t>(cp);
+    }
+    else {
+      *out++ = static_cast<char16_t>(0xD800 + ((cp - 0x10000) >> 10));
+      *out++ = static_cast<char16_t>(0xDC00 + ((cp - 0x10000) & 0x3FF));
+    }
+    i += static_cast<std::size_t>(length);
+  }
+  return out;
+}
+
+auto
+bench_log(char const* name, std::size_t accented_every) -> void
+{
+  auto const log = make_log(accented_every);
+  auto utf16 = std::vector<char16_t>(log.size());
+  auto utf8 = std::vector<char>(log.size());
+  auto const prefix = std::string{ name } + " 64 KiB ";
+
+  bench::run(prefix + "memcpy", [&](std::size_t) {
+    std::memcpy(utf8.data(), log.data(), log.size());
+    bench::do_not_optimize(utf8.data());
+  });
+  bench::run(prefix + "naive utf-8 -> utf-16", [&](std::size_t) {
+    bench::do_not_optimize(naive_utf8_to_utf16(log, utf16.data()));
+  });
+  bench::run(prefix + "transcode utf-8 -> utf-16", [&](std::size_t) {
+    bench::do_not_optimize(mtp::transcode(std::string_view{ log }, utf16.data(),
+                                          utf16.data() + utf16.size()));
+  });
+
+  auto const size = mtp::transcoded_size<char16_t>(std::string_view{ log });
+  auto const source = std::u16string_view{ utf16.data(), size };
+  bench::run(prefix + "transcode utf-16 -> utf-8", [&](std::size_t) {
+    bench::do_not_optimize(mtp::transcode(source, utf8.data(), utf8.data() + utf8.size()));
+  });
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+BENCH_CASE("transcode")
+{
+  bench_log("ascii", text_size);
+  bench_log("mixed", 8);
+}
@@ -0,0 +1,125 @@
+#include "bench.hpp"
+
+#ifdef MTP_AS_MODULE
+import mtp.fixed_string;
+#else
+#  include <mtp/fixed_string.hpp>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+using namespace std::string_view_literals;
+
+// an order entry message: a space padded symbol, a nul padded account, a one character side and
+// a length prefixed big endian utf-16 note
+using order = mtp::wire_layout<mtp::wire_string<8, mtp::wire_padding::space>,
+                               mtp::wire_string<16>, mtp::wire_string<1>,
+                               mtp::wire_u16string<12, mtp::wire_padding::length_prefix>>;
+
+struct order_fields
+{
+  mtp::inplace_string<8> symbol;
+  mtp::fixed_string<16> account;
+  mtp::fixed_string<1> side;
+  mtp::inplace_u16string<12> note;
+};
+
+auto
+make_orders() -> std::vector<order_fields>
+{
+  constexpr auto symbols = std::array{ "AAPL"sv, "MSFT"sv, "GOOGL"sv, "BRK.B"sv, "T"sv };
+  auto orders = std::vector<order_fields>{};
+  for (std::size_t i = 0; i < 256; ++i) {
+    orders.push_back({ mtp::inplace_string<8>{ symbols[i % symbols.size()] },
+                       mtp::fixed_string<16>{ "ACCT-0000-0042-7" }, mtp::fixed_string<1>{ "B" },
+                       mtp::inplace_u16string<12>{ i % 2 == 0 ? u"day"sv : u"good-till"sv } });
+  }
+  return orders;
+}
+
+// the same layout written and read field by field, as it is done by hand
+auto
+encode_by_hand(std::byte* out, order_fields const& fields) -> void
+{
+  auto const padded = [&](std::string_view value, std::size_t width, char pad) {
+    std::memset(out, pad, width);
+    std::memcpy(out, value.data(), value.size());
+    out += width;
+  };
+  padded(fields.symbol.view(), 8, ' ');
+  padded(fields.account.view(), 16, '\0');
+  padded(fields.side.view(), 1, '\0');
+  auto const note = fields.note.view();
+  std::memset(out, 0, 1 + 12 * 2);
+  *out++ = static_cast<std::byte>(note.size());
+  for (auto const ch : note) {
+    *out++ = static_cast<std::byte>(ch >> 8);
+    *out++ = static_cast<std::byte>(ch & 0xFF);
+  }
+}
+
+auto
+decode_by_hand(std::byte const* in) -> order::value_type
+{
+  auto const* const chars = reinterpret_cast<char const*>(in);
+  auto symbol = std::string_view{ chars, 8 };
+  symbol = symbol.substr(0, symbol.find_last_not_of(' ') + 1);
+  auto const account = std::string_view{ chars + 8, ::strnlen(chars + 8, 16) };
+  auto const side = std::string_view{ chars + 24, ::strnlen(chars + 24, 1) };
+  auto note = mtp::inplace_u16string<12>{};
+  auto const length = std::min(std::size_t{ 12 }, static_cast<std::size_t>(in[25]));
+  for (std::size_t i = 0; i < length; ++i) {
+    auto const* const unit = in + 26 + 2 * i;
+    note.push_back(static_cast<char16_t>(static_cast<unsigned>(unit[0]) << 8
+                                         | static_cast<unsigned>(unit[1])));
+  }
+  return { symbol, account, side, note };
+}
+
+auto
+consume(order::value_type const& fields) -> void
+{
+  auto const& [symbol, account, side, note] = fields;
+  bench::do_not_optimize(symbol.data());
+  bench::do_not_optimize(account.size() + side.size() + symbol.size());
+  bench::do_not_optimize(note.data());
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+
+BENCH_CASE("wire")
+{
+  auto const orders = make_orders();
+  auto buffer = std::vector<std::byte>(orders.size() * order::size);
+  auto const message = [&](std::size_t i) { return std::span{ buffer }.subspan(i * order::size); };
+
+  bench::run("mtp::wire_layout::encode", [&](std::size_t i) {
+    auto const& fields = orders[i % orders.size()];
+    auto const rest = order::encode(message(i % orders.size()), fields.symbol, fields.account,
+                                    fields.side, fields.note);
+    bench::do_not_optimize(rest.data());
+  });
+  bench::run("encode by hand", [&](std::size_t i) {
+    encode_by_hand(message(i % orders.size()).data(), orders[i % orders.size()]);
+    bench::do_not_optimize(buffer.data());
+  });
+
+  bench::run("mtp::wire_layout::decode", [&](std::size_t i) {
+    consume(order::decode(message(i % orders.size())));
+  });
+  bench::run("decode by hand", [&](std::size_t i) {
+    consume(decode_by_hand(message(i % orders.size()).data()));
+  });
+}
@@ -35,6 +35,19 @@
 #  define MTP_NOEXCEPT noexcept(false)
 #endif
 
+#if defined(_MSC_VER) && !defined(__clang__)
+#  define MTP_NOINLINE __declspec(noinline)
+#elif defined(__GNUC__) || defined(__clang__)
+#  define MTP_NOINLINE __attribute__((noinline))
+#else
+#  define MTP_NOINLINE
+#endif
+
+// fixed strings longer than this many bytes share out of line kernels for their run time paths
+#ifndef MTP_OUTLINE_BYTES
+#  define MTP_OUTLINE_BYTES 64
+#endif
+
 // -------------------------------------------------------------------------------------------------
 
 #if !defined(MTP_HAS_INCLUDE)
@@ -61,6 +74,16 @@
 #  endif
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define MTP_HAS_SSE2
+#endif
+#if defined(__AVX2__)
+#  define MTP_HAS_AVX2
+#endif
+#if !defined(MTP_NO_MMAP) && MTP_HAS_INCLUDE(<sys/mman.h>) && MTP_HAS_INCLUDE(<unistd.h>)
+#  define MTP_HAS_MMAP
+#endif
+
 // -------------------------------------------------------------------------------------------------
 
 #ifndef MTP_AS_MODULE
@@ -69,13 +92,32 @@ import std;
 #  else
 #    include <algorithm>
 #    include <array>
+#    include <atomic>
+#    include <bit>
+#    include <charconv>
 #    include <compare>
 #    include <concepts>
+#    ifdef MTP_PARALLEL_SORT
+#      include <condition_variable>
+#    endif
 #    include <cstddef>
+#    include <cstdint>
+#    include <cstring>
+#    if defined(MTP_PARALLEL_SORT) && !defined(MTP_NO_EXCEPTIONS)
+#      include <exception>
+#    endif
 #    ifdef MTP_HAS_FORMAT
 #      include <format>
 #    endif
+#    include <initializer_list>
 #    include <iterator>
+#    include <limits>
+#    include <memory>
+#    ifdef MTP_PARALLEL_SORT
+#      include <mutex>
+#    endif
+#    include <new>
+#    include <optional>
 #    include <ostream>
 #    ifdef MTP_HAS_FROM_RANGE
 #      include <ranges>
@@ -83,11 +125,31 @@ import std;
 #    ifndef MTP_NO_EXCEPTIONS
 #      include <stdexcept>
 #    endif
+#    include <span>
 #    include <string_view>
+#    include <system_error>
+#    ifdef MTP_PARALLEL_SORT
+#      include <thread>
+#    endif
+#    include <tuple>
 #    include <type_traits>
+#    include <utility>
+#    include <vector>
 #  endif
 #endif
 
+#if !defined(MTP_AS_MODULE) && (defined(MTP_HAS_SSE2) || defined(MTP_HAS_AVX2))
+#  include <immintrin.h>
+#endif
+
+#if !defined(MTP_AS_MODULE) && defined(MTP_HAS_MMAP)
+#  include <cerrno>
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
 // -------------------------------------------------------------------------------------------------
 
 namespace std {
@@ -105,7 +167,25 @@ MTP_EXPORT inline constexpr struct from_range_t
 
 namespace mtp {
 
-MTP_EXPORT template <typename CharT, std::size_t N>
+// storage layouts of `basic_fixed_string`
+namespace layout {
+
+// `CharT[N + 1]`, naturally aligned and without padding
+MTP_EXPORT struct packed
+{};
+
+// storage rounded up to a multiple of `Width` bytes and aligned to `Width`, with the characters
+// past the string zero filled, so that kernels load whole `Width` byte vectors without bounds
+// checks. `Terminated = false` drops the null terminator (and `c_str`) where it would take another
+// vector
+MTP_EXPORT template <std::size_t Width, bool Terminated = true>
+  requires(std::has_single_bit(Width))
+struct simd
+{};
+
+} // namespace layout
+
+MTP_EXPORT template <typename CharT, std::size_t N, typename Layout = layout::packed>
 struct basic_fixed_string;
 
 MTP_EXPORT template <std::size_t N>
@@ -125,306 +205,9932 @@ using fixed_u16string = basic_fixed_string<char16_t, N>;
 MTP_EXPORT template <std::size_t N>
 using fixed_u32string = basic_fixed_string<char32_t, N>;
 
-template <typename CharT, std::size_t N>
-struct basic_fixed_string
-{
-  CharT _data[N + 1] = {};
+MTP_EXPORT template <typename CharT, std::size_t Capacity>
+struct basic_inplace_string;
 
-  using value_type = CharT;
-  using size_type = std::size_t;
-  using difference_type = std::ptrdiff_t;
-  using const_pointer = value_type const*;
-  using pointer = value_type*;
-  using const_reference = value_type const&;
-  using reference = value_type&;
-  using const_iterator = const_pointer;
-  using iterator = const_iterator;
-  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
-  using reverse_iterator = const_reverse_iterator;
+MTP_EXPORT template <std::size_t Capacity>
+using inplace_string = basic_inplace_string<char, Capacity>;
 
-  static constexpr std::integral_constant<size_type, N> size{};
-  static constexpr std::integral_constant<size_type, N> length{};
-  static constexpr std::integral_constant<size_type, N> max_size{};
-  static constexpr std::bool_constant<N == 0> empty{};
+MTP_EXPORT template <std::size_t Capacity>
+using inplace_wstring = basic_inplace_string<wchar_t, Capacity>;
 
-  template <std::convertible_to<CharT>... CharTs>
-    requires(sizeof...(CharTs) == N && (... && !std::is_pointer_v<CharTs>))
-  [[nodiscard]] explicit constexpr basic_fixed_string(CharTs... chars) noexcept
-      : _data{ chars..., CharT{} }
-  {}
+#ifdef MTP_HAS_CHAR8_TYPE
+MTP_EXPORT template <std::size_t Capacity>
+using inplace_u8string = basic_inplace_string<char8_t, Capacity>;
+#endif
 
-  [[nodiscard]] consteval basic_fixed_string(CharT const (&str)[N + 1]) noexcept
-  {
-    MTP_EXPECTS(str[N] == CharT{});
-    std::ranges::copy(str, str + N, _data);
-  }
+MTP_EXPORT template <std::size_t Capacity>
+using inplace_u16string = basic_inplace_string<char16_t, Capacity>;
 
-  template <std::input_iterator I, std::sentinel_for<I> S>
-    requires(std::convertible_to<std::iter_value_t<I>, CharT>)
-  [[nodiscard]] constexpr basic_fixed_string(I begin, S end) noexcept
-  {
-    MTP_EXPECTS(std::ranges::distance(begin, end) == N);
-    std::ranges::copy(begin, end, _data);
-  }
+MTP_EXPORT template <std::size_t Capacity>
+using inplace_u32string = basic_inplace_string<char32_t, Capacity>;
 
-  template <std::ranges::range R>
-    requires(std::convertible_to<std::ranges::range_value_t<R>, CharT>)
-  [[nodiscard]] explicit constexpr basic_fixed_string(std::from_range_t, R&& container) noexcept
-  {
-    MTP_EXPECTS(std::ranges::size(container) == N);
-    std::ranges::move(container, _data);
-  }
+MTP_EXPORT template <typename CharT, std::size_t N>
+class basic_fixed_string_ref;
 
-  [[nodiscard]] constexpr basic_fixed_string(basic_fixed_string const&) noexcept = default;
+MTP_EXPORT template <std::size_t N>
+using fixed_string_ref = basic_fixed_string_ref<char, N>;
 
-  [[nodiscard]] constexpr auto operator=(basic_fixed_string const&) noexcept
-      -> basic_fixed_string& = default;
+MTP_EXPORT template <std::size_t N>
+using fixed_wstring_ref = basic_fixed_string_ref<wchar_t, N>;
 
-  [[nodiscard]] constexpr auto
-  view() const noexcept -> std::basic_string_view<CharT>
-  {
-    return std::basic_string_view<CharT>{ data(), size() };
-  }
+#ifdef MTP_HAS_CHAR8_TYPE
+MTP_EXPORT template <std::size_t N>
+using fixed_u8string_ref = basic_fixed_string_ref<char8_t, N>;
+#endif
 
-  [[nodiscard]] constexpr
-  operator std::basic_string_view<CharT>() const noexcept
-  {
-    return view();
-  }
+MTP_EXPORT template <std::size_t N>
+using fixed_u16string_ref = basic_fixed_string_ref<char16_t, N>;
 
-  [[nodiscard]] constexpr auto
-  data() const noexcept -> const_pointer
-  {
-    return static_cast<const_pointer>(_data);
-  }
+MTP_EXPORT template <std::size_t N>
+using fixed_u32string_ref = basic_fixed_string_ref<char32_t, N>;
 
-  [[nodiscard]] constexpr auto
-  c_str() const noexcept -> const_pointer
-  {
-    return data();
+MTP_EXPORT template <typename CharT, std::size_t N, typename Layout = layout::packed>
+class basic_fixed_string_column;
+
+MTP_EXPORT template <std::size_t N, typename Layout = layout::packed>
+using fixed_string_column = basic_fixed_string_column<char, N, Layout>;
+
+MTP_EXPORT template <std::size_t N, typename Layout = layout::packed>
+using fixed_wstring_column = basic_fixed_string_column<wchar_t, N, Layout>;
+
+#ifdef MTP_HAS_CHAR8_TYPE
+MTP_EXPORT template <std::size_t N, typename Layout = layout::packed>
+using fixed_u8string_column = basic_fixed_string_column<char8_t, N, Layout>;
+#endif
+
+MTP_EXPORT template <std::size_t N, typename Layout = layout::packed>
+using fixed_u16string_column = basic_fixed_string_column<char16_t, N, Layout>;
+
+MTP_EXPORT template <std::size_t N, typename Layout = layout::packed>
+using fixed_u32string_column = basic_fixed_string_column<char32_t, N, Layout>;
+
+MTP_EXPORT template <typename CharT, std::size_t N, typename V>
+class basic_fixed_string_map;
+
+MTP_EXPORT template <std::size_t N, typename V>
+using fixed_string_map = basic_fixed_string_map<char, N, V>;
+
+MTP_EXPORT template <std::size_t N, typename V>
+using fixed_wstring_map = basic_fixed_string_map<wchar_t, N, V>;
+
+#ifdef MTP_HAS_CHAR8_TYPE
+MTP_EXPORT template <std::size_t N, typename V>
+using fixed_u8string_map = basic_fixed_string_map<char8_t, N, V>;
+#endif
+
+MTP_EXPORT template <std::size_t N, typename V>
+using fixed_u16string_map = basic_fixed_string_map<char16_t, N, V>;
+
+MTP_EXPORT template <std::size_t N, typename V>
+using fixed_u32string_map = basic_fixed_string_map<char32_t, N, V>;
+
+// a map without mapped values
+MTP_EXPORT template <typename CharT, std::size_t N>
+using basic_fixed_string_set = basic_fixed_string_map<CharT, N, void>;
+
+MTP_EXPORT template <std::size_t N>
+using fixed_string_set = basic_fixed_string_set<char, N>;
+
+MTP_EXPORT template <std::size_t N>
+using fixed_wstring_set = basic_fixed_string_set<wchar_t, N>;
+
+#ifdef MTP_HAS_CHAR8_TYPE
+MTP_EXPORT template <std::size_t N>
+using fixed_u8string_set = basic_fixed_string_set<char8_t, N>;
+#endif
+
+MTP_EXPORT template <std::size_t N>
+using fixed_u16string_set = basic_fixed_string_set<char16_t, N>;
+
+MTP_EXPORT template <std::size_t N>
+using fixed_u32string_set = basic_fixed_string_set<char32_t, N>;
+
+// what fills the code units of a `basic_wire_string` past its value
+MTP_EXPORT enum class wire_padding
+{
+  nul,
+  space,
+  length_prefix,
+};
+
+MTP_EXPORT template <typename CharT, std::size_t Width, wire_padding Padding = wire_padding::nul,
+                     std::endian Order = std::endian::big>
+  requires(Width > 0)
+struct basic_wire_string;
+
+MTP_EXPORT template <std::size_t Width, wire_padding Padding = wire_padding::nul>
+using wire_string = basic_wire_string<char, Width, Padding>;
+
+#ifdef MTP_HAS_CHAR8_TYPE
+MTP_EXPORT template <std::size_t Width, wire_padding Padding = wire_padding::nul>
+using wire_u8string = basic_wire_string<char8_t, Width, Padding>;
+#endif
+
+MTP_EXPORT template <std::size_t Width, wire_padding Padding = wire_padding::nul,
+                     std::endian Order = std::endian::big>
+using wire_u16string = basic_wire_string<char16_t, Width, Padding, Order>;
+
+MTP_EXPORT template <std::size_t Width, wire_padding Padding = wire_padding::nul,
+                     std::endian Order = std::endian::big>
+using wire_u32string = basic_wire_string<char32_t, Width, Padding, Order>;
+
+namespace detail {
+
+template <typename T>
+[[nodiscard]] inline auto
+load(unsigned char const* ptr) noexcept -> T
+{
+  T value;
+  std::memcpy(&value, ptr, sizeof(T));
+  return value;
+}
+
+// index (in memory order) of the lowest addressed non-zero byte
+template <std::unsigned_integral T>
+[[nodiscard]] inline auto
+first_set_byte(T bits) noexcept -> std::size_t
+{
+  if constexpr (std::endian::native == std::endian::little) {
+    return static_cast<std::size_t>(std::countr_zero(bits)) / 8;
+  }
+  else {
+    return static_cast<std::size_t>(std::countl_zero(bits)) / 8;
   }
+}
 
-  [[nodiscard]] constexpr auto
-  cbegin() const noexcept -> const_iterator
+// a chunk compares `width` bytes at once: `diff` is zero iff equal and `index` maps a non-zero
+// `diff` to the offset of the first differing byte
+template <std::unsigned_integral Word>
+struct word_chunk
+{
+  static constexpr std::size_t width = sizeof(Word);
+
+  [[nodiscard]] static auto
+  diff(unsigned char const* lhs, unsigned char const* rhs) noexcept -> Word
   {
-    return data();
+    return static_cast<Word>(load<Word>(lhs) ^ load<Word>(rhs));
   }
 
-  [[nodiscard]] constexpr auto
-  cend() const noexcept -> const_iterator
+  [[nodiscard]] static auto
+  index(Word diff) noexcept -> std::size_t
   {
-    return data() + size();
+    return first_set_byte(diff);
   }
+};
 
-  [[nodiscard]] constexpr auto
-  begin() const noexcept -> const_iterator
+#ifdef MTP_HAS_SSE2
+struct sse2_chunk
+{
+  static constexpr std::size_t width = 16;
+
+  [[nodiscard]] static auto
+  diff(unsigned char const* lhs, unsigned char const* rhs) noexcept -> std::uint32_t
   {
-    return cbegin();
+    auto const a = _mm_loadu_si128(reinterpret_cast<__m128i const*>(lhs));
+    auto const b = _mm_loadu_si128(reinterpret_cast<__m128i const*>(rhs));
+    return ~static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))) & 0xFFFFu;
   }
 
-  [[nodiscard]] constexpr auto
-  end() const noexcept -> const_iterator
+  // bit `i` is set iff `ptr[i] == ch`
+  [[nodiscard]] static auto
+  matches(unsigned char const* ptr, unsigned char ch) noexcept -> std::uint32_t
   {
-    return cend();
+    auto const a = _mm_loadu_si128(reinterpret_cast<__m128i const*>(ptr));
+    auto const b = _mm_set1_epi8(static_cast<char>(ch));
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
   }
 
-  [[nodiscard]] constexpr auto
-  crbegin() const noexcept -> const_reverse_iterator
+  [[nodiscard]] static auto
+  index(std::uint32_t diff) noexcept -> std::size_t
   {
-    return const_reverse_iterator{ end() };
+    return static_cast<std::size_t>(std::countr_zero(diff));
   }
+};
+#endif
 
-  [[nodiscard]] constexpr auto
-  crend() const noexcept -> const_reverse_iterator
+#ifdef MTP_HAS_AVX2
+struct avx2_chunk
+{
+  static constexpr std::size_t width = 32;
+
+  [[nodiscard]] static auto
+  diff(unsigned char const* lhs, unsigned char const* rhs) noexcept -> std::uint32_t
   {
-    return const_reverse_iterator{ begin() };
+    auto const a = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(lhs));
+    auto const b = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(rhs));
+    return ~static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
   }
 
-  [[nodiscard]] constexpr auto
-  rbegin() const noexcept -> const_reverse_iterator
+  [[nodiscard]] static auto
+  matches(unsigned char const* ptr, unsigned char ch) noexcept -> std::uint32_t
   {
-    return crbegin();
+    auto const a = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(ptr));
+    auto const b = _mm256_set1_epi8(static_cast<char>(ch));
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
   }
 
-  [[nodiscard]] constexpr auto
-  rend() const noexcept -> const_reverse_iterator
+  [[nodiscard]] static auto
+  index(std::uint32_t diff) noexcept -> std::size_t
   {
-    return crend();
+    return static_cast<std::size_t>(std::countr_zero(diff));
   }
+};
+#endif
 
-  [[nodiscard]] constexpr auto
-  operator[](size_type pos) const noexcept -> const_reference
-  {
-    MTP_EXPECTS(pos < size());
-    return _data[pos];
+template <std::size_t Bytes>
+[[nodiscard]] consteval auto
+select_word_chunk() noexcept
+{
+  if constexpr (Bytes >= 8) {
+    return word_chunk<std::uint64_t>{};
+  }
+  else if constexpr (Bytes >= 4) {
+    return word_chunk<std::uint32_t>{};
+  }
+  else if constexpr (Bytes >= 2) {
+    return word_chunk<std::uint16_t>{};
   }
+  else {
+    return word_chunk<std::uint8_t>{};
+  }
+}
 
-  [[nodiscard]] constexpr auto
-  at(size_type pos) const MTP_NOEXCEPT -> const_reference
-  {
-#ifdef MTP_NO_EXCEPTIONS
-    MTP_EXPECTS(pos < size());
+template <std::size_t Bytes>
+[[nodiscard]] consteval auto
+select_chunk() noexcept
+{
+#if defined(MTP_HAS_AVX2)
+  if constexpr (Bytes >= 32) {
+    return avx2_chunk{};
+  }
+  else if constexpr (Bytes > 16) {
+    return sse2_chunk{};
+  }
+  else {
+    return select_word_chunk<Bytes>();
+  }
+#elif defined(MTP_HAS_SSE2)
+  if constexpr (Bytes > 16) {
+    return sse2_chunk{};
+  }
+  else {
+    return select_word_chunk<Bytes>();
+  }
 #else
-    if (pos >= size()) {
-      throw std::out_of_range("mtp::basic_fixed_string::at");
-    }
+  return select_word_chunk<Bytes>();
 #endif
-    return (*this)[pos];
-  }
+}
 
-  [[nodiscard]] constexpr auto
-  front() const noexcept -> const_reference
-  {
-    MTP_EXPECTS(!empty());
-    return (*this)[0];
-  }
+template <std::size_t Bytes>
+using chunk_t = decltype(select_chunk<Bytes>());
 
-  [[nodiscard]] constexpr auto
-  back() const noexcept -> const_reference
-  {
-    MTP_EXPECTS(!empty());
-    return (*this)[size() - 1];
-  }
+// beyond a few chunks the library `memcmp` (which dispatches on the running cpu) is faster
+template <std::size_t Bytes>
+inline constexpr bool use_memcmp = Bytes > 4 * chunk_t<Bytes>::width;
 
-  constexpr auto
-  swap(basic_fixed_string& fs) noexcept -> void
-  {
-    std::ranges::swap_ranges(_data, _data + size(), fs._data, fs._data + fs.size());
+// the final chunk is loaded at `Bytes - width` and may overlap the previous one, so no load ever
+// reads outside of `[0, Bytes)`
+template <std::size_t Bytes>
+[[nodiscard]] inline auto
+equal_bytes(unsigned char const* lhs, unsigned char const* rhs) noexcept -> bool
+{
+  if constexpr (Bytes == 0) {
+    return true;
   }
+  else {
+    using chunk = chunk_t<Bytes>;
+    constexpr auto tail = Bytes - chunk::width;
 
-  template <std::size_t N2>
-  [[nodiscard]] friend constexpr auto
-  operator+(basic_fixed_string const& lhs, basic_fixed_string<CharT, N2> const& rhs) noexcept
-      -> basic_fixed_string<CharT, N + N2>
-  {
-    CharT str[N + N2] = {};
-    auto it = std::ranges::copy(lhs.begin(), lhs.end(), str).out;
-    it = std::ranges::copy(rhs.begin(), rhs.end(), it).out;
-    return basic_fixed_string<CharT, N + N2>{ str, it };
+    if constexpr (Bytes <= 2 * chunk::width) {
+      return (chunk::diff(lhs, rhs) | chunk::diff(lhs + tail, rhs + tail)) == 0;
+    }
+    else if constexpr (use_memcmp<Bytes>) {
+      return std::memcmp(lhs, rhs, Bytes) == 0;
+    }
+    else {
+      for (std::size_t i = 0; i < tail; i += chunk::width) {
+        if (chunk::diff(lhs + i, rhs + i) != 0) {
+          return false;
+        }
+      }
+      return chunk::diff(lhs + tail, rhs + tail) == 0;
+    }
   }
+}
 
-  [[nodiscard]] friend constexpr auto
-  operator+(basic_fixed_string const& lhs, CharT rhs) noexcept -> basic_fixed_string<CharT, N + 1>
-  {
-    CharT str[N + 1] = {};
-    auto it = std::ranges::copy(lhs.begin(), lhs.end(), str).out;
-    *it++ = rhs;
-    return basic_fixed_string<CharT, N + 1>{ str, it };
+// offset of the first differing byte, or `Bytes` if all are equal
+template <std::size_t Bytes>
+[[nodiscard]] inline auto
+mismatch_bytes(unsigned char const* lhs, unsigned char const* rhs) noexcept -> std::size_t
+{
+  if constexpr (Bytes == 0) {
+    return 0;
   }
+  else {
+    using chunk = chunk_t<Bytes>;
+    constexpr auto tail = Bytes - chunk::width;
 
-  [[nodiscard]] friend constexpr auto
-  operator+(CharT lhs, basic_fixed_string const& rhs) noexcept -> basic_fixed_string<CharT, 1 + N>
-  {
-    CharT str[1 + N] = {};
-    auto it = std::ranges::begin(str);
-    *it++ = lhs;
-    it = std::ranges::copy(rhs.begin(), rhs.end(), it).out;
-    return basic_fixed_string<CharT, 1 + N>{ str, it };
+    for (std::size_t i = 0; i < tail; i += chunk::width) {
+      if (auto const diff = chunk::diff(lhs + i, rhs + i); diff != 0) {
+        return i + chunk::index(diff);
+      }
+    }
+    if (auto const diff = chunk::diff(lhs + tail, rhs + tail); diff != 0) {
+      return tail + chunk::index(diff);
+    }
+    return Bytes;
   }
+}
 
-  template <std::size_t N2>
-  [[nodiscard]] friend consteval auto
-  operator+(basic_fixed_string const& lhs, CharT const (&rhs)[N2]) noexcept
-      -> basic_fixed_string<CharT, N + (N2 - 1)>
-  {
-    MTP_EXPECTS(rhs[N2 - 1] == CharT{});
+template <typename CharT, std::size_t N>
+[[nodiscard]] inline auto
+equal(CharT const* lhs, CharT const* rhs) noexcept -> bool
+{
+  return equal_bytes<N * sizeof(CharT)>(reinterpret_cast<unsigned char const*>(lhs),
+                                        reinterpret_cast<unsigned char const*>(rhs));
+}
 
-    CharT str[N + (N2 - 1)] = {};
-    auto it = std::ranges::copy(lhs.begin(), lhs.end(), str).out;
-    it = std::ranges::copy(rhs, rhs + N2 - 1, it).out;
-    return basic_fixed_string<CharT, N + (N2 - 1)>{ str, it };
-  }
+template <typename CharT, std::size_t N, std::size_t N2>
+[[nodiscard]] inline auto
+compare(CharT const* lhs, CharT const* rhs) noexcept -> std::strong_ordering
+{
+  constexpr auto common = N < N2 ? N : N2;
+  constexpr auto bytes = common * sizeof(CharT);
 
-  template <std::size_t N2>
-  [[nodiscard]] friend consteval auto
-  operator+(CharT const (&lhs)[N2], basic_fixed_string const& rhs) noexcept
-      -> basic_fixed_string<CharT, (N2 - 1) + N>
-  {
-    MTP_EXPECTS(lhs[N2 - 1] == CharT{});
+  if constexpr (sizeof(CharT) == 1 && use_memcmp<bytes>) {
+    // `char_traits` of single byte characters order as `unsigned char`, same as `memcmp`
+    if (auto const cmp = std::memcmp(lhs, rhs, bytes); cmp != 0) {
+      return cmp < 0 ? std::strong_ordering::less : std::strong_ordering::greater;
+    }
+    return N <=> N2;
+  }
 
-    CharT str[(N2 - 1) + N] = {};
-    auto it = std::ranges::copy(lhs, lhs + N2 - 1, str).out;
-    it = std::ranges::copy(rhs.begin(), rhs.end(), it).out;
-    return basic_fixed_string<CharT, (N2 - 1) + N>{ str, it };
+  auto const pos = mismatch_bytes<bytes>(reinterpret_cast<unsigned char const*>(lhs),
+                                         reinterpret_cast<unsigned char const*>(rhs));
+  if (pos != bytes) {
+    auto const i = pos / sizeof(CharT);
+    return std::char_traits<CharT>::lt(lhs[i], rhs[i]) ? std::strong_ordering::less
+                                                       : std::strong_ordering::greater;
+  }
+  return N <=> N2;
+}
+
+template <std::size_t N>
+using uint_least_t =
+    std::conditional_t<(N <= 0xFF), std::uint8_t,
+                       std::conditional_t<(N <= 0xFFFF), std::uint16_t,
+                                          std::conditional_t<(N <= 0xFFFF'FFFF), std::uint32_t,
+                                                             std::uint64_t>>>;
+
+template <std::size_t Bytes>
+using uint_bytes_t = std::conditional_t<
+    (Bytes == 1), std::uint8_t,
+    std::conditional_t<(Bytes == 2), std::uint16_t,
+                       std::conditional_t<(Bytes == 4), std::uint32_t, std::uint64_t>>>;
+
+#ifdef __SIZEOF_INT128__
+__extension__ using uint128_t = unsigned __int128;
+#endif
+
+// full 64 x 64 -> 128 bit multiply, low half into `a` and high half into `b`
+constexpr auto
+mul(std::uint64_t& a, std::uint64_t& b) noexcept -> void
+{
+#ifdef __SIZEOF_INT128__
+  auto const r = static_cast<uint128_t>(a) * b;
+  a = static_cast<std::uint64_t>(r);
+  b = static_cast<std::uint64_t>(r >> 64);
+#else
+  auto const a_lo = a & 0xFFFF'FFFFu;
+  auto const a_hi = a >> 32;
+  auto const b_lo = b & 0xFFFF'FFFFu;
+  auto const b_hi = b >> 32;
+  auto const lo_lo = a_lo * b_lo;
+  auto const hi_lo = a_hi * b_lo;
+  auto const lo_hi = a_lo * b_hi;
+  auto const cross = (lo_lo >> 32) + (hi_lo & 0xFFFF'FFFFu) + lo_hi;
+  a = (cross << 32) | (lo_lo & 0xFFFF'FFFFu);
+  b = a_hi * b_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+}
+
+[[nodiscard]] constexpr auto
+mum(std::uint64_t a, std::uint64_t b) noexcept -> std::uint64_t
+{
+  mul(a, b);
+  return a ^ b;
+}
+
+inline constexpr std::uint64_t wyp0 = 0xa076'1d64'78bd'642full;
+inline constexpr std::uint64_t wyp1 = 0xe703'7ed1'a0b4'28dbull;
+
+template <typename CharT>
+[[nodiscard]] constexpr auto
+ascii_lower(CharT ch) noexcept -> CharT
+{
+  return ch >= CharT{ 'A' } && ch <= CharT{ 'Z' } ? static_cast<CharT>(ch - 'A' + 'a') : ch;
+}
+
+// the ascii upper case letters among the `CharT` lanes of a word in lower case, all lanes at once:
+// a lane below the top bit plus `top - 'A'` carries into the top bit iff it is at least 'A', plus
+// `top - 'Z' - 1` iff it is past 'Z', and lanes with the top bit set are not ascii
+template <typename CharT>
+[[nodiscard]] constexpr auto
+fold_word(std::uint64_t word) noexcept -> std::uint64_t
+{
+  constexpr auto lane_bits = 8 * sizeof(CharT);
+  constexpr auto ones = ~std::uint64_t{} / (~std::uint64_t{} >> (64 - lane_bits));
+  constexpr auto top = std::uint64_t{ 1 } << (lane_bits - 1);
+
+  auto const low = word & ~(ones * top);
+  auto const at_least_a = low + ones * (top - 'A');
+  auto const past_z = low + ones * (top - 'Z' - 1);
+  auto const upper = at_least_a & ~past_z & ~word & (ones * top);
+  return word | (upper >> (lane_bits - 6));
+}
+
+// packs `Count` characters into the low bits of a word, first character lowest, with ascii letters
+// in lower case if `Fold`
+template <std::size_t Count, bool Fold = false, typename CharT>
+[[nodiscard]] constexpr auto
+read_word(CharT const* ptr) noexcept -> std::uint64_t
+{
+  static_assert(Count * sizeof(CharT) <= sizeof(std::uint64_t));
+
+  auto word = std::uint64_t{};
+  if constexpr (std::endian::native == std::endian::little) {
+    if (!std::is_constant_evaluated()) {
+      auto bytes = uint_bytes_t<Count * sizeof(CharT)>{};
+      std::memcpy(&bytes, ptr, sizeof(bytes));
+      word = bytes;
+      return Fold ? fold_word<CharT>(word) : word;
+    }
+  }
+
+  for (std::size_t i = 0; i < Count; ++i) {
+    word |= static_cast<std::uint64_t>(static_cast<std::make_unsigned_t<CharT>>(ptr[i]))
+            << (i * 8 * sizeof(CharT));
+  }
+  return Fold ? fold_word<CharT>(word) : word;
+}
+
+// wyhash-style hash that reads characters rather than bytes, so that it gives the same result in
+// constant evaluation and at run time for every character type. `Fold` hashes the string as if its
+// ascii letters were lower case
+template <bool Fold = false, typename CharT>
+[[nodiscard]] constexpr auto
+wyhash(CharT const* ptr, std::size_t count, std::uint64_t seed) noexcept -> std::uint64_t
+{
+  constexpr auto word = 8 / sizeof(CharT);
+  constexpr auto half = word / 2;
+  auto const bytes = count * sizeof(CharT);
+
+  seed ^= mum(seed ^ wyp0, wyp1);
+
+  auto a = std::uint64_t{};
+  auto b = std::uint64_t{};
+  if (bytes <= 16) {
+    if (count >= word) {
+      a = read_word<word, Fold>(ptr);
+      b = read_word<word, Fold>(ptr + count - word);
+    }
+    else if (count >= half) {
+      a = read_word<half, Fold>(ptr);
+      b = read_word<half, Fold>(ptr + count - half);
+    }
+    else if (count > 0) {
+      // only reachable for characters narrower than 4 bytes
+      constexpr auto bits = half > 1 ? 8 * sizeof(CharT) : 0;
+      a = (read_word<1, Fold>(ptr) << (2 * bits)) | (read_word<1, Fold>(ptr + count / 2) << bits)
+          | read_word<1, Fold>(ptr + count - 1);
+    }
+  }
+  else {
+    auto remaining = count;
+    for (; remaining > 2 * word; remaining -= 2 * word, ptr += 2 * word) {
+      seed = mum(read_word<word, Fold>(ptr) ^ wyp1, read_word<word, Fold>(ptr + word) ^ seed);
+    }
+    a = read_word<word, Fold>(ptr + remaining - 2 * word);
+    b = read_word<word, Fold>(ptr + remaining - word);
+  }
+
+  a ^= wyp1;
+  b ^= seed;
+  mul(a, b);
+  return mum(a ^ wyp0 ^ bytes, b ^ wyp1);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+// searching for a needle known at compile time: single characters go to `char_traits::find`
+// (`memchr`), byte strings are scanned a chunk at a time for offsets matching both the first
+// character and a second discriminating one, and everything else uses boyer-moore-horspool
+
+inline constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+template <typename CharT>
+[[nodiscard]] constexpr auto
+code_unit(CharT ch) noexcept -> std::size_t
+{
+  return static_cast<std::size_t>(static_cast<std::make_unsigned_t<CharT>>(ch));
+}
+
+// entry of a character in the 256 entry tables below
+template <typename CharT>
+[[nodiscard]] constexpr auto
+low_byte(CharT ch) noexcept -> std::size_t
+{
+  return code_unit(ch) & 0xFF;
+}
+
+// bad character shifts, characters wider than a byte share the (smallest) shift of their low byte
+template <auto Needle>
+inline constexpr auto horspool_shifts_v = [] {
+  constexpr auto M = Needle.size();
+  auto shifts = std::array<uint_least_t<M>, 256>{};
+  shifts.fill(static_cast<uint_least_t<M>>(M));
+  for (std::size_t i = 0; i + 1 < M; ++i) {
+    shifts[low_byte(Needle[i])] = static_cast<uint_least_t<M>>(M - 1 - i);
+  }
+  return shifts;
+}();
+
+template <auto Needle, typename CharT>
+[[nodiscard]] inline auto
+horspool_find(CharT const* hay, std::size_t count, std::size_t pos) noexcept -> std::size_t
+{
+  constexpr auto M = Needle.size();
+  auto const& shifts = horspool_shifts_v<Needle>;
+
+  if (count < M) {
+    return npos;
+  }
+  for (auto i = pos; i <= count - M;) {
+    auto const last = hay[i + M - 1];
+    if (last == Needle[M - 1] && equal<CharT, M - 1>(hay + i, Needle.data())) {
+      return i;
+    }
+    i += shifts[low_byte(last)];
+  }
+  return npos;
+}
+
+#ifdef MTP_HAS_SSE2
+#  ifdef MTP_HAS_AVX2
+using filter_chunk = avx2_chunk;
+#  else
+using filter_chunk = sse2_chunk;
+#  endif
+
+// the last position not equal to the first character filters best, e.g. "aaab" -> 3, "abaa" -> 1
+template <auto Needle>
+inline constexpr std::size_t filter_second_v = [] {
+  for (auto i = Needle.size() - 1; i > 0; --i) {
+    if (Needle[i] != Needle[0]) {
+      return i;
+    }
+  }
+  return Needle.size() - 1;
+}();
+
+template <auto Needle, typename CharT>
+[[nodiscard]] inline auto
+filter_find(CharT const* hay, std::size_t count, std::size_t pos) noexcept -> std::size_t
+{
+  using chunk = filter_chunk;
+  constexpr auto M = Needle.size();
+  constexpr auto second = filter_second_v<Needle>;
+  // a chunk checks the offsets `[i, i + width)`, each of which must be followed by a full needle
+  constexpr auto span = chunk::width + M - 1;
+
+  auto const* bytes = reinterpret_cast<unsigned char const*>(hay);
+  auto const first_ch = static_cast<unsigned char>(Needle[0]);
+  auto const second_ch = static_cast<unsigned char>(Needle[second]);
+
+  auto i = pos;
+  for (; count >= span && i <= count - span; i += chunk::width) {
+    auto mask = chunk::matches(bytes + i, first_ch) & chunk::matches(bytes + i + second, second_ch);
+    for (; mask != 0; mask &= mask - 1) {
+      auto const j = i + static_cast<std::size_t>(std::countr_zero(mask));
+      if (equal<CharT, M>(hay + j, Needle.data())) {
+        return j;
+      }
+    }
+  }
+  return horspool_find<Needle>(hay, count, i);
+}
+#endif
+
+template <auto Needle, typename CharT>
+[[nodiscard]] constexpr auto
+find_needle(CharT const* hay, std::size_t count, std::size_t pos) noexcept -> std::size_t
+{
+  constexpr auto M = Needle.size();
+
+  if (std::is_constant_evaluated()) {
+    return std::basic_string_view<CharT>{ hay, count }.find(Needle.view(), pos);
+  }
+  if constexpr (M == 0) {
+    return pos <= count ? pos : npos;
+  }
+  else if constexpr (M == 1) {
+    if (pos >= count) {
+      return npos;
+    }
+    auto const* found = std::char_traits<CharT>::find(hay + pos, count - pos, Needle[0]);
+    return found == nullptr ? npos : static_cast<std::size_t>(found - hay);
+  }
+#ifdef MTP_HAS_SSE2
+  else if constexpr (sizeof(CharT) == 1) {
+    return filter_find<Needle>(hay, count, pos);
+  }
+#endif
+  else {
+    return horspool_find<Needle>(hay, count, pos);
+  }
+}
+
+// membership table of a character set, characters beyond the table are looked up in the set
+template <auto Set>
+inline constexpr auto char_set_v = [] {
+  auto table = std::array<bool, 256>{};
+  for (auto const ch : Set) {
+    if (code_unit(ch) < table.size()) {
+      table[code_unit(ch)] = true;
+    }
+  }
+  return table;
+}();
+
+template <auto Set, typename CharT>
+[[nodiscard]] constexpr auto
+find_first_of_set(CharT const* hay, std::size_t count, std::size_t pos) noexcept -> std::size_t
+{
+  if (std::is_constant_evaluated()) {
+    // a copy, as gcc does not treat the address of a template parameter object as a constant
+    auto const set = Set;
+    return std::basic_string_view<CharT>{ hay, count }.find_first_of(set.view(), pos);
+  }
+  auto const& table = char_set_v<Set>;
+  for (auto i = pos; i < count; ++i) {
+    auto const ch = code_unit(hay[i]);
+    if (ch < table.size()
+            ? table[ch]
+            : std::char_traits<CharT>::find(Set.data(), Set.size(), hay[i]) != nullptr) {
+      return i;
+    }
+  }
+  return npos;
+}
+
+
+// -------------------------------------------------------------------------------------------------
+
+// padded layouts: strings whose storage is a whole number of aligned vectors with a zeroed tail are
+// compared and searched with full width loads, without overlapping or partial tail loads
+
+template <typename Layout>
+struct layout_traits;
+
+template <>
+struct layout_traits<layout::packed>
+{
+  static constexpr std::size_t width = 0;
+  static constexpr bool terminated = true;
+
+  template <typename CharT, std::size_t N>
+  static constexpr std::size_t storage = N + 1;
+};
+
+template <std::size_t Width, bool Terminated>
+struct layout_traits<layout::simd<Width, Terminated>>
+{
+  static constexpr std::size_t width = Width;
+  static constexpr bool terminated = Terminated;
+
+  template <typename CharT, std::size_t N>
+  static constexpr std::size_t storage =
+      std::max<std::size_t>(((N + Terminated) * sizeof(CharT) + Width - 1) / Width, 1) * Width
+      / sizeof(CharT);
+};
+
+// the widest chunk that fits a `Width` byte block
+template <std::size_t Width>
+[[nodiscard]] consteval auto
+select_block_chunk() noexcept
+{
+#if defined(MTP_HAS_AVX2)
+  if constexpr (Width >= 32) {
+    return avx2_chunk{};
+  }
+  else if constexpr (Width >= 16) {
+    return sse2_chunk{};
+  }
+  else {
+    return select_word_chunk<Width>();
+  }
+#elif defined(MTP_HAS_SSE2)
+  if constexpr (Width >= 16) {
+    return sse2_chunk{};
+  }
+  else {
+    return select_word_chunk<Width>();
+  }
+#else
+  return select_word_chunk<Width>();
+#endif
+}
+
+template <std::size_t Width>
+using block_chunk_t = decltype(select_block_chunk<Width>());
+
+// `Bytes` is a multiple of the block width, up to four chunks are combined without branches
+template <std::size_t Bytes, std::size_t Width>
+[[nodiscard]] inline auto
+equal_blocks(unsigned char const* lhs, unsigned char const* rhs) noexcept -> bool
+{
+  using chunk = block_chunk_t<Width>;
+
+  if constexpr (Bytes <= 4 * chunk::width) {
+    return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      return (... | chunk::diff(lhs + Is * chunk::width, rhs + Is * chunk::width)) == 0;
+    }(std::make_index_sequence<Bytes / chunk::width>{});
+  }
+  else {
+    for (std::size_t i = 0; i < Bytes; i += chunk::width) {
+      if (chunk::diff(lhs + i, rhs + i) != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
+template <std::size_t Bytes, std::size_t Width>
+[[nodiscard]] inline auto
+mismatch_blocks(unsigned char const* lhs, unsigned char const* rhs) noexcept -> std::size_t
+{
+  using chunk = block_chunk_t<Width>;
+
+  for (std::size_t i = 0; i < Bytes; i += chunk::width) {
+    if (auto const diff = chunk::diff(lhs + i, rhs + i); diff != 0) {
+      return i + chunk::index(diff);
+    }
+  }
+  return Bytes;
+}
+
+// blocks are compared when both strings are padded to the same width, past the shorter string
+// they hold its zeroed tail
+template <typename Layout, typename Layout2>
+inline constexpr bool compare_blocks =
+    layout_traits<Layout>::width != 0
+    && layout_traits<Layout>::width == layout_traits<Layout2>::width;
+
+template <typename Layout, typename Layout2, typename CharT, std::size_t N, std::size_t N2>
+inline constexpr std::size_t common_storage_bytes =
+    std::min(layout_traits<Layout>::template storage<CharT, N>,
+             layout_traits<Layout2>::template storage<CharT, N2>)
+    * sizeof(CharT);
+
+template <typename Layout, typename Layout2, typename CharT, std::size_t N>
+[[nodiscard]] inline auto
+equal_storage(CharT const* lhs, CharT const* rhs) noexcept -> bool
+{
+  if constexpr (compare_blocks<Layout, Layout2>) {
+    return equal_blocks<common_storage_bytes<Layout, Layout2, CharT, N, N>,
+                        layout_traits<Layout>::width>(
+        reinterpret_cast<unsigned char const*>(lhs), reinterpret_cast<unsigned char const*>(rhs));
+  }
+  else {
+    return equal<CharT, N>(lhs, rhs);
+  }
+}
+
+template <typename Layout, typename Layout2, typename CharT, std::size_t N, std::size_t N2>
+[[nodiscard]] inline auto
+compare_storage(CharT const* lhs, CharT const* rhs) noexcept -> std::strong_ordering
+{
+  if constexpr (compare_blocks<Layout, Layout2>) {
+    auto const pos = mismatch_blocks<common_storage_bytes<Layout, Layout2, CharT, N, N2>,
+                                     layout_traits<Layout>::width>(
+        reinterpret_cast<unsigned char const*>(lhs), reinterpret_cast<unsigned char const*>(rhs));
+    if (auto const i = pos / sizeof(CharT); i < std::min(N, N2)) {
+      return std::char_traits<CharT>::lt(lhs[i], rhs[i]) ? std::strong_ordering::less
+                                                         : std::strong_ordering::greater;
+    }
+    return N <=> N2;
+  }
+  else {
+    return compare<CharT, N, N2>(lhs, rhs);
+  }
+}
+
+#ifdef MTP_HAS_SSE2
+// byte strings padded to vectors of at least 16 bytes and at most 64 bytes long are searched by
+// building match masks over the whole storage
+template <typename Layout, typename CharT, std::size_t N, std::size_t M>
+inline constexpr bool search_blocks =
+    sizeof(CharT) == 1 && layout_traits<Layout>::width >= 16
+    && layout_traits<Layout>::template storage<CharT, N> <= 64 && M > 0;
+
+// bit `i` is set iff `ptr[i] == ch`
+template <std::size_t Bytes, std::size_t Width>
+[[nodiscard]] inline auto
+match_mask(unsigned char const* ptr, unsigned char ch) noexcept -> std::uint64_t
+{
+  using chunk = block_chunk_t<Width>;
+
+  return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    return (... | (std::uint64_t{ chunk::matches(ptr + Is * chunk::width, ch) }
+                   << (Is * chunk::width)));
+  }(std::make_index_sequence<Bytes / chunk::width>{});
+}
+
+template <auto Needle, std::size_t Bytes, std::size_t Width, typename CharT>
+[[nodiscard]] inline auto
+find_blocks(CharT const* hay, std::size_t count, std::size_t pos) noexcept -> std::size_t
+{
+  constexpr auto M = Needle.size();
+  constexpr auto second = M > 1 ? filter_second_v<Needle> : 0;
+
+  if (pos > count || count - pos < M) {
+    return npos;
+  }
+
+  auto const* bytes = reinterpret_cast<unsigned char const*>(hay);
+  auto mask = match_mask<Bytes, Width>(bytes, static_cast<unsigned char>(Needle[0]));
+  if constexpr (M > 1) {
+    mask &= match_mask<Bytes, Width>(bytes, static_cast<unsigned char>(Needle[second])) >> second;
+  }
+  // offsets `[pos, count - M]`
+  mask &= (~std::uint64_t{} << pos) & (~std::uint64_t{} >> (63 - (count - M)));
+
+  for (; mask != 0; mask &= mask - 1) {
+    auto const j = static_cast<std::size_t>(std::countr_zero(mask));
+    if (equal<CharT, M>(hay + j, Needle.data())) {
+      return j;
+    }
+  }
+  return npos;
+}
+#endif
+
+} // namespace detail
+
+// -------------------------------------------------------------------------------------------------
+
+// size erased kernels: past `MTP_OUTLINE_BYTES` the run time comparisons and swaps of a fixed
+// string forward to functions taking the size as an argument, so that all sizes share one copy of
+// the code instead of stamping out an unrolled one per size. smaller strings keep their inline
+// paths
+
+namespace detail {
+
+inline constexpr std::size_t outline_bytes = MTP_OUTLINE_BYTES;
+
+template <typename CharT, std::size_t N>
+inline constexpr bool outline = N * sizeof(CharT) > outline_bytes;
+
+[[nodiscard]] MTP_NOINLINE inline auto
+outline_equal(void const* lhs, void const* rhs, std::size_t bytes) noexcept -> bool
+{
+  return std::memcmp(lhs, rhs, bytes) == 0;
+}
+
+// sign of the first difference as `char_traits::compare`, for bytes a tail call to `memcmp`
+template <typename CharT>
+[[nodiscard]] MTP_NOINLINE inline auto
+outline_compare(CharT const* lhs, CharT const* rhs, std::size_t count) noexcept -> int
+{
+  return std::char_traits<CharT>::compare(lhs, rhs, count);
+}
+
+// through a buffer a block at a time, which `memcpy` moves with the widest loads available
+MTP_NOINLINE inline auto
+outline_swap(void* lhs, void* rhs, std::size_t bytes) noexcept -> void
+{
+  auto* first = static_cast<unsigned char*>(lhs);
+  auto* second = static_cast<unsigned char*>(rhs);
+  unsigned char buffer[256];
+  while (bytes > 0) {
+    auto const count = std::min(bytes, sizeof(buffer));
+    std::memcpy(buffer, first, count);
+    std::memcpy(first, second, count);
+    std::memcpy(second, buffer, count);
+    first += count;
+    second += count;
+    bytes -= count;
+  }
+}
+
+#ifndef MTP_NO_EXCEPTIONS
+// the throw of a bounds check is shared by all sizes and kept out of the callers' hot paths
+[[noreturn]] MTP_NOINLINE inline auto
+throw_out_of_range(char const* what) -> void
+{
+  throw std::out_of_range(what);
+}
+#endif
+
+// selects the constructor that leaves a fixed string to be written in place by its builders
+struct for_overwrite_t
+{
+  explicit for_overwrite_t() = default;
+};
+
+inline constexpr for_overwrite_t for_overwrite{};
+
+} // namespace detail
+
+template <typename CharT, std::size_t N, typename Layout>
+struct basic_fixed_string
+{
+  alignas(std::max(alignof(CharT), detail::layout_traits<Layout>::width))
+      CharT _data[detail::layout_traits<Layout>::template storage<CharT, N>] = {};
+
+  using value_type = CharT;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using const_pointer = value_type const*;
+  using pointer = value_type*;
+  using const_reference = value_type const&;
+  using reference = value_type&;
+  using const_iterator = const_pointer;
+  using iterator = const_iterator;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using reverse_iterator = const_reverse_iterator;
+
+  static constexpr std::integral_constant<size_type, N> size{};
+  static constexpr std::integral_constant<size_type, N> length{};
+  static constexpr std::integral_constant<size_type, N> max_size{};
+  static constexpr std::bool_constant<N == 0> empty{};
+
+  using layout_type = Layout;
+
+  static constexpr size_type npos = detail::npos;
+
+  static_assert(detail::layout_traits<Layout>::width % sizeof(CharT) == 0,
+                "mtp::basic_fixed_string: layout width must be a multiple of the character size");
+
+  template <std::convertible_to<CharT>... CharTs>
+    requires(sizeof...(CharTs) == N && (... && !std::is_pointer_v<CharTs>))
+  [[nodiscard]] explicit constexpr basic_fixed_string(CharTs... chars) noexcept
+      : _data{ chars... }
+  {}
+
+  [[nodiscard]] consteval basic_fixed_string(CharT const (&str)[N + 1]) noexcept
+  {
+    MTP_EXPECTS(str[N] == CharT{});
+    std::ranges::copy(str, str + N, _data);
+  }
+
+  template <std::input_iterator I, std::sentinel_for<I> S>
+    requires(std::convertible_to<std::iter_value_t<I>, CharT>)
+  [[nodiscard]] constexpr basic_fixed_string(I begin, S end) noexcept
+  {
+    MTP_EXPECTS(std::ranges::distance(begin, end) == N);
+    std::ranges::copy(begin, end, _data);
+  }
+
+  template <std::ranges::range R>
+    requires(std::convertible_to<std::ranges::range_value_t<R>, CharT>)
+  [[nodiscard]] explicit constexpr basic_fixed_string(std::from_range_t, R&& container) noexcept
+  {
+    MTP_EXPECTS(std::ranges::size(container) == N);
+    std::ranges::move(container, _data);
+  }
+
+  // zero filled storage for the concatenations to write their result into in place
+  [[nodiscard]] explicit constexpr basic_fixed_string(detail::for_overwrite_t) noexcept {}
+
+  [[nodiscard]] constexpr basic_fixed_string(basic_fixed_string const&) noexcept = default;
+
+  [[nodiscard]] constexpr auto operator=(basic_fixed_string const&) noexcept
+      -> basic_fixed_string& = default;
+
+  [[nodiscard]] constexpr auto
+  view() const noexcept -> std::basic_string_view<CharT>
+  {
+    return std::basic_string_view<CharT>{ data(), size() };
+  }
+
+  [[nodiscard]] constexpr
+  operator std::basic_string_view<CharT>() const noexcept
+  {
+    return view();
+  }
+
+  [[nodiscard]] constexpr auto
+  data() const noexcept -> const_pointer
+  {
+    return static_cast<const_pointer>(_data);
+  }
+
+  [[nodiscard]] constexpr auto
+  c_str() const noexcept -> const_pointer
+    requires(detail::layout_traits<Layout>::terminated)
+  {
+    return data();
+  }
+
+  [[nodiscard]] constexpr auto
+  cbegin() const noexcept -> const_iterator
+  {
+    return data();
+  }
+
+  [[nodiscard]] constexpr auto
+  cend() const noexcept -> const_iterator
+  {
+    return data() + size();
+  }
+
+  [[nodiscard]] constexpr auto
+  begin() const noexcept -> const_iterator
+  {
+    return cbegin();
+  }
+
+  [[nodiscard]] constexpr auto
+  end() const noexcept -> const_iterator
+  {
+    return cend();
+  }
+
+  [[nodiscard]] constexpr auto
+  crbegin() const noexcept -> const_reverse_iterator
+  {
+    return const_reverse_iterator{ end() };
+  }
+
+  [[nodiscard]] constexpr auto
+  crend() const noexcept -> const_reverse_iterator
+  {
+    return const_reverse_iterator{ begin() };
+  }
+
+  [[nodiscard]] constexpr auto
+  rbegin() const noexcept -> const_reverse_iterator
+  {
+    return crbegin();
+  }
+
+  [[nodiscard]] constexpr auto
+  rend() const noexcept -> const_reverse_iterator
+  {
+    return crend();
+  }
+
+  [[nodiscard]] constexpr auto
+  operator[](size_type pos) const noexcept -> const_reference
+  {
+    MTP_EXPECTS(pos < size());
+    return _data[pos];
+  }
+
+  [[nodiscard]] constexpr auto
+  at(size_type pos) const MTP_NOEXCEPT -> const_reference
+  {
+#ifdef MTP_NO_EXCEPTIONS
+    MTP_EXPECTS(pos < size());
+#else
+    if (pos >= size()) {
+      detail::throw_out_of_range("mtp::basic_fixed_string::at");
+    }
+#endif
+    return (*this)[pos];
+  }
+
+  [[nodiscard]] constexpr auto
+  front() const noexcept -> const_reference
+  {
+    MTP_EXPECTS(!empty());
+    return (*this)[0];
+  }
+
+  [[nodiscard]] constexpr auto
+  back() const noexcept -> const_reference
+  {
+    MTP_EXPECTS(!empty());
+    return (*this)[size() - 1];
+  }
+
+  [[nodiscard]] constexpr auto
+  find(std::basic_string_view<CharT> sv, size_type pos = 0) const noexcept -> size_type
+  {
+    return view().find(sv, pos);
+  }
+
+  [[nodiscard]] constexpr auto
+  find(CharT ch, size_type pos = 0) const noexcept -> size_type
+  {
+    return view().find(ch, pos);
+  }
+
+  // the needle's search tables are built at compile time, see `detail::find_needle`
+  template <::mtp::basic_fixed_string Needle>
+    requires(std::same_as<typename decltype(Needle)::value_type, CharT>)
+  [[nodiscard]] constexpr auto
+  find(size_type pos = 0) const noexcept -> size_type
+  {
+#ifdef MTP_HAS_SSE2
+    if constexpr (detail::search_blocks<Layout, CharT, N, Needle.size()>) {
+      if (!std::is_constant_evaluated()) {
+        return detail::find_blocks<Needle, sizeof(_data), detail::layout_traits<Layout>::width>(
+            data(), size(), pos);
+      }
+    }
+#endif
+    return detail::find_needle<Needle>(data(), size(), pos);
+  }
+
+  [[nodiscard]] constexpr auto
+  rfind(std::basic_string_view<CharT> sv, size_type pos = npos) const noexcept -> size_type
+  {
+    return view().rfind(sv, pos);
+  }
+
+  [[nodiscard]] constexpr auto
+  rfind(CharT ch, size_type pos = npos) const noexcept -> size_type
+  {
+    return view().rfind(ch, pos);
+  }
+
+  [[nodiscard]] constexpr auto
+  find_first_of(std::basic_string_view<CharT> sv, size_type pos = 0) const noexcept -> size_type
+  {
+    return view().find_first_of(sv, pos);
+  }
+
+  [[nodiscard]] constexpr auto
+  find_first_of(CharT ch, size_type pos = 0) const noexcept -> size_type
+  {
+    return view().find_first_of(ch, pos);
+  }
+
+  template <::mtp::basic_fixed_string Set>
+    requires(std::same_as<typename decltype(Set)::value_type, CharT>)
+  [[nodiscard]] constexpr auto
+  find_first_of(size_type pos = 0) const noexcept -> size_type
+  {
+    return detail::find_first_of_set<Set>(data(), size(), pos);
+  }
+
+  [[nodiscard]] constexpr auto
+  contains(std::basic_string_view<CharT> sv) const noexcept -> bool
+  {
+    return find(sv) != npos;
+  }
+
+  [[nodiscard]] constexpr auto
+  contains(CharT ch) const noexcept -> bool
+  {
+    return find(ch) != npos;
+  }
+
+  template <::mtp::basic_fixed_string Needle>
+    requires(std::same_as<typename decltype(Needle)::value_type, CharT>)
+  [[nodiscard]] constexpr auto
+  contains() const noexcept -> bool
+  {
+    return find<Needle>() != npos;
+  }
+
+  [[nodiscard]] constexpr auto
+  starts_with(std::basic_string_view<CharT> sv) const noexcept -> bool
+  {
+    return view().starts_with(sv);
+  }
+
+  [[nodiscard]] constexpr auto
+  starts_with(CharT ch) const noexcept -> bool
+  {
+    return view().starts_with(ch);
+  }
+
+  template <::mtp::basic_fixed_string Prefix>
+    requires(std::same_as<typename decltype(Prefix)::value_type, CharT>)
+  [[nodiscard]] constexpr auto
+  starts_with() const noexcept -> bool
+  {
+    constexpr auto M = Prefix.size();
+    if constexpr (M > N) {
+      return false;
+    }
+    else {
+      if (std::is_constant_evaluated()) {
+        return view().starts_with(Prefix.view());
+      }
+      return detail::equal<CharT, M>(data(), Prefix.data());
+    }
+  }
+
+  [[nodiscard]] constexpr auto
+  ends_with(std::basic_string_view<CharT> sv) const noexcept -> bool
+  {
+    return view().ends_with(sv);
+  }
+
+  [[nodiscard]] constexpr auto
+  ends_with(CharT ch) const noexcept -> bool
+  {
+    return view().ends_with(ch);
+  }
+
+  template <::mtp::basic_fixed_string Suffix>
+    requires(std::same_as<typename decltype(Suffix)::value_type, CharT>)
+  [[nodiscard]] constexpr auto
+  ends_with() const noexcept -> bool
+  {
+    constexpr auto M = Suffix.size();
+    if constexpr (M > N) {
+      return false;
+    }
+    else {
+      if (std::is_constant_evaluated()) {
+        return view().ends_with(Suffix.view());
+      }
+      return detail::equal<CharT, M>(data() + (N - M), Suffix.data());
+    }
+  }
+
+  constexpr auto
+  swap(basic_fixed_string& fs) noexcept -> void
+  {
+    if constexpr (detail::outline<CharT, N>) {
+      if (!std::is_constant_evaluated()) {
+        detail::outline_swap(_data, fs._data, N * sizeof(CharT));
+        return;
+      }
+    }
+    std::ranges::swap_ranges(_data, _data + size(), fs._data, fs._data + fs.size());
+  }
+
+  // the result has the layout of the left operand, or of the only fixed string operand
+  template <std::size_t N2, typename Layout2>
+  [[nodiscard]] friend constexpr auto
+  operator+(basic_fixed_string const& lhs,
+            basic_fixed_string<CharT, N2, Layout2> const& rhs) noexcept
+      -> basic_fixed_string<CharT, N + N2, Layout>
+  {
+    auto result = basic_fixed_string<CharT, N + N2, Layout>{ detail::for_overwrite };
+    auto* const it = std::ranges::copy(lhs.begin(), lhs.end(), result._data).out;
+    std::ranges::copy(rhs.begin(), rhs.end(), it);
+    return result;
+  }
+
+  [[nodiscard]] friend constexpr auto
+  operator+(basic_fixed_string const& lhs, CharT rhs) noexcept
+      -> basic_fixed_string<CharT, N + 1, Layout>
+  {
+    auto result = basic_fixed_string<CharT, N + 1, Layout>{ detail::for_overwrite };
+    *std::ranges::copy(lhs.begin(), lhs.end(), result._data).out = rhs;
+    return result;
+  }
+
+  [[nodiscard]] friend constexpr auto
+  operator+(CharT lhs, basic_fixed_string const& rhs) noexcept
+      -> basic_fixed_string<CharT, 1 + N, Layout>
+  {
+    auto result = basic_fixed_string<CharT, 1 + N, Layout>{ detail::for_overwrite };
+    result._data[0] = lhs;
+    std::ranges::copy(rhs.begin(), rhs.end(), result._data + 1);
+    return result;
+  }
+
+  template <std::size_t N2>
+  [[nodiscard]] friend consteval auto
+  operator+(basic_fixed_string const& lhs, CharT const (&rhs)[N2]) noexcept
+      -> basic_fixed_string<CharT, N + (N2 - 1), Layout>
+  {
+    MTP_EXPECTS(rhs[N2 - 1] == CharT{});
+
+    auto result = basic_fixed_string<CharT, N + (N2 - 1), Layout>{ detail::for_overwrite };
+    auto* const it = std::ranges::copy(lhs.begin(), lhs.end(), result._data).out;
+    std::ranges::copy(rhs, rhs + N2 - 1, it);
+    return result;
+  }
+
+  template <std::size_t N2>
+  [[nodiscard]] friend consteval auto
+  operator+(CharT const (&lhs)[N2], basic_fixed_string const& rhs) noexcept
+      -> basic_fixed_string<CharT, (N2 - 1) + N, Layout>
+  {
+    MTP_EXPECTS(lhs[N2 - 1] == CharT{});
+
+    auto result = basic_fixed_string<CharT, (N2 - 1) + N, Layout>{ detail::for_overwrite };
+    auto* const it = std::ranges::copy(lhs, lhs + N2 - 1, result._data).out;
+    std::ranges::copy(rhs.begin(), rhs.end(), it);
+    return result;
+  }
+
+  template <std::size_t N2, typename Layout2>
+  [[nodiscard]] friend constexpr auto
+  operator==(basic_fixed_string const& lhs,
+             basic_fixed_string<CharT, N2, Layout2> const& rhs) noexcept -> bool
+  {
+    if constexpr (N != N2) {
+      return false;
+    }
+    else {
+      if (std::is_constant_evaluated()) {
+        return lhs.view() == rhs.view();
+      }
+      if constexpr (detail::outline<CharT, N>) {
+        return detail::outline_equal(lhs.data(), rhs.data(), N * sizeof(CharT));
+      }
+      else {
+        return detail::equal_storage<Layout, Layout2, CharT, N>(lhs.data(), rhs.data());
+      }
+    }
+  }
+
+#ifdef MTP_HAS_THREE_WAY_COMPARE
+  template <std::size_t N2, typename Layout2>
+  [[nodiscard]] friend constexpr auto
+  operator<=>(basic_fixed_string const& lhs,
+              basic_fixed_string<CharT, N2, Layout2> const& rhs) noexcept -> std::strong_ordering
+  {
+    if (std::is_constant_evaluated()) {
+      return lhs.view() <=> rhs.view();
+    }
+    if constexpr (detail::outline<CharT, std::min(N, N2)>) {
+      if (auto const cmp = detail::outline_compare(lhs.data(), rhs.data(), std::min(N, N2));
+          cmp != 0) {
+        return cmp < 0 ? std::strong_ordering::less : std::strong_ordering::greater;
+      }
+      return N <=> N2;
+    }
+    else {
+      return detail::compare_storage<Layout, Layout2, CharT, N, N2>(lhs.data(), rhs.data());
+    }
+  }
+#endif
+
+  template <std::size_t N2>
+  [[nodiscard]] friend consteval auto
+  operator==(basic_fixed_string const& lhs, CharT const (&rhs)[N2]) noexcept -> bool
+  {
+    MTP_EXPECTS(rhs[N2 - 1] == CharT{});
+    return lhs.view() == std::basic_string_view<CharT>{ rhs, N2 - 1 };
+  }
+
+#ifdef MTP_HAS_THREE_WAY_COMPARE
+  template <std::size_t N2>
+  [[nodiscard]] friend consteval auto
+  operator<=>(basic_fixed_string const& lhs, CharT const (&rhs)[N2]) noexcept
+      -> std::strong_ordering
+  {
+    MTP_EXPECTS(rhs[N2 - 1] == CharT{});
+    return lhs.view() <=> std::basic_string_view<CharT>{ rhs, N2 - 1 };
+  }
+#endif
+
+  friend auto
+  operator<<(std::basic_ostream<CharT>& os, basic_fixed_string const& fs) noexcept
+      -> std::basic_ostream<CharT>&
+  {
+    return os << fs.view();
+  }
+};
+
+namespace concepts {
+
+template <typename T, typename... Ts>
+concept any_of = (... || std::same_as<T, Ts>);
+
+template <typename T>
+concept char_type =
+#ifdef MTP_HAS_CHAR8_TYPE
+    any_of<T, char, wchar_t, char8_t, char16_t, char32_t>;
+#else
+    any_of<T, char, wchar_t, char16_t, char32_t>;
+#endif
+
+} // namespace concepts
+
+MTP_EXPORT template <concepts::char_type CharT, std::convertible_to<CharT>... CharTs>
+basic_fixed_string(CharT, CharTs...) -> basic_fixed_string<CharT, 1 + sizeof...(CharTs)>;
+
+MTP_EXPORT template <concepts::char_type CharT, std::size_t N>
+basic_fixed_string(CharT const (&)[N]) -> basic_fixed_string<CharT, N - 1>;
+
+MTP_EXPORT template <concepts::char_type CharT, std::size_t N>
+basic_fixed_string(std::from_range_t, std::array<CharT, N>) -> basic_fixed_string<CharT, N>;
+
+// -------------------------------------------------------------------------------------------------
+
+// n-ary concatenation of fixed strings, single characters and string literals. the size of the
+// result follows from the types of the pieces, so it is known before anything is copied and each
+// piece is written once, straight into the result
+
+namespace detail {
+
+template <typename T>
+struct piece_traits;
+
+template <typename CharT, std::size_t N, typename Layout>
+struct piece_traits<basic_fixed_string<CharT, N, Layout>>
+{
+  using char_type = CharT;
+  static constexpr std::size_t size = N;
+};
+
+template <concepts::char_type CharT, std::size_t N>
+struct piece_traits<CharT[N]>
+{
+  using char_type = CharT;
+  static constexpr std::size_t size = N - 1;
+};
+
+template <concepts::char_type CharT>
+struct piece_traits<CharT>
+{
+  using char_type = CharT;
+  static constexpr std::size_t size = 1;
+};
+
+template <typename T>
+using piece_char_t = typename piece_traits<std::remove_cvref_t<T>>::char_type;
+
+template <typename T>
+inline constexpr std::size_t piece_size = piece_traits<std::remove_cvref_t<T>>::size;
+
+// a copy of a size known at compile time, which the compiler expands into a few moves instead of a
+// call to `memmove`
+template <std::size_t Count, typename CharT>
+constexpr auto
+copy_chars(CharT const* first, CharT* out) noexcept -> CharT*
+{
+  if (std::is_constant_evaluated()) {
+    return std::ranges::copy(first, first + Count, out).out;
+  }
+  std::memcpy(out, first, Count * sizeof(CharT));
+  return out + Count;
+}
+
+template <typename CharT, typename Piece>
+constexpr auto
+write_piece(CharT* out, Piece const& piece) noexcept -> CharT*
+{
+  if constexpr (std::same_as<Piece, CharT>) {
+    *out = piece;
+    return out + 1;
+  }
+  else if constexpr (std::is_array_v<Piece>) {
+    MTP_EXPECTS(piece[piece_size<Piece>] == CharT{});
+    return copy_chars<piece_size<Piece>>(piece, out);
+  }
+  else {
+    return copy_chars<piece_size<Piece>>(piece.data(), out);
+  }
+}
+
+} // namespace detail
+
+namespace concepts {
+
+template <typename T>
+concept piece = requires { typename detail::piece_char_t<T>; };
+
+// fixed strings, characters and literals of one character type
+template <typename Piece, typename... Pieces>
+concept concatenable = piece<Piece> && (... && piece<Pieces>)
+                       && (... && std::same_as<detail::piece_char_t<Pieces>,
+                                               detail::piece_char_t<Piece>>);
+
+} // namespace concepts
+
+// the pieces one after the other in a `basic_fixed_string` of their total size
+MTP_EXPORT template <typename Piece, typename... Pieces>
+  requires(concepts::concatenable<Piece, Pieces...>)
+[[nodiscard]] constexpr auto
+concat(Piece const& piece, Pieces const&... pieces) noexcept
+{
+  using char_type = detail::piece_char_t<Piece>;
+  constexpr auto size = detail::piece_size<Piece> + (0 + ... + detail::piece_size<Pieces>);
+
+  auto result = basic_fixed_string<char_type, size>{ detail::for_overwrite };
+  [[maybe_unused]] auto* out = detail::write_piece(result._data, piece);
+  ((out = detail::write_piece(out, pieces)), ...);
+  return result;
+}
+
+// the pieces with `Sep` between each two of them
+MTP_EXPORT template <basic_fixed_string Sep, typename Piece, typename... Pieces>
+  requires(concepts::concatenable<decltype(Sep), Piece, Pieces...>)
+[[nodiscard]] constexpr auto
+join(Piece const& piece, Pieces const&... pieces) noexcept
+{
+  using char_type = typename decltype(Sep)::value_type;
+  constexpr auto size = detail::piece_size<Piece>
+                        + (0 + ... + (Sep.size() + detail::piece_size<Pieces>));
+
+  auto result = basic_fixed_string<char_type, size>{ detail::for_overwrite };
+  [[maybe_unused]] auto* out = detail::write_piece(result._data, piece);
+  ((out = detail::write_piece(detail::copy_chars<Sep.size()>(Sep.data(), out), pieces)), ...);
+  return result;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+// mutable, variable-length string with inline storage for up to `Capacity` characters. it never
+// allocates, its size field is the smallest unsigned type that holds `Capacity` and it is
+// trivially copyable, so it can be placed in shared memory or passed through lock-free queues.
+// the contents are always null-terminated
+
+template <typename CharT, std::size_t Capacity>
+struct basic_inplace_string
+{
+  CharT _data[Capacity + 1] = {};
+  detail::uint_least_t<Capacity> _size = 0;
+
+  using value_type = CharT;
+  using traits_type = std::char_traits<CharT>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using const_pointer = value_type const*;
+  using pointer = value_type*;
+  using const_reference = value_type const&;
+  using reference = value_type&;
+  using const_iterator = const_pointer;
+  using iterator = pointer;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+
+  static constexpr size_type npos = static_cast<size_type>(-1);
+
+  static constexpr std::integral_constant<size_type, Capacity> capacity{};
+  static constexpr std::integral_constant<size_type, Capacity> max_size{};
+
+  [[nodiscard]] constexpr basic_inplace_string() noexcept = default;
+
+  template <std::size_t N, typename Layout>
+    requires(N <= Capacity)
+  [[nodiscard]] constexpr basic_inplace_string(
+      basic_fixed_string<CharT, N, Layout> const& fs) noexcept
+      : _size{ static_cast<detail::uint_least_t<Capacity>>(N) }
+  {
+    std::ranges::copy(fs.begin(), fs.end(), _data);
+  }
+
+  template <std::size_t N>
+    requires(N > 0 && N - 1 <= Capacity)
+  [[nodiscard]] constexpr basic_inplace_string(CharT const (&str)[N]) noexcept
+      : _size{ static_cast<detail::uint_least_t<Capacity>>(N - 1) }
+  {
+    MTP_EXPECTS(str[N - 1] == CharT{});
+    std::ranges::copy(str, str + N - 1, _data);
+  }
+
+  [[nodiscard]] explicit constexpr basic_inplace_string(std::basic_string_view<CharT> sv)
+      MTP_NOEXCEPT
+  {
+    assign(sv);
+  }
+
+  [[nodiscard]] constexpr basic_inplace_string(size_type count, CharT ch) MTP_NOEXCEPT
+  {
+    assign(count, ch);
+  }
+
+  template <std::input_iterator I, std::sentinel_for<I> S>
+    requires(std::convertible_to<std::iter_value_t<I>, CharT>)
+  [[nodiscard]] constexpr basic_inplace_string(I begin, S end) MTP_NOEXCEPT
+  {
+    for (; begin != end; ++begin) {
+      push_back(static_cast<CharT>(*begin));
+    }
+  }
+
+  template <std::ranges::range R>
+    requires(std::convertible_to<std::ranges::range_value_t<R>, CharT>)
+  [[nodiscard]] explicit constexpr basic_inplace_string(std::from_range_t, R&& container)
+      MTP_NOEXCEPT : basic_inplace_string(std::ranges::begin(container),
+                                          std::ranges::end(container))
+  {}
+
+  [[nodiscard]] constexpr basic_inplace_string(basic_inplace_string const&) noexcept = default;
+
+  [[nodiscard]] constexpr auto operator=(basic_inplace_string const&) noexcept
+      -> basic_inplace_string& = default;
+
+  // exact-size copy, the size must be `N`
+  template <std::size_t N, typename Layout>
+  [[nodiscard]] explicit constexpr
+  operator basic_fixed_string<CharT, N, Layout>() const noexcept
+  {
+    MTP_EXPECTS(size() == N);
+    return basic_fixed_string<CharT, N, Layout>{ begin(), end() };
+  }
+
+  [[nodiscard]] constexpr auto
+  view() const noexcept -> std::basic_string_view<CharT>
+  {
+    return std::basic_string_view<CharT>{ data(), size() };
+  }
+
+  [[nodiscard]] constexpr
+  operator std::basic_string_view<CharT>() const noexcept
+  {
+    return view();
+  }
+
+  [[nodiscard]] constexpr auto
+  data() const noexcept -> const_pointer
+  {
+    return static_cast<const_pointer>(_data);
+  }
+
+  [[nodiscard]] constexpr auto
+  data() noexcept -> pointer
+  {
+    return static_cast<pointer>(_data);
+  }
+
+  [[nodiscard]] constexpr auto
+  c_str() const noexcept -> const_pointer
+  {
+    return data();
+  }
+
+  [[nodiscard]] constexpr auto
+  size() const noexcept -> size_type
+  {
+    return _size;
+  }
+
+  [[nodiscard]] constexpr auto
+  length() const noexcept -> size_type
+  {
+    return size();
+  }
+
+  [[nodiscard]] constexpr auto
+  empty() const noexcept -> bool
+  {
+    return size() == 0;
+  }
+
+  [[nodiscard]] constexpr auto
+  cbegin() const noexcept -> const_iterator
+  {
+    return data();
+  }
+
+  [[nodiscard]] constexpr auto
+  cend() const noexcept -> const_iterator
+  {
+    return data() + size();
+  }
+
+  [[nodiscard]] constexpr auto
+  begin() const noexcept -> const_iterator
+  {
+    return cbegin();
+  }
+
+  [[nodiscard]] constexpr auto
+  end() const noexcept -> const_iterator
+  {
+    return cend();
+  }
+
+  [[nodiscard]] constexpr auto
+  begin() noexcept -> iterator
+  {
+    return data();
+  }
+
+  [[nodiscard]] constexpr auto
+  end() noexcept -> iterator
+  {
+    return data() + size();
+  }
+
+  [[nodiscard]] constexpr auto
+  crbegin() const noexcept -> const_reverse_iterator
+  {
+    return const_reverse_iterator{ end() };
+  }
+
+  [[nodiscard]] constexpr auto
+  crend() const noexcept -> const_reverse_iterator
+  {
+    return const_reverse_iterator{ begin() };
+  }
+
+  [[nodiscard]] constexpr auto
+  rbegin() const noexcept -> const_reverse_iterator
+  {
+    return crbegin();
+  }
+
+  [[nodiscard]] constexpr auto
+  rend() const noexcept -> const_reverse_iterator
+  {
+    return crend();
+  }
+
+  [[nodiscard]] constexpr auto
+  rbegin() noexcept -> reverse_iterator
+  {
+    return reverse_iterator{ end() };
+  }
+
+  [[nodiscard]] constexpr auto
+  rend() noexcept -> reverse_iterator
+  {
+    return reverse_iterator{ begin() };
+  }
+
+  [[nodiscard]] constexpr auto
+  operator[](size_type pos) const noexcept -> const_reference
+  {
+    MTP_EXPECTS(pos < size());
+    return _data[pos];
+  }
+
+  [[nodiscard]] constexpr auto
+  operator[](size_type pos) noexcept -> reference
+  {
+    MTP_EXPECTS(pos < size());
+    return _data[pos];
+  }
+
+  [[nodiscard]] constexpr auto
+  at(size_type pos) const MTP_NOEXCEPT -> const_reference
+  {
+    check_position(pos < size(), "mtp::basic_inplace_string::at");
+    return (*this)[pos];
+  }
+
+  [[nodiscard]] constexpr auto
+  at(size_type pos) MTP_NOEXCEPT -> reference
+  {
+    check_position(pos < size(), "mtp::basic_inplace_string::at");
+    return (*this)[pos];
+  }
+
+  [[nodiscard]] constexpr auto
+  front() const noexcept -> const_reference
+  {
+    MTP_EXPECTS(!empty());
+    return (*this)[0];
+  }
+
+  [[nodiscard]] constexpr auto
+  front() noexcept -> reference
+  {
+    MTP_EXPECTS(!empty());
+    return (*this)[0];
+  }
+
+  [[nodiscard]] constexpr auto
+  back() const noexcept -> const_reference
+  {
+    MTP_EXPECTS(!empty());
+    return (*this)[size() - 1];
+  }
+
+  [[nodiscard]] constexpr auto
+  back() noexcept -> reference
+  {
+    MTP_EXPECTS(!empty());
+    return (*this)[size() - 1];
+  }
+
+  constexpr auto
+  clear() noexcept -> void
+  {
+    set_size(0);
+  }
+
+  constexpr auto
+  assign(std::basic_string_view<CharT> sv) MTP_NOEXCEPT -> basic_inplace_string&
+  {
+    check_length(sv.size(), "mtp::basic_inplace_string::assign");
+    // `sv` may view this string, so the characters are moved rather than copied
+    traits_type::move(_data, sv.data(), sv.size());
+    set_size(sv.size());
+    return *this;
+  }
+
+  constexpr auto
+  assign(size_type count, CharT ch) MTP_NOEXCEPT -> basic_inplace_string&
+  {
+    check_length(count, "mtp::basic_inplace_string::assign");
+    traits_type::assign(_data, count, ch);
+    set_size(count);
+    return *this;
+  }
+
+  constexpr auto
+  push_back(CharT ch) MTP_NOEXCEPT -> void
+  {
+    check_length(size() + 1, "mtp::basic_inplace_string::push_back");
+    _data[size()] = ch;
+    set_size(size() + 1);
+  }
+
+  constexpr auto
+  pop_back() noexcept -> void
+  {
+    MTP_EXPECTS(!empty());
+    set_size(size() - 1);
+  }
+
+  constexpr auto
+  append(std::basic_string_view<CharT> sv) MTP_NOEXCEPT -> basic_inplace_string&
+  {
+    check_length(size() + sv.size(), "mtp::basic_inplace_string::append");
+    // a view of this string ends at or before `end()`, so it never overlaps the destination
+    traits_type::copy(end(), sv.data(), sv.size());
+    set_size(size() + sv.size());
+    return *this;
+  }
+
+  constexpr auto
+  append(size_type count, CharT ch) MTP_NOEXCEPT -> basic_inplace_string&
+  {
+    check_length(size() + count, "mtp::basic_inplace_string::append");
+    traits_type::assign(end(), count, ch);
+    set_size(size() + count);
+    return *this;
+  }
+
+  constexpr auto
+  operator+=(std::basic_string_view<CharT> sv) MTP_NOEXCEPT -> basic_inplace_string&
+  {
+    return append(sv);
+  }
+
+  constexpr auto
+  operator+=(CharT ch) MTP_NOEXCEPT -> basic_inplace_string&
+  {
+    push_back(ch);
+    return *this;
+  }
+
+  // inserting appends and then rotates the new characters into place, which stays correct when
+  // `sv` views this string
+  constexpr auto
+  insert(size_type pos, std::basic_string_view<CharT> sv) MTP_NOEXCEPT -> basic_inplace_string&
+  {
+    check_position(pos <= size(), "mtp::basic_inplace_string::insert");
+    auto const old_size = size();
+    append(sv);
+    std::ranges::rotate(begin() + pos, begin() + old_size, end());
+    return *this;
+  }
+
+  constexpr auto
+  insert(size_type pos, size_type count, CharT ch) MTP_NOEXCEPT -> basic_inplace_string&
+  {
+    check_position(pos <= size(), "mtp::basic_inplace_string::insert");
+    check_length(size() + count, "mtp::basic_inplace_string::insert");
+    traits_type::move(begin() + pos + count, begin() + pos, size() - pos);
+    traits_type::assign(begin() + pos, count, ch);
+    set_size(size() + count);
+    return *this;
+  }
+
+  constexpr auto
+  insert(const_iterator it, CharT ch) MTP_NOEXCEPT -> iterator
+  {
+    auto const pos = static_cast<size_type>(it - begin());
+    insert(pos, 1, ch);
+    return begin() + pos;
+  }
+
+  constexpr auto
+  erase(size_type pos = 0, size_type count = npos) MTP_NOEXCEPT -> basic_inplace_string&
+  {
+    check_position(pos <= size(), "mtp::basic_inplace_string::erase");
+    count = std::min(count, size() - pos);
+    traits_type::move(begin() + pos, begin() + pos + count, size() - pos - count);
+    set_size(size() - count);
+    return *this;
+  }
+
+  constexpr auto
+  erase(const_iterator first, const_iterator last) noexcept -> iterator
+  {
+    MTP_EXPECTS(begin() <= first && first <= last && last <= end());
+    auto const pos = static_cast<size_type>(first - begin());
+    auto const count = static_cast<size_type>(last - first);
+    traits_type::move(begin() + pos, begin() + pos + count, size() - pos - count);
+    set_size(size() - count);
+    return begin() + pos;
+  }
+
+  constexpr auto
+  erase(const_iterator it) noexcept -> iterator
+  {
+    MTP_EXPECTS(begin() <= it && it < end());
+    return erase(it, it + 1);
+  }
+
+  constexpr auto
+  resize(size_type count, CharT ch) MTP_NOEXCEPT -> void
+  {
+    check_length(count, "mtp::basic_inplace_string::resize");
+    if (count > size()) {
+      traits_type::assign(end(), count - size(), ch);
+    }
+    set_size(count);
+  }
+
+  constexpr auto
+  resize(size_type count) MTP_NOEXCEPT -> void
+  {
+    resize(count, CharT{});
+  }
+
+  // `op(data(), count)` writes up to `count` characters and returns how many it wrote, characters
+  // past the current size start out unspecified
+  template <typename Op>
+  constexpr auto
+  resize_and_overwrite(size_type count, Op op) MTP_NOEXCEPT -> void
+  {
+    check_length(count, "mtp::basic_inplace_string::resize_and_overwrite");
+    auto const written = static_cast<size_type>(std::move(op)(data(), count));
+    MTP_EXPECTS(written <= count);
+    set_size(written);
+  }
+
+  constexpr auto
+  swap(basic_inplace_string& is) noexcept -> void
+  {
+    std::ranges::swap(*this, is);
+  }
+
+  template <std::size_t Capacity2>
+  [[nodiscard]] friend constexpr auto
+  operator==(basic_inplace_string const& lhs,
+             basic_inplace_string<CharT, Capacity2> const& rhs) noexcept -> bool
+  {
+    return lhs.view() == rhs.view();
+  }
+
+  [[nodiscard]] friend constexpr auto
+  operator==(basic_inplace_string const& lhs, std::basic_string_view<CharT> rhs) noexcept -> bool
+  {
+    return lhs.view() == rhs;
+  }
+
+#ifdef MTP_HAS_THREE_WAY_COMPARE
+  template <std::size_t Capacity2>
+  [[nodiscard]] friend constexpr auto
+  operator<=>(basic_inplace_string const& lhs,
+              basic_inplace_string<CharT, Capacity2> const& rhs) noexcept -> std::strong_ordering
+  {
+    return lhs.view() <=> rhs.view();
+  }
+
+  [[nodiscard]] friend constexpr auto
+  operator<=>(basic_inplace_string const& lhs, std::basic_string_view<CharT> rhs) noexcept
+      -> std::strong_ordering
+  {
+    return lhs.view() <=> rhs;
+  }
+#endif
+
+  friend auto
+  operator<<(std::basic_ostream<CharT>& os, basic_inplace_string const& is) noexcept
+      -> std::basic_ostream<CharT>&
+  {
+    return os << is.view();
+  }
+
+private:
+  constexpr auto
+  set_size(size_type count) noexcept -> void
+  {
+    MTP_EXPECTS(count <= Capacity);
+    _size = static_cast<detail::uint_least_t<Capacity>>(count);
+    _data[count] = CharT{};
+  }
+
+  static constexpr auto
+  check_length(size_type count, [[maybe_unused]] char const* what) MTP_NOEXCEPT -> void
+  {
+#ifdef MTP_NO_EXCEPTIONS
+    MTP_EXPECTS(count <= Capacity);
+#else
+    if (count > Capacity) {
+      throw std::length_error(what);
+    }
+#endif
+  }
+
+  static constexpr auto
+  check_position(bool valid, [[maybe_unused]] char const* what) MTP_NOEXCEPT -> void
+  {
+#ifdef MTP_NO_EXCEPTIONS
+    MTP_EXPECTS(valid);
+#else
+    if (!valid) {
+      throw std::out_of_range(what);
+    }
+#endif
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+
+// searching any string view for a needle (or character set) known at compile time, the search
+// tables are built once per needle. the results match the corresponding `basic_string_view` members
+
+MTP_EXPORT template <basic_fixed_string Needle>
+[[nodiscard]] constexpr auto
+find(std::basic_string_view<typename decltype(Needle)::value_type> hay,
+     std::size_t pos = 0) noexcept -> std::size_t
+{
+  return detail::find_needle<Needle>(hay.data(), hay.size(), pos);
+}
+
+MTP_EXPORT template <basic_fixed_string Needle>
+[[nodiscard]] constexpr auto
+contains(std::basic_string_view<typename decltype(Needle)::value_type> hay) noexcept -> bool
+{
+  return detail::find_needle<Needle>(hay.data(), hay.size(), 0) != detail::npos;
+}
+
+MTP_EXPORT template <basic_fixed_string Set>
+[[nodiscard]] constexpr auto
+find_first_of(std::basic_string_view<typename decltype(Set)::value_type> hay,
+              std::size_t pos = 0) noexcept -> std::size_t
+{
+  return detail::find_first_of_set<Set>(hay.data(), hay.size(), pos);
+}
+
+MTP_EXPORT template <basic_fixed_string Prefix>
+[[nodiscard]] constexpr auto
+starts_with(std::basic_string_view<typename decltype(Prefix)::value_type> hay) noexcept -> bool
+{
+  using char_type = typename decltype(Prefix)::value_type;
+  constexpr auto M = Prefix.size();
+
+  if (std::is_constant_evaluated()) {
+    return hay.starts_with(Prefix.view());
+  }
+  return hay.size() >= M && detail::equal<char_type, M>(hay.data(), Prefix.data());
+}
+
+MTP_EXPORT template <basic_fixed_string Suffix>
+[[nodiscard]] constexpr auto
+ends_with(std::basic_string_view<typename decltype(Suffix)::value_type> hay) noexcept -> bool
+{
+  using char_type = typename decltype(Suffix)::value_type;
+  constexpr auto M = Suffix.size();
+
+  if (std::is_constant_evaluated()) {
+    return hay.ends_with(Suffix.view());
+  }
+  return hay.size() >= M
+         && detail::equal<char_type, M>(hay.data() + (hay.size() - M), Suffix.data());
+}
+
+// -------------------------------------------------------------------------------------------------
+
+// constexpr hashing that is consistent between `basic_fixed_string` and `basic_string_view`, so
+// that hashed containers keyed by `basic_fixed_string` can be probed with a view. for a known `N`
+// the hash is fully unrolled
+
+MTP_EXPORT template <typename T = void>
+struct hash;
+
+MTP_EXPORT template <typename CharT, std::size_t N, typename Layout>
+struct hash<basic_fixed_string<CharT, N, Layout>>
+{
+  [[nodiscard]] constexpr auto
+  operator()(basic_fixed_string<CharT, N, Layout> const& fs) const noexcept -> std::size_t
+  {
+    return static_cast<std::size_t>(detail::wyhash(fs.data(), N, 0));
+  }
+};
+
+MTP_EXPORT template <typename CharT, std::size_t Capacity>
+struct hash<basic_inplace_string<CharT, Capacity>>
+{
+  [[nodiscard]] constexpr auto
+  operator()(basic_inplace_string<CharT, Capacity> const& is) const noexcept -> std::size_t
+  {
+    return static_cast<std::size_t>(detail::wyhash(is.data(), is.size(), 0));
+  }
+};
+
+MTP_EXPORT template <typename CharT>
+struct hash<std::basic_string_view<CharT>>
+{
+  [[nodiscard]] constexpr auto
+  operator()(std::basic_string_view<CharT> sv) const noexcept -> std::size_t
+  {
+    return static_cast<std::size_t>(detail::wyhash(sv.data(), sv.size(), 0));
+  }
+};
+
+// a view with its hash computed ahead of time, see `prehashed_v`
+MTP_EXPORT template <typename CharT>
+struct basic_prehashed_string_view
+{
+  std::basic_string_view<CharT> view;
+  std::size_t hash;
+};
+
+namespace concepts {
+
+template <typename T>
+concept string_view_like = requires { typename T::value_type; }
+                           && std::convertible_to<T const&,
+                                                  std::basic_string_view<typename T::value_type>>;
+
+} // namespace concepts
+
+MTP_EXPORT template <>
+struct hash<void>
+{
+  using is_transparent = void;
+
+  template <typename CharT, std::size_t N, typename Layout>
+  [[nodiscard]] constexpr auto
+  operator()(basic_fixed_string<CharT, N, Layout> const& fs) const noexcept -> std::size_t
+  {
+    return hash<basic_fixed_string<CharT, N, Layout>>{}(fs);
+  }
+
+  template <concepts::string_view_like S>
+  [[nodiscard]] constexpr auto
+  operator()(S const& str) const noexcept -> std::size_t
+  {
+    using char_type = typename S::value_type;
+    return hash<std::basic_string_view<char_type>>{}(std::basic_string_view<char_type>(str));
+  }
+
+  template <typename CharT>
+  [[nodiscard]] constexpr auto
+  operator()(basic_prehashed_string_view<CharT> const& str) const noexcept -> std::size_t
+  {
+    return str.hash;
+  }
+};
+
+MTP_EXPORT struct equal_to
+{
+  using is_transparent = void;
+
+  template <typename CharT>
+  [[nodiscard]] static constexpr auto
+  as_view(basic_prehashed_string_view<CharT> const& str) noexcept -> std::basic_string_view<CharT>
+  {
+    return str.view;
+  }
+
+  template <concepts::string_view_like S>
+  [[nodiscard]] static constexpr auto
+  as_view(S const& str) noexcept -> std::basic_string_view<typename S::value_type>
+  {
+    return str;
+  }
+
+  template <typename L, typename R>
+  [[nodiscard]] constexpr auto
+  operator()(L const& lhs, R const& rhs) const noexcept -> bool
+  {
+    return as_view(lhs) == as_view(rhs);
+  }
+};
+
+MTP_EXPORT template <basic_fixed_string Str>
+inline constexpr std::size_t hash_v = hash<>{}(Str);
+
+MTP_EXPORT template <basic_fixed_string Str>
+inline constexpr auto prehashed_v =
+    basic_prehashed_string_view<typename decltype(Str)::value_type>{ Str.view(), hash_v<Str> };
+
+// -------------------------------------------------------------------------------------------------
+
+namespace detail {
+
+template <typename T>
+using fixed_string_char_t = typename std::remove_cvref_t<T>::value_type;
+
+template <typename... Ts>
+concept same_char_type =
+    (... && std::same_as<fixed_string_char_t<Ts>, std::common_type_t<fixed_string_char_t<Ts>...>>);
+
+template <basic_fixed_string... Strs>
+using pack_char_t = std::common_type_t<fixed_string_char_t<decltype(Strs)>...>;
+
+// hash-and-displace perfect hash: keys are split into buckets by one part of the hash and each
+// bucket gets a displacement `(d0, d1)` so that `(f1 + d0 * f2 + d1) % table_size` places all of
+// its keys into free slots
+template <std::size_t K>
+struct perfect_hash
+{
+  static constexpr std::size_t table_size = std::bit_ceil(K + K / 4 + 1);
+  static constexpr std::size_t bucket_count = std::bit_ceil(K / 2 + 1);
+  static_assert(table_size <= 0x1'0000, "too many keys");
+
+  std::uint64_t seed = 0;
+  std::array<std::uint32_t, bucket_count> displacement = {};
+  std::array<uint_least_t<K>, table_size> slot = {};
+
+  [[nodiscard]] static constexpr auto
+  bucket(std::uint64_t h) noexcept -> std::size_t
+  {
+    return static_cast<std::size_t>((h * 0x9e37'79b9'7f4a'7c15ull) >> 32) & (bucket_count - 1);
+  }
+
+  [[nodiscard]] static constexpr auto
+  place(std::uint64_t h, std::uint32_t displacement) noexcept -> std::size_t
+  {
+    auto const f1 = static_cast<std::uint32_t>(h);
+    auto const f2 = static_cast<std::uint32_t>(h >> 32) | 1u;
+    auto const d0 = displacement >> 16;
+    auto const d1 = displacement & 0xFFFFu;
+    return static_cast<std::size_t>(f1 + d0 * f2 + d1) & (table_size - 1);
+  }
+
+  // index of the only key that can hash to `h`; unused slots hold 0 so the lookup stays branchless
+  [[nodiscard]] constexpr auto
+  index(std::uint64_t h) const noexcept -> std::size_t
+  {
+    return slot[place(h, displacement[bucket(h)])];
+  }
+};
+
+inline auto
+perfect_hash_not_found() -> void
+{}
+
+template <typename CharT, std::size_t K>
+[[nodiscard]] consteval auto
+make_perfect_hash(std::array<std::basic_string_view<CharT>, K> const& keys) -> perfect_hash<K>
+{
+  using table = perfect_hash<K>;
+
+  for (std::uint64_t seed = 0; seed < 256; ++seed) {
+    auto hashes = std::array<std::uint64_t, K>{};
+    auto sizes = std::array<std::size_t, table::bucket_count>{};
+    for (std::size_t i = 0; i < K; ++i) {
+      hashes[i] = wyhash(keys[i].data(), keys[i].size(), seed);
+      ++sizes[table::bucket(hashes[i])];
+    }
+
+    // keys grouped by bucket, those of bucket `b` are `members[first[b]]` up to `first[b + 1]`
+    auto first = std::array<std::size_t, table::bucket_count + 1>{};
+    for (std::size_t b = 0; b < table::bucket_count; ++b) {
+      first[b + 1] = first[b] + sizes[b];
+    }
+    auto members = std::array<std::size_t, K>{};
+    auto next = first;
+    for (std::size_t i = 0; i < K; ++i) {
+      members[next[table::bucket(hashes[i])]++] = i;
+    }
+
+    // largest buckets first, they are the hardest to place
+    auto order = std::array<std::size_t, table::bucket_count>{};
+    for (std::size_t b = 0; b < table::bucket_count; ++b) {
+      order[b] = b;
+    }
+    std::ranges::sort(order, [&](auto lhs, auto rhs) {
+      return sizes[lhs] > sizes[rhs] || (sizes[lhs] == sizes[rhs] && lhs < rhs);
+    });
+
+    auto result = table{};
+    result.seed = seed;
+    auto taken = std::array<bool, table::table_size>{};
+    auto placed_all = true;
+
+    for (auto const b : order) {
+      if (sizes[b] == 0) {
+        break;
+      }
+
+      // keys of equal hash collide under every displacement, they are either the same key or the
+      // seed is a bad one. only these are compared, which keeps the check for duplicates cheap
+      auto distinct = true;
+      for (auto m = first[b]; m < first[b + 1]; ++m) {
+        for (auto n = m + 1; n < first[b + 1]; ++n) {
+          if (hashes[members[m]] == hashes[members[n]]) {
+            MTP_EXPECTS(keys[members[m]] != keys[members[n]]);
+            distinct = false;
+          }
+        }
+      }
+
+      // slots are marked as they are tried and given back when a later key of the bucket collides,
+      // so a try costs the size of the bucket rather than a copy of the table
+      auto placed = false;
+      for (std::size_t d = 0; distinct && d < table::table_size * table::table_size && !placed;
+           ++d) {
+        auto const displacement =
+            static_cast<std::uint32_t>(((d / table::table_size) << 16) | (d % table::table_size));
+        auto m = first[b];
+        for (; m < first[b + 1]; ++m) {
+          auto const s = table::place(hashes[members[m]], displacement);
+          if (taken[s]) {
+            break;
+          }
+          taken[s] = true;
+        }
+        placed = m == first[b + 1];
+        if (placed) {
+          result.displacement[b] = displacement;
+        }
+        else {
+          for (auto r = first[b]; r < m; ++r) {
+            taken[table::place(hashes[members[r]], displacement)] = false;
+          }
+        }
+      }
+
+      if (!placed) {
+        placed_all = false;
+        break;
+      }
+    }
+
+    if (placed_all) {
+      for (std::size_t i = 0; i < K; ++i) {
+        result.slot[table::place(hashes[i], result.displacement[table::bucket(hashes[i])])] =
+            static_cast<uint_least_t<K>>(i);
+      }
+      return result;
+    }
+  }
+
+  perfect_hash_not_found();
+  return perfect_hash<K>{};
+}
+
+} // namespace detail
+
+MTP_EXPORT template <typename V, basic_fixed_string... Keys>
+  requires(sizeof...(Keys) > 0 && detail::same_char_type<decltype(Keys)...>)
+class static_map
+{
+public:
+  using char_type = detail::pack_char_t<Keys...>;
+  using key_type = std::basic_string_view<char_type>;
+  using mapped_type = V;
+  using size_type = std::size_t;
+
+  static constexpr size_type npos = static_cast<size_type>(-1);
+  static constexpr std::integral_constant<size_type, sizeof...(Keys)> size{};
+
+private:
+  static constexpr std::array<key_type, size()> _keys = { Keys.view()... };
+  static constexpr auto _table = detail::make_perfect_hash(_keys);
+
+  std::array<V, size()> _values = {};
+
+public:
+  [[nodiscard]] constexpr static_map() = default;
+
+  template <std::convertible_to<V>... Vs>
+    requires(sizeof...(Vs) == size())
+  [[nodiscard]] explicit constexpr static_map(Vs&&... values) noexcept(
+      (... && std::is_nothrow_constructible_v<V, Vs&&>))
+      : _values{ static_cast<V>(std::forward<Vs>(values))... }
+  {}
+
+  [[nodiscard]] static constexpr auto
+  keys() noexcept -> std::array<key_type, size()> const&
+  {
+    return _keys;
+  }
+
+  [[nodiscard]] constexpr auto
+  values() const noexcept -> std::array<V, size()> const&
+  {
+    return _values;
+  }
+
+  [[nodiscard]] constexpr auto
+  values() noexcept -> std::array<V, size()>&
+  {
+    return _values;
+  }
+
+  // position of `key` in `Keys...`, or `npos`
+  [[nodiscard]] static constexpr auto
+  index_of(key_type key) noexcept -> size_type
+  {
+    auto const i = _table.index(detail::wyhash(key.data(), key.size(), _table.seed));
+    return _keys[i] == key ? i : npos;
+  }
+
+  [[nodiscard]] static constexpr auto
+  contains(key_type key) noexcept -> bool
+  {
+    return index_of(key) != npos;
+  }
+
+  [[nodiscard]] constexpr auto
+  find(key_type key) const noexcept -> V const*
+  {
+    auto const i = index_of(key);
+    return i == npos ? nullptr : &_values[i];
+  }
+
+  [[nodiscard]] constexpr auto
+  find(key_type key) noexcept -> V*
+  {
+    auto const i = index_of(key);
+    return i == npos ? nullptr : &_values[i];
+  }
+
+  [[nodiscard]] constexpr auto
+  at(key_type key) const MTP_NOEXCEPT -> V const&
+  {
+    auto const i = index_of(key);
+#ifdef MTP_NO_EXCEPTIONS
+    MTP_EXPECTS(i != npos);
+#else
+    if (i == npos) {
+      throw std::out_of_range("mtp::static_map::at");
+    }
+#endif
+    return _values[i];
+  }
+
+  [[nodiscard]] constexpr auto
+  at(key_type key) MTP_NOEXCEPT -> V&
+  {
+    return const_cast<V&>(static_cast<static_map const&>(*this).at(key));
+  }
+
+  // lookup of a key known at compile time, no hashing at run time
+  template <basic_fixed_string Key>
+  [[nodiscard]] constexpr auto
+  get() const noexcept -> V const&
+  {
+    constexpr auto i = index_of(Key.view());
+    static_assert(i != npos, "key not in map");
+    return _values[i];
+  }
+
+  template <basic_fixed_string Key>
+  [[nodiscard]] constexpr auto
+  get() noexcept -> V&
+  {
+    constexpr auto i = index_of(Key.view());
+    static_assert(i != npos, "key not in map");
+    return _values[i];
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+
+namespace detail {
+
+template <basic_fixed_string... Strs>
+inline constexpr std::array<std::basic_string_view<pack_char_t<Strs...>>, sizeof...(Strs)>
+    views_v = { Strs.view()... };
+
+// decision tree over a set of strings: the length selects a root, every node inspects the one
+// character position that best splits the strings left in it and leaves hold the index of the only
+// string that can still match
+template <typename CharT, std::size_t K, std::size_t MaxLength>
+struct switch_table
+{
+  static constexpr std::uint32_t leaf = 0x8000'0000u;
+  static constexpr std::uint32_t none = 0xFFFF'FFFFu;
+
+  struct node
+  {
+    std::size_t pos = 0;
+    std::size_t first = 0;
+    std::size_t count = 0;
+  };
+
+  struct edge
+  {
+    CharT ch = {};
+    std::uint32_t target = none;
+  };
+
+  std::array<std::uint32_t, MaxLength + 1> root = {};
+  std::array<node, K> nodes = {};
+  std::array<edge, 2 * K> edges = {};
+  std::size_t node_count = 0;
+  std::size_t edge_count = 0;
+
+  // index of the matching string, or `K`
+  [[nodiscard]] constexpr auto
+  find(std::basic_string_view<CharT> sv,
+       std::array<std::basic_string_view<CharT>, K> const& strs) const noexcept -> std::size_t
+  {
+    auto const i = candidate(sv);
+    return i != K && std::char_traits<CharT>::compare(sv.data(), strs[i].data(), sv.size()) == 0
+               ? i
+               : K;
+  }
+
+  // index of the only string of the length of `sv` that has its characters at the positions the
+  // tree inspects, or `K`
+  [[nodiscard]] constexpr auto
+  candidate(std::basic_string_view<CharT> sv) const noexcept -> std::size_t
+  {
+    if (sv.size() > MaxLength) {
+      return K;
+    }
+
+    auto target = root[sv.size()];
+    if (target == none) {
+      return K;
+    }
+
+    while ((target & leaf) == 0) {
+      auto const& n = nodes[target];
+      auto const ch = sv[n.pos];
+      auto lo = n.first;
+      auto hi = n.first + n.count;
+      while (lo < hi) {
+        auto const mid = lo + (hi - lo) / 2;
+        if (edges[mid].ch < ch) {
+          lo = mid + 1;
+        }
+        else {
+          hi = mid;
+        }
+      }
+      if (lo == n.first + n.count || edges[lo].ch != ch) {
+        return K;
+      }
+      target = edges[lo].target;
+    }
+
+    return static_cast<std::size_t>(target & ~leaf);
+  }
+
+  // builds the subtree of the strings `order[first, last)`, all of the same length, and reorders
+  // that range. sorted by the character at a position, the strings sharing it are a run, so the
+  // distinct characters are counted without a search and every child is a subrange
+  constexpr auto
+  add(std::array<std::basic_string_view<CharT>, K> const& strs, std::array<std::size_t, K>& order,
+      std::size_t first, std::size_t last) -> std::uint32_t
+  {
+    if (last - first == 1) {
+      return leaf | static_cast<std::uint32_t>(order[first]);
+    }
+
+    auto const sort_at = [&](std::size_t pos) {
+      std::ranges::sort(order.begin() + first, order.begin() + last, {},
+                        [&](std::size_t i) { return strs[i][pos]; });
+    };
+    auto const runs = [&](std::size_t pos) {
+      auto count = std::size_t{ 1 };
+      for (std::size_t i = first + 1; i < last; ++i) {
+        count += strs[order[i]][pos] != strs[order[i - 1]][pos];
+      }
+      return count;
+    };
+
+    // most distinct characters in one position, ties to the lowest position
+    auto const length = strs[order[first]].size();
+    auto best_pos = std::size_t{};
+    auto best_count = std::size_t{};
+    for (std::size_t pos = 0; pos < length; ++pos) {
+      sort_at(pos);
+      if (auto const distinct = runs(pos); distinct > best_count) {
+        best_pos = pos;
+        best_count = distinct;
+      }
+    }
+    sort_at(best_pos);
+
+    auto const index = node_count++;
+    nodes[index] = node{ best_pos, edge_count, best_count };
+    edge_count += best_count;
+
+    // a child reorders only its own run, which keeps its character at `best_pos`
+    auto begin = first;
+    for (std::size_t c = 0; c < best_count; ++c) {
+      auto const ch = strs[order[begin]][best_pos];
+      auto end = begin + 1;
+      while (end < last && strs[order[end]][best_pos] == ch) {
+        ++end;
+      }
+      auto const target = add(strs, order, begin, end);
+      edges[nodes[index].first + c] = edge{ ch, target };
+      begin = end;
+    }
+    return static_cast<std::uint32_t>(index);
+  }
+};
+
+// the strings are sorted once by length and then contents: duplicates are neighbours and the
+// strings of one length are a range, the root of its subtree
+template <typename CharT, std::size_t K, std::size_t MaxLength>
+[[nodiscard]] consteval auto
+make_switch_table(std::array<std::basic_string_view<CharT>, K> const& strs)
+    -> switch_table<CharT, K, MaxLength>
+{
+  auto table = switch_table<CharT, K, MaxLength>{};
+  table.root.fill(table.none);
+
+  auto order = std::array<std::size_t, K>{};
+  for (std::size_t i = 0; i < K; ++i) {
+    order[i] = i;
+  }
+  std::ranges::sort(order, [&](std::size_t i, std::size_t j) {
+    return strs[i].size() != strs[j].size() ? strs[i].size() < strs[j].size() : strs[i] < strs[j];
+  });
+
+  for (std::size_t i = 1; i < K; ++i) {
+    MTP_EXPECTS(strs[order[i]] != strs[order[i - 1]]);
+  }
+
+  for (std::size_t first = 0; first < K;) {
+    auto const length = strs[order[first]].size();
+    auto last = first + 1;
+    while (last < K && strs[order[last]].size() == length) {
+      ++last;
+    }
+    table.root[length] = table.add(strs, order, first, last);
+    first = last;
+  }
+  return table;
+}
+
+template <basic_fixed_string... Strs>
+inline constexpr auto switch_table_v =
+    make_switch_table<pack_char_t<Strs...>, sizeof...(Strs), std::max({ Strs.size()... })>(
+        views_v<Strs...>);
+
+// a single fold rather than recursion keeps this to one instantiation for any number of handlers,
+// the chain of comparisons against `index` is lowered to a jump table by the compiler
+template <typename R, std::size_t... Is, typename... Fs>
+constexpr auto
+invoke_nth_handler(std::size_t index, std::index_sequence<Is...>, Fs&... handlers) -> R
+{
+  if constexpr (std::is_void_v<R>) {
+    static_cast<void>((... || (index == Is && (static_cast<void>(handlers()), true))));
+  }
+  else if constexpr (std::is_reference_v<R>) {
+    // a reference result is carried by its address, `std::optional` holds no references
+    constexpr auto last = sizeof...(Is) - 1;
+    auto const address = [](auto&& ref) noexcept { return std::addressof(ref); };
+    auto result = static_cast<std::remove_reference_t<R>*>(nullptr);
+    static_cast<void>((... || ((Is == last || index == Is)
+                               && (result = address(static_cast<R>(handlers())), true))));
+    return static_cast<R>(*result);
+  }
+  else {
+    // the last handler is the default one and catches every index not matched before it
+    constexpr auto last = sizeof...(Is) - 1;
+    auto result = std::optional<R>{};
+    static_cast<void>(
+        (... || ((Is == last || index == Is) && (result.emplace(handlers()), true))));
+    return *std::move(result);
+  }
+}
+
+} // namespace detail
+
+// index of the case equal to `sv`, or `sizeof...(Cases)` if there is none
+MTP_EXPORT template <basic_fixed_string... Cases>
+  requires(sizeof...(Cases) > 0 && detail::same_char_type<decltype(Cases)...>)
+[[nodiscard]] constexpr auto
+string_switch_index(std::basic_string_view<detail::pack_char_t<Cases...>> sv) noexcept
+    -> std::size_t
+{
+  return detail::switch_table_v<Cases...>.find(sv, detail::views_v<Cases...>);
+}
+
+// calls the handler at the position of the case equal to `sv`, or the optional trailing default
+// handler if there is none. handlers returning references to a common type return one
+MTP_EXPORT template <basic_fixed_string... Cases, typename... Fs>
+  requires(sizeof...(Cases) > 0 && detail::same_char_type<decltype(Cases)...>
+           && (sizeof...(Fs) == sizeof...(Cases) || sizeof...(Fs) == sizeof...(Cases) + 1)
+           && (... && std::invocable<Fs&>))
+constexpr auto
+string_switch(std::basic_string_view<detail::pack_char_t<Cases...>> sv, Fs&&... handlers)
+    -> std::common_reference_t<std::invoke_result_t<Fs&>...>
+{
+  using result = std::common_reference_t<std::invoke_result_t<Fs&>...>;
+  static_assert(sizeof...(Fs) > sizeof...(Cases) || std::is_void_v<result>,
+                "a default handler is required when handlers return a value");
+
+  auto const index = string_switch_index<Cases...>(sv);
+
+  if constexpr (sizeof...(Fs) == sizeof...(Cases)) {
+    if (index == sizeof...(Cases)) {
+      return;
+    }
+  }
+  return detail::invoke_nth_handler<result>(index, std::index_sequence_for<Fs...>{}, handlers...);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+// names of enumerators, both ways. `enum_names<E, Names...>` names the value `i` of `E` by the
+// `i`-th name and `flag_names<E, Names...>` the value `1 << i`, an empty name leaves its value
+// unnamed. the names are stored back to back in one character array with their offsets next to
+// it, so the table holds no pointers (and needs no relocations) and naming a value is two loads.
+// names are looked up through the decision tree of `string_switch`
+
+namespace detail {
+
+template <basic_fixed_string... Names>
+struct enum_name_table
+{
+  using char_type = pack_char_t<Names...>;
+  using view_type = std::basic_string_view<char_type>;
+
+  static constexpr std::size_t count = sizeof...(Names);
+  static constexpr std::size_t total = (std::size_t{ 0 } + ... + Names.size());
+  static constexpr std::size_t named = (std::size_t{ 0 } + ... + (Names.size() > 0 ? 1 : 0));
+
+  // all names back to back, the `i`-th from `offsets[i]` to `offsets[i + 1]`
+  static constexpr auto chars = [] {
+    auto result = std::array<char_type, total>{};
+    auto* out = result.data();
+    static_cast<void>((..., (out = std::ranges::copy(Names, out).out)));
+    return result;
+  }();
+
+  static constexpr auto offsets = [] {
+    auto result = std::array<uint_least_t<total>, count + 1>{};
+    auto const sizes = std::array<std::size_t, count>{ Names.size()... };
+    for (std::size_t i = 0; i < count; ++i) {
+      result[i + 1] = static_cast<uint_least_t<total>>(result[i] + sizes[i]);
+    }
+    return result;
+  }();
+
+  // the positions of the non-empty names and a decision tree over them, which keeps no pointers
+  // either: its candidate is checked against `chars`
+  static constexpr auto named_index = [] {
+    auto result = std::array<uint_least_t<count>, named>{};
+    auto const& views = views_v<Names...>;
+    for (std::size_t i = 0, j = 0; i < count; ++i) {
+      if (!views[i].empty()) {
+        result[j++] = static_cast<uint_least_t<count>>(i);
+      }
+    }
+    return result;
+  }();
+
+  static constexpr auto tree = []() consteval {
+    auto views = std::array<view_type, named>{};
+    for (std::size_t j = 0; j < named; ++j) {
+      views[j] = views_v<Names...>[named_index[j]];
+    }
+    return make_switch_table<char_type, named, std::max({ Names.size()... })>(views);
+  }();
+
+  [[nodiscard]] static constexpr auto
+  name(std::size_t i) noexcept -> view_type
+  {
+    MTP_EXPECTS(i < count);
+    return { chars.data() + offsets[i], static_cast<std::size_t>(offsets[i + 1] - offsets[i]) };
+  }
+
+  // position of `name`, or `count`
+  [[nodiscard]] static constexpr auto
+  index_of(view_type name) noexcept -> std::size_t
+  {
+    if constexpr (named == 0) {
+      return count;
+    }
+    else {
+      auto const j = tree.candidate(name);
+      if (j == named) {
+        return count;
+      }
+      auto const i = std::size_t{ named_index[j] };
+      return enum_name_table::name(i) == name ? i : count;
+    }
+  }
+};
+
+template <typename E>
+using enum_bits_t = std::make_unsigned_t<std::underlying_type_t<E>>;
+
+template <typename E>
+[[nodiscard]] constexpr auto
+enum_bits(E value) noexcept -> enum_bits_t<E>
+{
+  return static_cast<enum_bits_t<E>>(value);
+}
+
+} // namespace detail
+
+MTP_EXPORT template <typename E, basic_fixed_string... Names>
+  requires(std::is_enum_v<E> && sizeof...(Names) > 0
+           && detail::same_char_type<decltype(Names)...>)
+class enum_names
+{
+  using table = detail::enum_name_table<Names...>;
+
+public:
+  using enum_type = E;
+  using char_type = typename table::char_type;
+
+  static constexpr std::integral_constant<std::size_t, sizeof...(Names)> size{};
+
+  // the name of `value`, empty if it has none
+  [[nodiscard]] static constexpr auto
+  name(E value) noexcept -> std::basic_string_view<char_type>
+  {
+    auto const i = detail::enum_bits(value);
+    return i < size() ? table::name(i) : std::basic_string_view<char_type>{};
+  }
+
+  // the value named `name`
+  [[nodiscard]] static constexpr auto
+  value(std::basic_string_view<char_type> name) noexcept -> std::optional<E>
+  {
+    auto const i = table::index_of(name);
+    return i == size() ? std::nullopt : std::optional{ static_cast<E>(i) };
+  }
+};
+
+MTP_EXPORT template <typename E, basic_fixed_string... Names>
+  requires(std::is_enum_v<E> && sizeof...(Names) > 0
+           && sizeof...(Names) <= std::numeric_limits<detail::enum_bits_t<E>>::digits
+           && detail::same_char_type<decltype(Names)...>)
+class flag_names
+{
+  using table = detail::enum_name_table<Names...>;
+  using bits_type = detail::enum_bits_t<E>;
+
+public:
+  using enum_type = E;
+  using char_type = typename table::char_type;
+
+  static constexpr std::integral_constant<std::size_t, sizeof...(Names)> size{};
+
+  // the name of a single flag, empty if it has none
+  [[nodiscard]] static constexpr auto
+  name(E flag) noexcept -> std::basic_string_view<char_type>
+  {
+    auto const bits = detail::enum_bits(flag);
+    if (!std::has_single_bit(bits)) {
+      return {};
+    }
+    auto const i = static_cast<std::size_t>(std::countr_zero(bits));
+    return i < size() ? table::name(i) : std::basic_string_view<char_type>{};
+  }
+
+  // the flag named `name`
+  [[nodiscard]] static constexpr auto
+  value(std::basic_string_view<char_type> name) noexcept -> std::optional<E>
+  {
+    auto const i = table::index_of(name);
+    return i == size() ? std::nullopt : std::optional{ static_cast<E>(bits_type{ 1 } << i) };
+  }
+
+  // the names of the flags set in `value` from the lowest, joined by `Separator`. bits without a
+  // name end the string as one hexadecimal number, `0x...`, and no flags at all are empty
+  template <char_type Separator = char_type{ '|' }>
+  [[nodiscard]] static constexpr auto
+  format(E value) noexcept
+  {
+    constexpr auto digits = std::numeric_limits<bits_type>::digits / 4;
+    constexpr auto capacity = table::total + size() + 2 + digits;
+    auto result = basic_inplace_string<char_type, capacity>{};
+    result.resize_and_overwrite(capacity, [value](char_type* first, std::size_t) {
+      auto* out = first;
+      auto const separate = [&] {
+        if (out != first) {
+          *out++ = Separator;
+        }
+      };
+      auto unnamed = bits_type{ 0 };
+      for (auto bits = detail::enum_bits(value); bits != 0;
+           bits &= static_cast<bits_type>(bits - 1)) {
+        auto const i = static_cast<std::size_t>(std::countr_zero(bits));
+        auto const name = i < size() ? table::name(i) : std::basic_string_view<char_type>{};
+        if (name.empty()) {
+          unnamed |= static_cast<bits_type>(bits_type{ 1 } << i);
+          continue;
+        }
+        separate();
+        out = std::ranges::copy(name, out).out;
+      }
+      if (unnamed != 0) {
+        separate();
+        *out++ = char_type{ '0' };
+        *out++ = char_type{ 'x' };
+        for (auto d = (std::bit_width(unnamed) + 3) / 4; d-- > 0;) {
+          *out++ = static_cast<char_type>("0123456789abcdef"[unnamed >> (4 * d) & 15]);
+        }
+      }
+      return static_cast<std::size_t>(out - first);
+    });
+    return result;
+  }
+
+  // the flags named in `str` between `Separator`s, as `format` writes them but without numbers
+  template <char_type Separator = char_type{ '|' }>
+  [[nodiscard]] static constexpr auto
+  parse(std::basic_string_view<char_type> str) noexcept -> std::optional<E>
+  {
+    auto bits = bits_type{ 0 };
+    if (str.empty()) {
+      return static_cast<E>(bits);
+    }
+    for (;;) {
+      auto const end = str.find(Separator);
+      auto const i = table::index_of(str.substr(0, end));
+      if (i == size()) {
+        return std::nullopt;
+      }
+      bits |= static_cast<bits_type>(bits_type{ 1 } << i);
+      if (end == str.npos) {
+        return static_cast<E>(bits);
+      }
+      str.remove_prefix(end + 1);
+    }
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+
+// searching for many needles known at compile time in one pass. the needles are compiled into an
+// aho-corasick automaton, a dfa over classes of the characters occurring in them, so every input
+// character costs one table lookup whatever the number of needles. states where a needle ends are
+// numbered last, so a transition into one is found by a single comparison. from the start state
+// the input is skipped to the next character that begins a needle, with vectors where there are
+// any. the state is carried from one buffer to the next, so needles split across chunks are found
+
+namespace detail {
+
+// the distinct characters of the needles in code unit order, class `i + 1` stands for the `i`th of
+// them and class 0 for every other character
+template <typename CharT, std::size_t K>
+[[nodiscard]] constexpr auto
+multi_search_units(std::array<std::basic_string_view<CharT>, K> const& needles, std::size_t* out)
+    -> std::size_t
+{
+  auto count = std::size_t{ 0 };
+  auto const insert = [&](std::size_t unit) {
+    auto i = count;
+    for (; i > 0 && out[i - 1] >= unit; --i) {
+      if (out[i - 1] == unit) {
+        return;
+      }
+    }
+    for (auto j = count; j > i; --j) {
+      out[j] = out[j - 1];
+    }
+    out[i] = unit;
+    ++count;
+  };
+  for (auto const& needle : needles) {
+    for (auto const ch : needle) {
+      insert(code_unit(ch));
+    }
+  }
+  return count;
+}
+
+// states of the trie of the needles, one per distinct prefix
+template <typename CharT, std::size_t K>
+[[nodiscard]] constexpr auto
+multi_search_state_count(std::array<std::basic_string_view<CharT>, K> const& needles) noexcept
+    -> std::size_t
+{
+  auto count = std::size_t{ 1 };
+  for (std::size_t i = 0; i < K; ++i) {
+    for (std::size_t length = 1; length <= needles[i].size(); ++length) {
+      auto seen = false;
+      for (std::size_t j = 0; j < i && !seen; ++j) {
+        seen = needles[j].size() >= length
+               && needles[j].substr(0, length) == needles[i].substr(0, length);
+      }
+      count += seen ? 0 : 1;
+    }
+  }
+  return count;
+}
+
+template <typename CharT, std::size_t K, std::size_t States, std::size_t Classes>
+struct multi_search_automaton
+{
+  // transitions hold the row of their target, `state * Classes`
+  using row_type = uint_least_t<States * Classes>;
+
+  std::array<std::size_t, Classes - 1> units = {};
+  std::array<uint_least_t<Classes>, 256> byte_class = {};
+  std::array<row_type, States * Classes> next = {};
+  // the needle ending in a state and the next state along its suffix links in which one ends,
+  // 0 when there is none
+  std::array<std::size_t, States> output = {};
+  std::array<std::size_t, States> dict = {};
+  std::array<std::size_t, K> lengths = {};
+  // rows from this one on belong to states where a needle ends
+  row_type first_output_row = 0;
+
+  // the distinct first three characters of the needles (fewer if a needle is shorter), for skipping
+  // ahead from the start state
+  std::size_t prefix_length = 0;
+  std::array<std::array<unsigned char, 3>, K> prefixes = {};
+  std::size_t prefix_count = 0;
+  // bytes `b0 b1` may begin a needle iff `low[0][b0 & 15] & high[0][b0 >> 4] & low[1][b1 & 15]
+  // & high[1][b1 >> 4]` is not zero, each bit standing for a bucket of prefixes
+  std::array<std::array<unsigned char, 16>, 2> low_nibbles = {};
+  std::array<std::array<unsigned char, 16>, 2> high_nibbles = {};
+
+  [[nodiscard]] constexpr auto
+  class_of(CharT ch) const noexcept -> std::size_t
+  {
+    auto const unit = code_unit(ch);
+    if (unit < 256) {
+      return byte_class[unit];
+    }
+    // wide characters are looked up among the units past the byte ones
+    auto const* const first = units.data();
+    auto const* const last = units.data() + units.size();
+    auto const* const it = std::lower_bound(first, last, unit);
+    return it != last && *it == unit ? static_cast<std::size_t>(it - first) + 1 : 0;
+  }
+};
+
+template <typename CharT, std::size_t K, std::size_t States, std::size_t Classes>
+[[nodiscard]] constexpr auto
+make_multi_search(std::array<std::basic_string_view<CharT>, K> const& needles)
+    -> multi_search_automaton<CharT, K, States, Classes>
+{
+  using automaton = multi_search_automaton<CharT, K, States, Classes>;
+  auto result = automaton{};
+
+  auto units = std::array<std::size_t, Classes>{};
+  static_cast<void>(multi_search_units(needles, units.data()));
+  for (std::size_t c = 0; c + 1 < Classes; ++c) {
+    result.units[c] = units[c];
+    if (units[c] < 256) {
+      result.byte_class[units[c]] = static_cast<uint_least_t<Classes>>(c + 1);
+    }
+  }
+
+  // the trie, `none` marking missing transitions
+  constexpr auto none = States;
+  auto next = std::array<std::size_t, States * Classes>{};
+  next.fill(none);
+  auto output = std::array<std::size_t, States>{};
+  output.fill(npos);
+  auto state_count = std::size_t{ 1 };
+  for (std::size_t i = 0; i < K; ++i) {
+    auto state = std::size_t{ 0 };
+    for (auto const ch : needles[i]) {
+      auto& to = next[state * Classes + result.class_of(ch)];
+      if (to == none) {
+        to = state_count++;
+      }
+      state = to;
+    }
+    // a needle given twice is reported at its first position
+    if (output[state] == npos) {
+      output[state] = i;
+    }
+    result.lengths[i] = needles[i].size();
+  }
+
+  // breadth first, so that the failure target of every state is complete before the state is
+  auto fail = std::array<std::size_t, States>{};
+  auto dict = std::array<std::size_t, States>{};
+  auto queue = std::array<std::size_t, States>{};
+  auto head = std::size_t{ 0 };
+  auto tail = std::size_t{ 0 };
+  for (std::size_t c = 0; c < Classes; ++c) {
+    if (next[c] == none) {
+      next[c] = 0;
+    }
+    else {
+      queue[tail++] = next[c];
+    }
+  }
+  while (head < tail) {
+    auto const state = queue[head++];
+    for (std::size_t c = 0; c < Classes; ++c) {
+      auto& to = next[state * Classes + c];
+      if (to == none) {
+        to = next[fail[state] * Classes + c];
+        continue;
+      }
+      fail[to] = next[fail[state] * Classes + c];
+      dict[to] = output[fail[to]] != npos ? fail[to] : dict[fail[to]];
+      queue[tail++] = to;
+    }
+  }
+
+  // states without output first, starting with the start state
+  auto order = std::array<std::size_t, States>{};
+  auto const reports = [&](std::size_t state) { return output[state] != npos || dict[state] != 0; };
+  auto position = std::size_t{ 0 };
+  for (auto const last : { false, true }) {
+    for (std::size_t state = 0; state < States; ++state) {
+      if (reports(state) == last) {
+        order[state] = position++;
+      }
+    }
+    if (!last) {
+      result.first_output_row = static_cast<typename automaton::row_type>(position * Classes);
+    }
+  }
+  for (std::size_t state = 0; state < States; ++state) {
+    for (std::size_t c = 0; c < Classes; ++c) {
+      result.next[order[state] * Classes + c] =
+          static_cast<typename automaton::row_type>(order[next[state * Classes + c]] * Classes);
+    }
+    result.output[order[state]] = output[state];
+    result.dict[order[state]] = dict[state] == 0 ? 0 : order[dict[state]];
+  }
+
+  if constexpr (sizeof(CharT) == 1) {
+    result.prefix_length = 3;
+    for (auto const needle : needles) {
+      result.prefix_length = std::min(result.prefix_length, needle.size());
+    }
+    for (auto const needle : needles) {
+      auto prefix = std::array<unsigned char, 3>{};
+      for (std::size_t j = 0; j < result.prefix_length; ++j) {
+        prefix[j] = static_cast<unsigned char>(needle[j]);
+      }
+      auto const last = result.prefixes.begin() + result.prefix_count;
+      if (std::find(result.prefixes.begin(), last, prefix) == last) {
+        result.prefixes[result.prefix_count++] = prefix;
+      }
+    }
+    // one bucket per prefix, by its first two characters, prefixes past the eighth share buckets.
+    // a single character prefix lets any second byte through
+    for (std::size_t i = 0; i < result.prefix_count; ++i) {
+      auto const bit = static_cast<unsigned char>(1u << (i % 8));
+      for (std::size_t j = 0; j < 2; ++j) {
+        if (j < result.prefix_length) {
+          result.low_nibbles[j][result.prefixes[i][j] & 15] |= bit;
+          result.high_nibbles[j][result.prefixes[i][j] >> 4] |= bit;
+        }
+        else {
+          result.low_nibbles[j].fill(0xFF);
+          result.high_nibbles[j].fill(0xFF);
+        }
+      }
+    }
+  }
+  return result;
+}
+
+template <basic_fixed_string... Needles>
+inline constexpr auto multi_search_v = [] {
+  using char_type = pack_char_t<Needles...>;
+  constexpr auto classes = [] {
+    auto units = std::array<std::size_t, (Needles.size() + ...)>{};
+    return multi_search_units(views_v<Needles...>, units.data()) + 1;
+  }();
+  constexpr auto states = multi_search_state_count(views_v<Needles...>);
+  return make_multi_search<char_type, sizeof...(Needles), states, classes>(views_v<Needles...>);
+}();
+
+} // namespace detail
+
+// an occurrence of the needle at index `needle` of a `multi_search`, starting at `offset` (counted
+// from the start of the stream)
+MTP_EXPORT struct multi_match
+{
+  std::size_t needle = 0;
+  std::size_t offset = 0;
+
+  [[nodiscard]] friend constexpr auto
+  operator==(multi_match const&, multi_match const&) noexcept -> bool = default;
+};
+
+// reports every occurrence of any of `Needles`, overlapping ones included, in the order in which
+// they end (the longest first among those ending together). the handlers are called with a
+// `multi_match` and stop the scan by returning `false`, `feed` scans a stream chunk by chunk
+MTP_EXPORT template <basic_fixed_string... Needles>
+  requires(sizeof...(Needles) > 0 && detail::same_char_type<decltype(Needles)...>
+           && (... && (Needles.size() > 0)))
+class multi_search
+{
+public:
+  using char_type = detail::pack_char_t<Needles...>;
+  using size_type = std::size_t;
+
+  static constexpr std::integral_constant<size_type, sizeof...(Needles)> size{};
+
+  // every occurrence in `text`, from the start state
+  template <typename F>
+    requires(std::invocable<F&, multi_match>)
+  static constexpr auto
+  for_each(std::basic_string_view<char_type> text, F&& handler) -> void
+  {
+    auto search = multi_search{};
+    search.feed(text, handler);
+  }
+
+  // the occurrence in `text` that ends first
+  [[nodiscard]] static constexpr auto
+  find(std::basic_string_view<char_type> text) noexcept -> std::optional<multi_match>
+  {
+    auto found = std::optional<multi_match>{};
+    for_each(text, [&](multi_match const& match) {
+      found = match;
+      return false;
+    });
+    return found;
+  }
+
+  [[nodiscard]] static constexpr auto
+  contains(std::basic_string_view<char_type> text) noexcept -> bool
+  {
+    return find(text).has_value();
+  }
+
+  // continues the scan with the next chunk of a stream, returns `false` if a handler stopped it
+  template <typename F>
+    requires(std::invocable<F&, multi_match>)
+  constexpr auto
+  feed(std::basic_string_view<char_type> chunk, F&& handler) -> bool
+  {
+    auto const* const text = chunk.data();
+    auto const count = chunk.size();
+    auto row = _row;
+    for (size_type i = 0; i < count; ++i) {
+      if (row == 0) {
+        i = skip(text, i, count);
+        if (i == count) {
+          break;
+        }
+      }
+      row = automaton.next[row + automaton.class_of(text[i])];
+      if (row >= automaton.first_output_row) [[unlikely]] {
+        if (!report(row / classes, _consumed + i + 1, handler)) {
+          _row = row;
+          _consumed += i + 1;
+          return false;
+        }
+      }
+    }
+    _row = row;
+    _consumed += count;
+    return true;
+  }
+
+  // back to the start of a stream
+  constexpr auto
+  reset() noexcept -> void
+  {
+    _row = 0;
+    _consumed = 0;
+  }
+
+  // characters fed so far
+  [[nodiscard]] constexpr auto
+  consumed() const noexcept -> size_type
+  {
+    return _consumed;
+  }
+
+private:
+  static constexpr auto const& automaton = detail::multi_search_v<Needles...>;
+  static constexpr size_type classes = automaton.units.size() + 1;
+
+  typename std::remove_cvref_t<decltype(automaton)>::row_type _row = 0;
+  size_type _consumed = 0;
+
+  // calls the handler for every needle ending at `end` in `state`
+  template <typename F>
+  static constexpr auto
+  report(size_type state, size_type end, F& handler) -> bool
+  {
+    auto at = automaton.output[state] != detail::npos ? state : automaton.dict[state];
+    for (; at != 0; at = automaton.dict[at]) {
+      auto const index = automaton.output[at];
+      auto const match = multi_match{ index, end - automaton.lengths[index] };
+      if constexpr (std::is_void_v<std::invoke_result_t<F&, multi_match>>) {
+        handler(match);
+      }
+      else if (!handler(match)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // the first position from `i` on whose characters may begin a needle, or a position before it
+  [[nodiscard]] static constexpr auto
+  skip(char_type const* text, size_type i, [[maybe_unused]] size_type count) noexcept -> size_type
+  {
+    if (std::is_constant_evaluated()) {
+      return i;
+    }
+    if constexpr (sizeof(char_type) == 1) {
+      [[maybe_unused]] auto const* const bytes = reinterpret_cast<unsigned char const*>(text);
+#ifdef MTP_HAS_AVX2
+      if constexpr (automaton.prefix_count <= 8) {
+        return skip_buckets(bytes, i, count);
+      }
+      else {
+        return skip_prefixes(bytes, i, count);
+      }
+#elif defined(MTP_HAS_SSE2)
+      return skip_prefixes(bytes, i, count);
+#endif
+    }
+    return i;
+  }
+
+#ifdef MTP_HAS_AVX2
+  // up to eight prefixes have a bucket each, so the nibble tables test the first two bytes exactly.
+  // past that the shared buckets let through so many positions that comparing the prefixes wins
+  [[nodiscard]] static auto
+  skip_buckets(unsigned char const* bytes, size_type i, size_type count) noexcept -> size_type
+  {
+    auto const table = [](std::array<unsigned char, 16> const& nibbles) {
+      return _mm256_broadcastsi128_si256(
+          _mm_loadu_si128(reinterpret_cast<__m128i const*>(nibbles.data())));
+    };
+    auto const nibble = _mm256_set1_epi8(0x0F);
+    auto const buckets = [&](unsigned char const* ptr, std::size_t j) {
+      auto const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(ptr));
+      auto const lo =
+          _mm256_shuffle_epi8(table(automaton.low_nibbles[j]), _mm256_and_si256(v, nibble));
+      auto const hi = _mm256_shuffle_epi8(table(automaton.high_nibbles[j]),
+                                          _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+      return _mm256_and_si256(lo, hi);
+    };
+    // the second byte is read one past the chunk even for single character prefixes
+    for (; i + 33 <= count; i += 32) {
+      auto const both = _mm256_and_si256(buckets(bytes + i, 0), buckets(bytes + i + 1, 1));
+      auto const none = _mm256_cmpeq_epi8(both, _mm256_setzero_si256());
+      if (auto const mask = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(none)); mask != 0) {
+        return i + static_cast<size_type>(std::countr_zero(mask));
+      }
+    }
+    return i;
+  }
+#endif
+
+#ifdef MTP_HAS_SSE2
+  // compares the first and last characters of every prefix, up to sixteen of them. leaving out the
+  // middle one keeps most of the selectivity of the third character at two compares a prefix
+  [[nodiscard]] static auto
+  skip_prefixes(unsigned char const* bytes, size_type i, size_type count) noexcept -> size_type
+  {
+    if constexpr (automaton.prefix_count <= 16) {
+      using chunk = detail::chunk_t<32>;
+      for (; i + chunk::width + automaton.prefix_length - 1 <= count; i += chunk::width) {
+        auto mask = std::uint32_t{ 0 };
+        for (size_type p = 0; p < automaton.prefix_count; ++p) {
+          auto const& prefix = automaton.prefixes[p];
+          auto match = chunk::matches(bytes + i, prefix[0]);
+          if constexpr (automaton.prefix_length > 1) {
+            constexpr auto j = automaton.prefix_length - 1;
+            match &= chunk::matches(bytes + i + j, prefix[j]);
+          }
+          mask |= match;
+        }
+        if (mask != 0) {
+          return i + static_cast<size_type>(std::countr_zero(mask));
+        }
+      }
+    }
+    return i;
+  }
+#endif
+};
+
+// -------------------------------------------------------------------------------------------------
+
+// formatting with the format string as a template argument. the format string is parsed at compile
+// time into literal chunks and fields, each field is written by code specialized for its argument
+// type and spec, and the largest possible output follows from the argument types. the syntax is
+// the one of `std::format` without nested replacement fields, locale specific output and the 'a',
+// 'p' and '?' types. widths count code units
+
+namespace detail {
+
+enum class format_align : unsigned char
+{
+  none,
+  left,
+  right,
+  center
+};
+
+enum class format_sign : unsigned char
+{
+  minus,
+  plus,
+  space
+};
+
+template <typename CharT>
+struct format_spec
+{
+  CharT fill = CharT{ ' ' };
+  format_align align = format_align::none;
+  format_sign sign = format_sign::minus;
+  bool alternate = false;
+  bool zero_pad = false;
+  std::size_t width = 0;
+  std::size_t precision = npos;
+  char type = '\0';
+};
+
+// the literal `[begin, begin + length)` of the format string, or the field of argument `arg`
+template <typename CharT>
+struct format_segment
+{
+  std::size_t begin = 0;
+  std::size_t length = 0;
+  std::size_t arg = npos;
+  format_spec<CharT> spec = {};
+};
+
+// calls to these are compile errors naming the problem with a format string
+
+inline auto
+format_unmatched_closing_brace() -> void
+{}
+
+inline auto
+format_missing_closing_brace() -> void
+{}
+
+inline auto
+format_mixed_argument_indexing() -> void
+{}
+
+inline auto
+format_invalid_spec() -> void
+{}
+
+template <typename CharT>
+[[nodiscard]] constexpr auto
+is_digit(CharT ch) noexcept -> bool
+{
+  return ch >= CharT{ '0' } && ch <= CharT{ '9' };
+}
+
+template <typename CharT>
+[[nodiscard]] constexpr auto
+format_align_of(CharT ch) noexcept -> format_align
+{
+  return ch == CharT{ '<' }   ? format_align::left
+         : ch == CharT{ '>' } ? format_align::right
+         : ch == CharT{ '^' } ? format_align::center
+                              : format_align::none;
+}
+
+template <typename CharT>
+[[nodiscard]] constexpr auto
+parse_format_number(std::basic_string_view<CharT> fmt, std::size_t& i) noexcept -> std::size_t
+{
+  auto value = std::size_t{ 0 };
+  for (; i < fmt.size() && is_digit(fmt[i]); ++i) {
+    value = value * 10 + static_cast<std::size_t>(fmt[i] - CharT{ '0' });
+  }
+  return value;
+}
+
+// [[fill]align][sign]['#']['0'][width]['.' precision][type], returns the position after the spec
+template <typename CharT>
+[[nodiscard]] constexpr auto
+parse_format_spec(std::basic_string_view<CharT> fmt, std::size_t i, format_spec<CharT>& spec)
+    -> std::size_t
+{
+  auto const at = [&](std::size_t j) { return j < fmt.size() ? fmt[j] : CharT{}; };
+
+  if (format_align_of(at(i + 1)) != format_align::none && at(i) != CharT{ '{' }
+      && at(i) != CharT{ '}' }) {
+    spec.fill = at(i);
+    spec.align = format_align_of(at(i + 1));
+    i += 2;
+  }
+  else if (format_align_of(at(i)) != format_align::none) {
+    spec.align = format_align_of(at(i));
+    i += 1;
+  }
+
+  if (at(i) == CharT{ '+' } || at(i) == CharT{ '-' } || at(i) == CharT{ ' ' }) {
+    spec.sign = at(i) == CharT{ '+' }   ? format_sign::plus
+                : at(i) == CharT{ ' ' } ? format_sign::space
+                                        : format_sign::minus;
+    ++i;
+  }
+  if (at(i) == CharT{ '#' }) {
+    spec.alternate = true;
+    ++i;
+  }
+  if (at(i) == CharT{ '0' }) {
+    spec.zero_pad = true;
+    ++i;
+  }
+  spec.width = parse_format_number(fmt, i);
+  if (at(i) == CharT{ '.' }) {
+    ++i;
+    if (!is_digit(at(i))) {
+      format_invalid_spec();
+    }
+    spec.precision = parse_format_number(fmt, i);
+  }
+
+  if (at(i) != CharT{ '}' }) {
+    for (auto const type : std::string_view{ "bBcdoxXeEfFgGs" }) {
+      if (at(i) == static_cast<CharT>(type)) {
+        spec.type = type;
+      }
+    }
+    if (spec.type == '\0') {
+      format_invalid_spec();
+    }
+    ++i;
+  }
+  return i;
+}
+
+// stores the segments to `out` if it is not null, returns their count
+template <typename CharT>
+[[nodiscard]] constexpr auto
+parse_format(std::basic_string_view<CharT> fmt, format_segment<CharT>* out) -> std::size_t
+{
+  auto count = std::size_t{ 0 };
+  auto const emit = [&](format_segment<CharT> const& segment) {
+    if (out != nullptr) {
+      out[count] = segment;
+    }
+    ++count;
+  };
+
+  auto literal = std::size_t{ 0 };
+  auto const emit_literal = [&](std::size_t end) {
+    if (end > literal) {
+      emit(format_segment<CharT>{ literal, end - literal });
+    }
+  };
+
+  auto next_arg = std::size_t{ 0 };
+  auto automatic = false;
+  auto manual = false;
+
+  for (std::size_t i = 0; i < fmt.size();) {
+    if (fmt[i] == CharT{ '}' }) {
+      if (i + 1 >= fmt.size() || fmt[i + 1] != CharT{ '}' }) {
+        format_unmatched_closing_brace();
+      }
+      emit_literal(i + 1);
+      literal = i += 2;
+      continue;
+    }
+    if (fmt[i] != CharT{ '{' }) {
+      ++i;
+      continue;
+    }
+    if (i + 1 < fmt.size() && fmt[i + 1] == CharT{ '{' }) {
+      emit_literal(i + 1);
+      literal = i += 2;
+      continue;
+    }
+
+    emit_literal(i++);
+    auto field = format_segment<CharT>{};
+    if (i < fmt.size() && is_digit(fmt[i])) {
+      field.arg = parse_format_number(fmt, i);
+      manual = true;
+    }
+    else {
+      field.arg = next_arg++;
+      automatic = true;
+    }
+    if (automatic && manual) {
+      format_mixed_argument_indexing();
+    }
+    if (i < fmt.size() && fmt[i] == CharT{ ':' }) {
+      i = parse_format_spec(fmt, i + 1, field.spec);
+    }
+    if (i >= fmt.size() || fmt[i] != CharT{ '}' }) {
+      format_missing_closing_brace();
+    }
+    emit(field);
+    literal = ++i;
+  }
+  emit_literal(fmt.size());
+
+  return count;
+}
+
+template <basic_fixed_string Fmt>
+inline constexpr auto format_segments_v = [] {
+  using char_type = typename decltype(Fmt)::value_type;
+  constexpr auto count = parse_format<char_type>(Fmt.view(), nullptr);
+
+  auto segments = std::array<format_segment<char_type>, count>{};
+  static_cast<void>(parse_format<char_type>(Fmt.view(), segments.data()));
+  return segments;
+}();
+
+template <basic_fixed_string Fmt>
+inline constexpr std::size_t format_arg_count_v = [] {
+  auto count = std::size_t{ 0 };
+  for (auto const& segment : format_segments_v<Fmt>) {
+    if (segment.arg != npos) {
+      count = std::max(count, segment.arg + 1);
+    }
+  }
+  return count;
+}();
+
+template <std::size_t I, typename T, typename... Ts>
+struct nth_type : nth_type<I - 1, Ts...>
+{};
+
+template <typename T, typename... Ts>
+struct nth_type<0, T, Ts...>
+{
+  using type = T;
+};
+
+template <std::size_t I, typename T, typename... Ts>
+[[nodiscard]] constexpr auto
+nth_arg(T const& arg, Ts const&... args) noexcept -> auto const&
+{
+  if constexpr (I == 0) {
+    return arg;
+  }
+  else {
+    return nth_arg<I - 1>(args...);
+  }
+}
+
+// -- argument kinds and output bounds
+
+enum class format_kind : unsigned char
+{
+  text,
+  integer,
+  floating
+};
+
+template <typename T, typename CharT>
+concept format_string_arg =
+    !std::is_arithmetic_v<T> && std::convertible_to<T const&, std::basic_string_view<CharT>>;
+
+template <typename T, typename CharT>
+concept format_char_arg = std::same_as<T, CharT> || std::same_as<T, char>;
+
+template <auto Spec, typename T>
+[[nodiscard]] consteval auto
+format_kind_of() -> format_kind
+{
+  using char_type = decltype(Spec.fill);
+  constexpr auto type = Spec.type;
+  constexpr auto integer_type =
+      type == 'b' || type == 'B' || type == 'd' || type == 'o' || type == 'x' || type == 'X';
+  constexpr auto plain = Spec.sign == format_sign::minus && !Spec.alternate && !Spec.zero_pad;
+
+  if constexpr (std::same_as<T, bool> || format_char_arg<T, char_type>) {
+    constexpr auto text_type = std::same_as<T, bool> ? 's' : 'c';
+    static_assert(integer_type || ((type == '\0' || type == text_type) && plain
+                                   && Spec.precision == npos),
+                  "invalid format spec for a bool or character argument");
+    return integer_type ? format_kind::integer : format_kind::text;
+  }
+  else if constexpr (std::integral<T>) {
+    static_assert((integer_type || type == '\0' || (type == 'c' && plain))
+                      && Spec.precision == npos,
+                  "invalid format spec for an integer argument");
+    return type == 'c' ? format_kind::text : format_kind::integer;
+  }
+  else if constexpr (std::floating_point<T>) {
+    static_assert((type == '\0' || type == 'e' || type == 'E' || type == 'f' || type == 'F'
+                   || type == 'g' || type == 'G')
+                      && !Spec.alternate,
+                  "invalid format spec for a floating point argument");
+    return format_kind::floating;
+  }
+  else {
+    static_assert(format_string_arg<T, char_type>, "unsupported format argument type");
+    static_assert((type == '\0' || type == 's') && plain,
+                  "invalid format spec for a string argument");
+    return format_kind::text;
+  }
+}
+
+// largest length of a string argument, `npos` if unknown
+template <typename T>
+inline constexpr std::size_t format_string_bound_v = npos;
+
+template <typename CharT, std::size_t N, typename Layout>
+inline constexpr std::size_t format_string_bound_v<basic_fixed_string<CharT, N, Layout>> = N;
+
+template <typename CharT, std::size_t Capacity>
+inline constexpr std::size_t format_string_bound_v<basic_inplace_string<CharT, Capacity>> =
+    Capacity;
+
+template <typename CharT, std::size_t N>
+inline constexpr std::size_t format_string_bound_v<CharT[N]> = N - 1;
+
+// largest output of `std::to_chars`, including a sign
+template <auto Spec, std::floating_point T>
+[[nodiscard]] consteval auto
+format_floating_bound() -> std::size_t
+{
+  using limits = std::numeric_limits<T>;
+  constexpr auto exponent = std::size_t{ limits::max_exponent10 >= 1000 ? 4
+                                         : limits::max_exponent10 >= 100 ? 3
+                                                                         : 2 };
+  constexpr auto precision = Spec.precision == npos ? std::size_t{ 6 } : Spec.precision;
+  constexpr auto fraction = precision == 0 ? 0 : 1 + precision;
+
+  if constexpr (Spec.type == 'f' || Spec.type == 'F') {
+    return 1 + static_cast<std::size_t>(limits::max_exponent10) + 1 + fraction;
+  }
+  else if constexpr (Spec.type == 'e' || Spec.type == 'E') {
+    return 1 + 1 + fraction + 2 + exponent;
+  }
+  else if constexpr (Spec.type == '\0' && Spec.precision == npos) {
+    return 1 + static_cast<std::size_t>(limits::max_digits10) + 1 + 2 + exponent;
+  }
+  else {
+    // general, "-d.ddde+xx" or "-0.000ddd"
+    return 1 + std::max<std::size_t>(precision, 1) + 1 + std::max<std::size_t>(4, 2 + exponent);
+  }
+}
+
+// largest output of a field before padding, `npos` if unknown
+template <auto Spec, typename T>
+[[nodiscard]] consteval auto
+format_content_bound() -> std::size_t
+{
+  constexpr auto kind = format_kind_of<Spec, T>();
+
+  if constexpr (kind == format_kind::integer) {
+    using unsigned_type = std::make_unsigned_t<std::conditional_t<std::same_as<T, bool>, char, T>>;
+    constexpr auto bits = static_cast<std::size_t>(std::numeric_limits<unsigned_type>::digits);
+    constexpr auto digits = Spec.type == 'b' || Spec.type == 'B' ? bits
+                            : Spec.type == 'o'                   ? (bits + 2) / 3
+                            : Spec.type == 'x' || Spec.type == 'X'
+                                ? (bits + 3) / 4
+                                : static_cast<std::size_t>(
+                                      std::numeric_limits<unsigned_type>::digits10 + 1);
+    constexpr auto prefix = Spec.type == 'd' || Spec.type == '\0' ? 0 : 2;
+    return 1 + prefix + digits;
+  }
+  else if constexpr (kind == format_kind::floating) {
+    return format_floating_bound<Spec, T>();
+  }
+  else if constexpr (std::same_as<T, bool>) {
+    return 5;
+  }
+  else if constexpr (std::integral<T>) {
+    return 1;
+  }
+  else {
+    return std::min(format_string_bound_v<T>, Spec.precision);
+  }
+}
+
+template <auto Spec, typename T>
+[[nodiscard]] consteval auto
+format_field_bound() -> std::size_t
+{
+  constexpr auto content = format_content_bound<Spec, T>();
+  return content == npos ? npos : std::max(content, Spec.width);
+}
+
+template <basic_fixed_string Fmt, typename... Args, std::size_t... Is>
+[[nodiscard]] consteval auto
+format_max_size(std::index_sequence<Is...>) -> std::size_t
+{
+  auto const bound = []<std::size_t I>(std::integral_constant<std::size_t, I>) {
+    constexpr auto segment = format_segments_v<Fmt>[I];
+    if constexpr (segment.arg == npos) {
+      return segment.length;
+    }
+    else {
+      return format_field_bound<segment.spec, typename nth_type<segment.arg, Args...>::type>();
+    }
+  };
+
+  auto total = std::size_t{ 0 };
+  for (auto const size :
+       { std::size_t{ 0 }, bound(std::integral_constant<std::size_t, Is>{})... }) {
+    total = size == npos || total == npos ? npos : total + size;
+  }
+  return total;
+}
+
+// -- field writers
+
+inline constexpr char format_digit_pairs[] = "0001020304050607080910111213141516171819"
+                                             "2021222324252627282930313233343536373839"
+                                             "4041424344454647484950515253545556575859"
+                                             "6061626364656667686970717273747576777879"
+                                             "8081828384858687888990919293949596979899";
+
+template <typename CharT>
+inline constexpr CharT format_true[] = { 't', 'r', 'u', 'e' };
+
+template <typename CharT>
+inline constexpr CharT format_false[] = { 'f', 'a', 'l', 's', 'e' };
+
+template <std::unsigned_integral U>
+[[nodiscard]] constexpr auto
+count_digits(U value) noexcept -> std::size_t
+{
+  auto digits = std::size_t{ 1 };
+  for (; value >= 10000; value = static_cast<U>(value / 10000)) {
+    digits += 4;
+  }
+  return digits + static_cast<std::size_t>(value >= 10) + static_cast<std::size_t>(value >= 100)
+         + static_cast<std::size_t>(value >= 1000);
+}
+
+template <typename CharT, std::unsigned_integral U>
+constexpr auto
+write_decimal(CharT* out, U value) noexcept -> CharT*
+{
+  auto* const end = out + count_digits(value);
+  auto* it = end;
+  for (; value >= 100; value = static_cast<U>(value / 100)) {
+    auto const pair = static_cast<std::size_t>(value % 100) * 2;
+    *--it = static_cast<CharT>(format_digit_pairs[pair + 1]);
+    *--it = static_cast<CharT>(format_digit_pairs[pair]);
+  }
+  if (value >= 10) {
+    auto const pair = static_cast<std::size_t>(value) * 2;
+    *--it = static_cast<CharT>(format_digit_pairs[pair + 1]);
+    *--it = static_cast<CharT>(format_digit_pairs[pair]);
+  }
+  else {
+    *--it = static_cast<CharT>('0' + value);
+  }
+  return end;
+}
+
+template <unsigned Shift, typename CharT, std::unsigned_integral U>
+constexpr auto
+write_power_of_two(CharT* out, U value, bool upper) noexcept -> CharT*
+{
+  constexpr auto mask = (1u << Shift) - 1;
+  auto const bits = static_cast<std::size_t>(std::bit_width(value));
+  auto const digits = std::max<std::size_t>(1, (bits + Shift - 1) / Shift);
+  auto const* chars = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+
+  auto* const end = out + digits;
+  for (auto* it = end; it != out; value = static_cast<U>(value >> Shift)) {
+    *--it = static_cast<CharT>(chars[value & mask]);
+  }
+  return end;
+}
+
+// `head` counts the sign and base prefix, zero padding goes between them and the digits
+template <typename CharT>
+struct format_number
+{
+  CharT* end;
+  std::size_t head;
+  bool finite = true;
+};
+
+template <auto Spec, typename CharT, std::integral T>
+constexpr auto
+render_integer(CharT* out, T value) noexcept -> format_number<CharT>
+{
+  using unsigned_type = std::make_unsigned_t<std::conditional_t<std::same_as<T, bool>, char, T>>;
+
+  auto negative = false;
+  if constexpr (std::is_signed_v<T>) {
+    negative = value < 0;
+  }
+
+  auto* it = out;
+  auto magnitude = static_cast<unsigned_type>(value);
+  if (negative) {
+    *it++ = CharT{ '-' };
+    magnitude = static_cast<unsigned_type>(0u - magnitude);
+  }
+  else if constexpr (Spec.sign == format_sign::plus) {
+    *it++ = CharT{ '+' };
+  }
+  else if constexpr (Spec.sign == format_sign::space) {
+    *it++ = CharT{ ' ' };
+  }
+
+  constexpr auto type = Spec.type;
+  if constexpr (Spec.alternate && type != 'd' && type != '\0') {
+    if (type != 'o' || magnitude != 0) {
+      *it++ = CharT{ '0' };
+    }
+    if constexpr (type != 'o') {
+      *it++ = static_cast<CharT>(type);
+    }
+  }
+  auto const head = static_cast<std::size_t>(it - out);
+
+  if constexpr (type == 'b' || type == 'B') {
+    return { write_power_of_two<1>(it, magnitude, false), head };
+  }
+  else if constexpr (type == 'o') {
+    return { write_power_of_two<3>(it, magnitude, false), head };
+  }
+  else if constexpr (type == 'x' || type == 'X') {
+    return { write_power_of_two<4>(it, magnitude, type == 'X'), head };
+  }
+  else {
+    return { write_decimal(it, magnitude), head };
+  }
+}
+
+template <auto Spec, typename CharT, std::floating_point T>
+auto
+render_floating(CharT* out, T value) noexcept -> format_number<CharT>
+{
+  constexpr auto bound = format_floating_bound<Spec, T>();
+  [[maybe_unused]] constexpr auto precision =
+      static_cast<int>(Spec.precision == npos ? 6 : Spec.precision);
+  constexpr auto type = Spec.type;
+
+  char buffer[bound + 1];
+  auto* first = buffer + 1;
+  auto const [last, ec] = [&] {
+    if constexpr (type == '\0' && Spec.precision == npos) {
+      return std::to_chars(first, buffer + sizeof(buffer), value);
+    }
+    else if constexpr (type == 'e' || type == 'E') {
+      return std::to_chars(first, buffer + sizeof(buffer), value, std::chars_format::scientific,
+                           precision);
+    }
+    else if constexpr (type == 'f' || type == 'F') {
+      return std::to_chars(first, buffer + sizeof(buffer), value, std::chars_format::fixed,
+                           precision);
+    }
+    else {
+      return std::to_chars(first, buffer + sizeof(buffer), value, std::chars_format::general,
+                           precision);
+    }
+  }();
+  MTP_EXPECTS(ec == std::errc{});
+
+  if (*first != '-') {
+    if constexpr (Spec.sign == format_sign::plus) {
+      *--first = '+';
+    }
+    else if constexpr (Spec.sign == format_sign::space) {
+      *--first = ' ';
+    }
+  }
+  auto const head = static_cast<std::size_t>(first != buffer + 1 || *first == '-');
+
+  auto* it = out;
+  for (auto const* ch = first; ch != last; ++ch) {
+    constexpr auto upper = type == 'E' || type == 'F' || type == 'G';
+    *it++ = static_cast<CharT>(upper && *ch >= 'a' && *ch <= 'z' ? *ch - 'a' + 'A' : *ch);
+  }
+  return { it, head, is_digit(first[head]) };
+}
+
+template <auto Spec, format_align Default, typename CharT>
+constexpr auto
+write_padded(CharT* out, CharT const* first, CharT const* last, std::size_t zero_pad_head) noexcept
+    -> CharT*
+{
+  auto const size = static_cast<std::size_t>(last - first);
+  if (size >= Spec.width) {
+    return std::ranges::copy(first, last, out).out;
+  }
+
+  auto const padding = Spec.width - size;
+  if (zero_pad_head != npos) {
+    out = std::ranges::copy(first, first + zero_pad_head, out).out;
+    out = std::ranges::fill_n(out, static_cast<std::ptrdiff_t>(padding), CharT{ '0' });
+    return std::ranges::copy(first + zero_pad_head, last, out).out;
+  }
+
+  constexpr auto align = Spec.align == format_align::none ? Default : Spec.align;
+  auto const before = align == format_align::left     ? 0
+                      : align == format_align::center ? padding / 2
+                                                      : padding;
+  out = std::ranges::fill_n(out, static_cast<std::ptrdiff_t>(before), Spec.fill);
+  out = std::ranges::copy(first, last, out).out;
+  return std::ranges::fill_n(out, static_cast<std::ptrdiff_t>(padding - before), Spec.fill);
+}
+
+template <auto Spec, typename CharT, typename T>
+constexpr auto
+write_field(CharT* out, T const& arg) noexcept -> CharT*
+{
+  constexpr auto kind = format_kind_of<Spec, T>();
+
+  if constexpr (kind == format_kind::text) {
+    auto const write_text = [out](std::basic_string_view<CharT> text) {
+      if constexpr (Spec.width == 0) {
+        return std::ranges::copy(text, out).out;
+      }
+      else {
+        return write_padded<Spec, format_align::left>(out, text.data(), text.data() + text.size(),
+                                                      npos);
+      }
+    };
+
+    if constexpr (std::same_as<T, bool>) {
+      return write_text(arg ? std::basic_string_view<CharT>{ format_true<CharT>, 4 }
+                            : std::basic_string_view<CharT>{ format_false<CharT>, 5 });
+    }
+    else if constexpr (std::integral<T>) {
+      auto const ch = static_cast<CharT>(arg);
+      return write_text(std::basic_string_view<CharT>{ &ch, 1 });
+    }
+    else {
+      auto const text = std::basic_string_view<CharT>(arg);
+      return write_text(text.substr(0, std::min(text.size(), Spec.precision)));
+    }
+  }
+  else {
+    auto const render = [](CharT* it, T value) {
+      if constexpr (kind == format_kind::integer) {
+        return render_integer<Spec>(it, value);
+      }
+      else {
+        return render_floating<Spec>(it, value);
+      }
+    };
+
+    if constexpr (Spec.width == 0) {
+      return render(out, arg).end;
+    }
+    else {
+      CharT buffer[format_content_bound<Spec, T>()];
+      auto const number = render(buffer, arg);
+      auto const zero_pad = Spec.zero_pad && Spec.align == format_align::none && number.finite;
+      return write_padded<Spec, format_align::right>(out, buffer, number.end,
+                                                     zero_pad ? number.head : npos);
+    }
+  }
+}
+
+template <basic_fixed_string Fmt, std::size_t I, typename CharT, typename... Args>
+constexpr auto
+write_segment(CharT* out, Args const&... args) noexcept -> CharT*
+{
+  constexpr auto segment = format_segments_v<Fmt>[I];
+
+  if constexpr (segment.arg == npos) {
+    return std::ranges::copy_n(Fmt.data() + segment.begin,
+                               static_cast<std::ptrdiff_t>(segment.length), out)
+        .out;
+  }
+  else {
+    return write_field<segment.spec>(out, nth_arg<segment.arg>(args...));
+  }
+}
+
+template <basic_fixed_string Fmt, typename CharT, typename... Args, std::size_t... Is>
+constexpr auto
+format_to(CharT* out, std::index_sequence<Is...>, Args const&... args) noexcept -> CharT*
+{
+  static_assert(sizeof...(Args) >= format_arg_count_v<Fmt>, "too few format arguments");
+  ((out = write_segment<Fmt, Is>(out, args...)), ...);
+  return out;
+}
+
+} // namespace detail
+
+// the largest output of `format<Fmt>` for arguments of types `Args`, or `std::size_t(-1)` if it is
+// unbounded (strings of unknown length without a precision)
+MTP_EXPORT template <basic_fixed_string Fmt, typename... Args>
+inline constexpr std::size_t max_formatted_size_v =
+    detail::format_max_size<Fmt, std::remove_cvref_t<Args>...>(
+        std::make_index_sequence<detail::format_segments_v<Fmt>.size()>{});
+
+// writes the output to `out` and returns the end of it, there must be room for all of it (see
+// `max_formatted_size_v` and `formatted_size`)
+MTP_EXPORT template <basic_fixed_string Fmt, typename... Args>
+constexpr auto
+format_to(typename decltype(Fmt)::value_type* out, Args const&... args) noexcept ->
+    typename decltype(Fmt)::value_type*
+{
+  return detail::format_to<Fmt>(
+      out, std::make_index_sequence<detail::format_segments_v<Fmt>.size()>{}, args...);
+}
+
+MTP_EXPORT template <basic_fixed_string Fmt, typename... Args>
+[[nodiscard]] constexpr auto
+formatted_size(Args const&... args) noexcept -> std::size_t
+{
+  using char_type = typename decltype(Fmt)::value_type;
+
+  if constexpr (constexpr auto max_size = max_formatted_size_v<Fmt, Args...>;
+                max_size != detail::npos) {
+    char_type buffer[max_size + 1];
+    return static_cast<std::size_t>(format_to<Fmt>(buffer, args...) - buffer);
+  }
+  else {
+    // only strings are unbounded, everything else is measured on a small buffer
+    auto size = std::size_t{ 0 };
+    auto const measure = [&]<std::size_t I>(std::integral_constant<std::size_t, I>) {
+      constexpr auto segment = detail::format_segments_v<Fmt>[I];
+      if constexpr (segment.arg == detail::npos) {
+        size += segment.length;
+      }
+      else {
+        auto const& arg = detail::nth_arg<segment.arg>(args...);
+        using arg_type = std::remove_cvref_t<decltype(arg)>;
+        if constexpr (constexpr auto bound = detail::format_field_bound<segment.spec, arg_type>();
+                      bound != detail::npos) {
+          char_type buffer[bound + 1];
+          size += static_cast<std::size_t>(detail::write_field<segment.spec>(buffer, arg) - buffer);
+        }
+        else {
+          auto const length = std::basic_string_view<char_type>(arg).size();
+          size += std::max(std::min(length, segment.spec.precision), segment.spec.width);
+        }
+      }
+    };
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      (measure(std::integral_constant<std::size_t, Is>{}), ...);
+    }(std::make_index_sequence<detail::format_segments_v<Fmt>.size()>{});
+    return size;
+  }
+}
+
+// formats into an inplace string sized for the largest possible output
+MTP_EXPORT template <basic_fixed_string Fmt, typename... Args>
+  requires(max_formatted_size_v<Fmt, Args...> != detail::npos)
+[[nodiscard]] constexpr auto
+format(Args const&... args) noexcept
+    -> basic_inplace_string<typename decltype(Fmt)::value_type, max_formatted_size_v<Fmt, Args...>>
+{
+  using char_type = typename decltype(Fmt)::value_type;
+  constexpr auto capacity = max_formatted_size_v<Fmt, Args...>;
+
+  auto result = basic_inplace_string<char_type, capacity>{};
+  result.resize_and_overwrite(capacity, [&](char_type* out, std::size_t) {
+    return static_cast<std::size_t>(format_to<Fmt>(out, args...) - out);
+  });
+  return result;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+// regular expressions with the pattern as a template argument. the pattern is parsed at compile
+// time into a program of nodes and every node is matched by code specialized for it, so literals
+// compare as fixed width strings, character sets are bit tests and only groups and alternations
+// keep a continuation to backtrack into. the semantics are the ones of ecmascript (and
+// `std::regex`): alternatives and repeats are tried in priority order, greedy or lazy, and the
+// first match found wins. the syntax is literals, `.`, `[...]` sets with ranges, `\d \w \s` and
+// their negations, `\b \B`, `^ $` at the ends of the subject, `( )`, `(?: )`, `|` and the
+// `* + ? {n} {n,} {n,m}` repeats with an optional lazy `?`
+//
+// the backtracking only repeats single characters, counted in a loop, so its recursion is bounded
+// by the pattern while its time is at worst the subject length to the power of the repeats in a
+// row, as with `std::regex`. a pattern repeating a group or an alternation, whose backtracking
+// would recurse per iteration and take exponential time on nested choices, runs on a pike vm
+// instead: linear in the subject times the program, which unrolls counted repeats. its thread
+// lists and stack live in the vm object, on the stack of the caller, and a pattern needing more
+// than `MTP_REGEX_VM_BYTES` of them does not compile
+
+#ifndef MTP_REGEX_VM_BYTES
+#  define MTP_REGEX_VM_BYTES 65536
+#endif
+
+namespace detail {
+
+enum class regex_op : unsigned char
+{
+  literal,
+  set,
+  any,
+  group,
+  alternation,
+  repeat,
+  line_begin,
+  line_end,
+  word_boundary,
+  not_word_boundary
+};
+
+// the fields used depend on the op:
+// - literal: the `length` characters at `index` of the program text
+// - set: the set at `index`
+// - group: the sequence at `child`, capture group `index` or `npos`. a group is also a branch of an
+//   alternation, whose `child` is its first branch, each branch linking the next by `alternative`
+// - repeat: `child` repeated from `min` to `max` (`npos` is unbounded) times, resetting the
+//   `length` capture groups from `index` on every iteration
+// the node matched after this one is `next`, or the enclosing continuation if that is `npos`
+struct regex_node
+{
+  regex_op op = regex_op::literal;
+  bool greedy = true;
+  std::size_t next = npos;
+  std::size_t child = npos;
+  std::size_t alternative = npos;
+  std::size_t index = npos;
+  std::size_t length = 0;
+  std::size_t min = 1;
+  std::size_t max = 1;
+};
+
+struct regex_range
+{
+  std::uint32_t first = 0;
+  std::uint32_t last = 0;
+};
+
+// code units below 256 are looked up in `bits` (negation included), wider ones in the `count`
+// ranges from `ranges` of the program
+struct regex_set
+{
+  std::array<std::uint64_t, 4> bits = {};
+  std::size_t ranges = 0;
+  std::size_t count = 0;
+  bool negated = false;
+};
+
+// every pattern character makes at most two nodes (an alternation adds itself and its first
+// branch), one set and two ranges (from a class escape of two characters making four)
+template <typename CharT, std::size_t N>
+struct regex_program
+{
+  std::array<regex_node, 2 * N + 2> nodes = {};
+  std::size_t node_count = 0;
+  std::array<CharT, N + 1> text = {};
+  std::size_t text_size = 0;
+  std::array<regex_set, N + 1> sets = {};
+  std::size_t set_count = 0;
+  std::array<regex_range, 2 * N + 4> ranges = {};
+  std::size_t range_count = 0;
+  std::size_t root = npos;
+  std::size_t captures = 0;
+};
+
+// calls to these are compile errors naming the problem with a pattern
+
+inline auto
+regex_unbalanced_parenthesis() -> void
+{}
+
+inline auto
+regex_unterminated_set() -> void
+{}
+
+inline auto
+regex_invalid_range() -> void
+{}
+
+inline auto
+regex_invalid_escape() -> void
+{}
+
+inline auto
+regex_invalid_repeat() -> void
+{}
+
+inline auto
+regex_nothing_to_repeat() -> void
+{}
+
+inline constexpr regex_range regex_digit[] = { { '0', '9' } };
+inline constexpr regex_range regex_word[] = {
+  { '0', '9' }, { 'A', 'Z' }, { '_', '_' }, { 'a', 'z' }
+};
+inline constexpr regex_range regex_space[] = { { '\t', '\r' }, { ' ', ' ' } };
+
+template <typename CharT, std::size_t N>
+class regex_parser
+{
+public:
+  [[nodiscard]] explicit constexpr regex_parser(std::basic_string_view<CharT> pattern) noexcept
+      : _pattern{ pattern }
+  {}
+
+  [[nodiscard]] constexpr auto
+  parse() -> regex_program<CharT, N>
+  {
+    _program.root = alternation();
+    if (!done()) {
+      regex_unbalanced_parenthesis();
+    }
+    return _program;
+  }
+
+private:
+  std::basic_string_view<CharT> _pattern;
+  std::size_t _pos = 0;
+  regex_program<CharT, N> _program = {};
+
+  [[nodiscard]] constexpr auto
+  done() const noexcept -> bool
+  {
+    return _pos >= _pattern.size();
+  }
+
+  [[nodiscard]] constexpr auto
+  peek(std::size_t offset = 0) const noexcept -> CharT
+  {
+    return _pos + offset < _pattern.size() ? _pattern[_pos + offset] : CharT{};
+  }
+
+  constexpr auto
+  add(regex_node const& node) noexcept -> std::size_t
+  {
+    _program.nodes[_program.node_count] = node;
+    return _program.node_count++;
+  }
+
+  // sequences separated by '|', up to a ')' or the end
+  constexpr auto
+  alternation() -> std::size_t
+  {
+    auto const head = sequence();
+    if (peek() != CharT{ '|' } || done()) {
+      return head;
+    }
+    auto branch = add({ .op = regex_op::group, .child = head });
+    auto const node = add({ .op = regex_op::alternation, .child = branch });
+    while (peek() == CharT{ '|' } && !done()) {
+      ++_pos;
+      auto const next = add({ .op = regex_op::group, .child = sequence() });
+      _program.nodes[branch].alternative = next;
+      branch = next;
+    }
+    return node;
+  }
+
+  constexpr auto
+  sequence() -> std::size_t
+  {
+    auto head = npos;
+    auto tail = npos;
+    while (!done() && peek() != CharT{ '|' } && peek() != CharT{ ')' }) {
+      auto const first_capture = _program.captures + 1;
+      auto node = atom();
+      if (auto const repeated = repeat(node); repeated != node) {
+        _program.nodes[repeated].index = first_capture;
+        _program.nodes[repeated].length = _program.captures + 1 - first_capture;
+        node = repeated;
+      }
+      else if (tail != npos && _program.nodes[node].op == regex_op::literal
+               && _program.nodes[tail].op == regex_op::literal) {
+        // consecutive literals compare as one string
+        ++_program.nodes[tail].length;
+        --_program.node_count;
+        continue;
+      }
+
+      if (tail == npos) {
+        head = node;
+      }
+      else {
+        _program.nodes[tail].next = node;
+      }
+      tail = node;
+    }
+    return head;
+  }
+
+  constexpr auto
+  literal(CharT ch) noexcept -> std::size_t
+  {
+    _program.text[_program.text_size] = ch;
+    return add({ .op = regex_op::literal, .index = _program.text_size++, .length = 1 });
+  }
+
+  constexpr auto
+  set(regex_range const* ranges, std::size_t count, bool negated) noexcept -> std::size_t
+  {
+    auto& set = _program.sets[_program.set_count];
+    set.ranges = _program.range_count;
+    set.negated = negated;
+    for (std::size_t c = 0; c < 256; ++c) {
+      auto in = false;
+      for (std::size_t r = 0; r < count; ++r) {
+        in = in || (c >= ranges[r].first && c <= ranges[r].last);
+      }
+      if (in != negated) {
+        set.bits[c / 64] |= std::uint64_t{ 1 } << (c % 64);
+      }
+    }
+    if constexpr (sizeof(CharT) > 1) {
+      for (std::size_t r = 0; r < count; ++r) {
+        if (ranges[r].last >= 256) {
+          _program.ranges[_program.range_count++] = { std::max(ranges[r].first, 256u),
+                                                      ranges[r].last };
+        }
+      }
+    }
+    set.count = _program.range_count - set.ranges;
+    return add({ .op = regex_op::set, .index = _program.set_count++ });
+  }
+
+  template <std::size_t Count>
+  constexpr auto
+  set(regex_range const (&ranges)[Count], bool negated) noexcept -> std::size_t
+  {
+    return set(ranges, Count, negated);
+  }
+
+  constexpr auto
+  atom() -> std::size_t
+  {
+    auto const ch = _pattern[_pos++];
+    switch (ch) {
+    case CharT{ '(' }: {
+      auto index = npos;
+      if (peek() == CharT{ '?' } && peek(1) == CharT{ ':' }) {
+        _pos += 2;
+      }
+      else {
+        index = ++_program.captures;
+      }
+      auto const child = alternation();
+      if (peek() != CharT{ ')' } || done()) {
+        regex_unbalanced_parenthesis();
+      }
+      ++_pos;
+      return add({ .op = regex_op::group, .child = child, .index = index });
+    }
+    case CharT{ '[' }:
+      return bracket();
+    case CharT{ '.' }:
+      return add({ .op = regex_op::any });
+    case CharT{ '^' }:
+      return add({ .op = regex_op::line_begin });
+    case CharT{ '$' }:
+      return add({ .op = regex_op::line_end });
+    case CharT{ '*' }:
+    case CharT{ '+' }:
+    case CharT{ '?' }:
+    case CharT{ '{' }:
+      regex_nothing_to_repeat();
+      return npos;
+    case CharT{ '\\' }:
+      return escape();
+    default:
+      return literal(ch);
+    }
+  }
+
+  // the character of a single character escape, or nothing for a letter or digit
+  [[nodiscard]] constexpr auto
+  escaped(CharT ch, bool in_set) const noexcept -> std::optional<CharT>
+  {
+    switch (ch) {
+    case CharT{ 'n' }:
+      return CharT{ '\n' };
+    case CharT{ 't' }:
+      return CharT{ '\t' };
+    case CharT{ 'r' }:
+      return CharT{ '\r' };
+    case CharT{ 'f' }:
+      return CharT{ '\f' };
+    case CharT{ 'v' }:
+      return CharT{ '\v' };
+    case CharT{ '0' }:
+      return CharT{ '\0' };
+    case CharT{ 'b' }:
+      return in_set ? std::optional{ CharT{ '\b' } } : std::nullopt;
+    default:
+      if ((ch >= CharT{ '0' } && ch <= CharT{ '9' }) || (ch >= CharT{ 'A' } && ch <= CharT{ 'Z' })
+          || (ch >= CharT{ 'a' } && ch <= CharT{ 'z' })) {
+        return std::nullopt;
+      }
+      return ch;
+    }
+  }
+
+  constexpr auto
+  escape() -> std::size_t
+  {
+    if (done()) {
+      regex_invalid_escape();
+    }
+    auto const ch = _pattern[_pos++];
+    switch (ch) {
+    case CharT{ 'd' }:
+    case CharT{ 'D' }:
+      return set(regex_digit, ch == CharT{ 'D' });
+    case CharT{ 'w' }:
+    case CharT{ 'W' }:
+      return set(regex_word, ch == CharT{ 'W' });
+    case CharT{ 's' }:
+    case CharT{ 'S' }:
+      return set(regex_space, ch == CharT{ 'S' });
+    case CharT{ 'b' }:
+      return add({ .op = regex_op::word_boundary });
+    case CharT{ 'B' }:
+      return add({ .op = regex_op::not_word_boundary });
+    default:
+      if (auto const literal_ch = escaped(ch, false)) {
+        return literal(*literal_ch);
+      }
+      regex_invalid_escape();
+      return npos;
+    }
+  }
+
+  // `[...]`, class escapes inside a set are `\d \w \s` without their negations
+  constexpr auto
+  bracket() -> std::size_t
+  {
+    auto ranges = std::array<regex_range, 2 * N + 4>{};
+    auto count = std::size_t{ 0 };
+    auto const negated = peek() == CharT{ '^' };
+    _pos += negated ? 1 : 0;
+
+    // a character or a class escape appended to the ranges
+    auto const element = [&]() -> std::optional<std::uint32_t> {
+      auto const ch = _pattern[_pos++];
+      if (ch != CharT{ '\\' }) {
+        return static_cast<std::uint32_t>(code_unit(ch));
+      }
+      if (done()) {
+        regex_unterminated_set();
+      }
+      auto const escape_ch = _pattern[_pos++];
+      auto const append = [&](auto const& class_ranges) {
+        for (auto const& range : class_ranges) {
+          ranges[count++] = range;
+        }
+        return std::nullopt;
+      };
+      switch (escape_ch) {
+      case CharT{ 'd' }:
+        return append(regex_digit);
+      case CharT{ 'w' }:
+        return append(regex_word);
+      case CharT{ 's' }:
+        return append(regex_space);
+      default:
+        if (auto const literal_ch = escaped(escape_ch, true)) {
+          return static_cast<std::uint32_t>(code_unit(*literal_ch));
+        }
+        regex_invalid_escape();
+        return std::nullopt;
+      }
+    };
+
+    for (;;) {
+      if (done()) {
+        regex_unterminated_set();
+      }
+      if (peek() == CharT{ ']' }) {
+        ++_pos;
+        break;
+      }
+      auto const first = element();
+      if (peek() != CharT{ '-' } || peek(1) == CharT{ ']' } || _pos + 1 >= _pattern.size()) {
+        if (first) {
+          ranges[count++] = { *first, *first };
+        }
+        continue;
+      }
+      ++_pos;
+      auto const last = element();
+      if (!first || !last || *last < *first) {
+        regex_invalid_range();
+      }
+      ranges[count++] = { *first, *last };
+    }
+    return set(ranges.data(), count, negated);
+  }
+
+  // wraps `node` in a repeat if a quantifier follows it
+  constexpr auto
+  repeat(std::size_t node) -> std::size_t
+  {
+    auto min = std::size_t{ 0 };
+    auto max = npos;
+    switch (peek()) {
+    case CharT{ '*' }:
+      ++_pos;
+      break;
+    case CharT{ '+' }:
+      ++_pos;
+      min = 1;
+      break;
+    case CharT{ '?' }:
+      ++_pos;
+      max = 1;
+      break;
+    case CharT{ '{' }:
+      ++_pos;
+      if (!is_digit(peek())) {
+        regex_invalid_repeat();
+      }
+      min = max = parse_format_number(_pattern, _pos);
+      if (peek() == CharT{ ',' }) {
+        ++_pos;
+        max = is_digit(peek()) ? parse_format_number(_pattern, _pos) : npos;
+      }
+      if (peek() != CharT{ '}' } || done() || max < min) {
+        regex_invalid_repeat();
+      }
+      ++_pos;
+      break;
+    default:
+      return node;
+    }
+
+    auto const op = _program.nodes[node].op;
+    if (op == regex_op::line_begin || op == regex_op::line_end || op == regex_op::word_boundary
+        || op == regex_op::not_word_boundary) {
+      regex_nothing_to_repeat();
+    }
+    auto const greedy = peek() != CharT{ '?' };
+    _pos += greedy ? 0 : 1;
+    return add(
+        { .op = regex_op::repeat, .greedy = greedy, .child = node, .min = min, .max = max });
+  }
+};
+
+template <basic_fixed_string Pattern>
+inline constexpr auto regex_program_v =
+    regex_parser<typename decltype(Pattern)::value_type, Pattern.size()>{ Pattern.view() }.parse();
+
+// the literal every match starts with, empty if there is none
+template <basic_fixed_string Pattern>
+inline constexpr auto regex_prefix_v = [] {
+  using char_type = typename decltype(Pattern)::value_type;
+  constexpr auto const& program = regex_program_v<Pattern>;
+  constexpr auto root = program.root == npos ? regex_node{} : program.nodes[program.root];
+  constexpr auto length = root.op == regex_op::literal ? root.length : 0;
+  auto const* const first = program.text.data() + (length == 0 ? 0 : root.index);
+  return basic_fixed_string<char_type, length>{ first, first + length };
+}();
+
+template <typename CharT, std::size_t N>
+[[nodiscard]] constexpr auto
+regex_in_set(regex_program<CharT, N> const& program, regex_set const& set, CharT ch) noexcept
+    -> bool
+{
+  auto const u = code_unit(ch);
+  if (u < 256) {
+    return ((set.bits[u / 64] >> (u % 64)) & 1) != 0;
+  }
+  auto in = false;
+  for (std::size_t r = set.ranges; r < set.ranges + set.count; ++r) {
+    in = in || (u >= program.ranges[r].first && u <= program.ranges[r].last);
+  }
+  return in != set.negated;
+}
+
+template <typename CharT>
+[[nodiscard]] constexpr auto
+regex_is_word(CharT ch) noexcept -> bool
+{
+  return (ch >= CharT{ '0' } && ch <= CharT{ '9' }) || (ch >= CharT{ 'A' } && ch <= CharT{ 'Z' })
+         || (ch >= CharT{ 'a' } && ch <= CharT{ 'z' }) || ch == CharT{ '_' };
+}
+
+template <typename CharT>
+[[nodiscard]] constexpr auto
+regex_at_word_boundary(CharT const* first, CharT const* last, CharT const* pos) noexcept -> bool
+{
+  return (pos != first && regex_is_word(pos[-1])) != (pos != last && regex_is_word(*pos));
+}
+
+template <basic_fixed_string Pattern>
+class regex_matcher
+{
+  using char_type = typename decltype(Pattern)::value_type;
+  using pointer = char_type const*;
+  using view = std::basic_string_view<char_type>;
+
+  static constexpr auto const& program = regex_program_v<Pattern>;
+
+public:
+  static constexpr std::size_t groups = program.captures + 1;
+
+  std::array<view, groups> captures = {};
+
+  [[nodiscard]] constexpr regex_matcher(pointer first, pointer last) noexcept
+      : _first{ first }
+      , _last{ last }
+  {}
+
+  // a match of the whole subject
+  [[nodiscard]] constexpr auto
+  match_all() noexcept -> bool
+  {
+    if (match<program.root>(_first, [&](pointer end) { return end == _last; })) {
+      captures[0] = view(_first, static_cast<std::size_t>(_last - _first));
+      return true;
+    }
+    return false;
+  }
+
+  // a match starting at `start`
+  [[nodiscard]] constexpr auto
+  match_at(pointer start) noexcept -> bool
+  {
+    return match<program.root>(start, [&](pointer end) {
+      captures[0] = view(start, static_cast<std::size_t>(end - start));
+      return true;
+    });
+  }
+
+  [[nodiscard]] static constexpr auto
+  anchored() noexcept -> bool
+  {
+    return program.root != npos && program.nodes[program.root].op == regex_op::line_begin;
+  }
+
+  // the first position from `pos` on where a match can start, skipping characters that are not in
+  // a set every match starts with
+  [[nodiscard]] constexpr auto
+  next_start(pointer pos) const noexcept -> pointer
+  {
+    if constexpr (constexpr auto first = first_set(); first != npos) {
+      while (pos != _last && !matches<first>(*pos)) {
+        ++pos;
+      }
+    }
+    return pos;
+  }
+
+private:
+  pointer _first;
+  pointer _last;
+
+  // the set node every match starts with, looking into groups and repeats, or `npos`
+  [[nodiscard]] static constexpr auto
+  first_set() noexcept -> std::size_t
+  {
+    auto i = program.root;
+    while (i != npos) {
+      auto const& node = program.nodes[i];
+      if (node.op == regex_op::set) {
+        return i;
+      }
+      if (node.op != regex_op::group && (node.op != regex_op::repeat || node.min == 0)) {
+        return npos;
+      }
+      i = node.child;
+    }
+    return npos;
+  }
+
+  [[nodiscard]] static constexpr auto
+  is_single(regex_node const& node) noexcept -> bool
+  {
+    return (node.op == regex_op::literal && node.length == 1) || node.op == regex_op::set
+           || node.op == regex_op::any;
+  }
+
+  // whether the single character node `I` matches `ch`
+  template <std::size_t I>
+  [[nodiscard]] static constexpr auto
+  matches(char_type ch) noexcept -> bool
+  {
+    constexpr auto node = program.nodes[I];
+    if constexpr (node.op == regex_op::literal) {
+      return ch == program.text[node.index];
+    }
+    else if constexpr (node.op == regex_op::any) {
+      return ch != char_type{ '\n' } && ch != char_type{ '\r' };
+    }
+    else {
+      return regex_in_set(program, program.sets[node.index], ch);
+    }
+  }
+
+  [[nodiscard]] constexpr auto
+  at_word_boundary(pointer pos) const noexcept -> bool
+  {
+    return regex_at_word_boundary(_first, _last, pos);
+  }
+
+  template <std::size_t I>
+  [[nodiscard]] static constexpr auto
+  literal_at(pointer pos) noexcept -> bool
+  {
+    constexpr auto node = program.nodes[I];
+    if (!std::is_constant_evaluated()) {
+      return equal<char_type, node.length>(pos, program.text.data() + node.index);
+    }
+    for (std::size_t i = 0; i < node.length; ++i) {
+      if (pos[i] != program.text[node.index + i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // matches the sequence from node `I` at `pos`, then `cont` at the end of it
+  template <std::size_t I, typename Cont>
+  [[nodiscard]] constexpr auto
+  match(pointer pos, Cont const& cont) noexcept -> bool
+  {
+    if constexpr (I == npos) {
+      return cont(pos);
+    }
+    else {
+      constexpr auto node = program.nodes[I];
+      if constexpr (node.op == regex_op::literal) {
+        return static_cast<std::size_t>(_last - pos) >= node.length && literal_at<I>(pos)
+               && match<node.next>(pos + node.length, cont);
+      }
+      else if constexpr (node.op == regex_op::set || node.op == regex_op::any) {
+        return pos != _last && matches<I>(*pos) && match<node.next>(pos + 1, cont);
+      }
+      else if constexpr (node.op == regex_op::line_begin) {
+        return pos == _first && match<node.next>(pos, cont);
+      }
+      else if constexpr (node.op == regex_op::line_end) {
+        return pos == _last && match<node.next>(pos, cont);
+      }
+      else if constexpr (node.op == regex_op::word_boundary
+                         || node.op == regex_op::not_word_boundary) {
+        return at_word_boundary(pos) == (node.op == regex_op::word_boundary)
+               && match<node.next>(pos, cont);
+      }
+      else if constexpr (node.op == regex_op::group) {
+        auto const rest = [&](pointer end) { return match<node.next>(end, cont); };
+        if constexpr (node.index == npos) {
+          return match<node.child>(pos, rest);
+        }
+        else {
+          return match<node.child>(pos, [&](pointer end) {
+            auto const outer = captures[node.index];
+            captures[node.index] = view(pos, static_cast<std::size_t>(end - pos));
+            if (rest(end)) {
+              return true;
+            }
+            captures[node.index] = outer;
+            return false;
+          });
+        }
+      }
+      else if constexpr (node.op == regex_op::alternation) {
+        return branch<node.child>(pos, [&](pointer end) { return match<node.next>(end, cont); });
+      }
+      else {
+        static_assert(is_single(program.nodes[node.child]),
+                      "mtp::detail::regex_matcher: patterns repeating more than single characters "
+                      "run on regex_vm");
+        return repeat_single<I>(pos, cont);
+      }
+    }
+  }
+
+  template <std::size_t B, typename Cont>
+  [[nodiscard]] constexpr auto
+  branch(pointer pos, Cont const& cont) noexcept -> bool
+  {
+    constexpr auto node = program.nodes[B];
+    if (match<node.child>(pos, cont)) {
+      return true;
+    }
+    if constexpr (node.alternative != npos) {
+      return branch<node.alternative>(pos, cont);
+    }
+    else {
+      return false;
+    }
+  }
+
+  // a repeated character is counted in a loop and backtracked into without recursion
+  template <std::size_t I, typename Cont>
+  [[nodiscard]] constexpr auto
+  repeat_single(pointer pos, Cont const& cont) noexcept -> bool
+  {
+    constexpr auto node = program.nodes[I];
+    auto const limit = std::min(node.max, static_cast<std::size_t>(_last - pos));
+    auto count = std::size_t{ 0 };
+    while (count < limit && matches<node.child>(pos[count])) {
+      ++count;
+    }
+    if (count < node.min) {
+      return false;
+    }
+    for (auto k = node.greedy ? count : node.min;; node.greedy ? --k : ++k) {
+      if (match<node.next>(pos + k, cont)) {
+        return true;
+      }
+      if (k == (node.greedy ? node.min : count)) {
+        return false;
+      }
+    }
+  }
+};
+
+// patterns repeating a group or an alternation are compiled into a thompson nfa instead and run by
+// `regex_vm`. repeats are unrolled: the required iterations one after another, then a loop or the
+// optional iterations nested in one another, each optional one failing if it matches nothing
+enum class regex_inst_op : unsigned char
+{
+  literal,
+  set,
+  any,
+  match,
+  split,
+  save,
+  reset,
+  mark,
+  progress,
+  line_begin,
+  line_end,
+  word_boundary,
+  not_word_boundary
+};
+
+// the fields used depend on the op:
+// - literal: the character at `index` of the program text, set: the set at `index`
+// - split: `next` tried before `alternative`
+// - save and mark: the position into slot `index`, reset: the `length` slots from `index` cleared
+// - progress: fails at the position marked in slot `index`
+// every instruction but a split and a match continues at `next`
+struct regex_inst
+{
+  regex_inst_op op = regex_inst_op::match;
+  std::size_t next = npos;
+  std::size_t alternative = npos;
+  std::size_t index = 0;
+  std::size_t length = 0;
+};
+
+// slots two by two are the start and end of the capture groups, the whole match included, then one
+// slot per repeat with optional iterations that can match nothing, holding where its current
+// iteration started
+template <std::size_t Size>
+struct regex_code
+{
+  std::array<regex_inst, Size> insts = {};
+  std::size_t size = 0;
+  std::size_t start = 0;
+  std::size_t slots = 0;
+};
+
+// a `Size` of zero only counts the instructions
+template <typename CharT, std::size_t N, std::size_t Size>
+class regex_compiler
+{
+public:
+  [[nodiscard]] explicit constexpr regex_compiler(regex_program<CharT, N> const& program) noexcept
+      : _program{ program }
+  {}
+
+  [[nodiscard]] constexpr auto
+  compile() noexcept -> regex_code<Size>
+  {
+    _code.slots = 2 * (_program.captures + 1);
+    _code.start = sequence(_program.root, emit({ .op = regex_inst_op::match }));
+    return _code;
+  }
+
+private:
+  regex_program<CharT, N> const& _program;
+  regex_code<Size> _code = {};
+
+  constexpr auto
+  emit(regex_inst const& inst) noexcept -> std::size_t
+  {
+    if constexpr (Size != 0) {
+      _code.insts[_code.size] = inst;
+    }
+    return _code.size++;
+  }
+
+  // the instructions of the sequence from node `i` followed by `cont`, returning the first one
+  constexpr auto
+  sequence(std::size_t i, std::size_t cont) noexcept -> std::size_t
+  {
+    auto nodes = std::array<std::size_t, 2 * N + 2>{};
+    auto count = std::size_t{ 0 };
+    for (; i != npos; i = _program.nodes[i].next) {
+      nodes[count++] = i;
+    }
+    while (count != 0) {
+      cont = atom(nodes[--count], cont);
+    }
+    return cont;
+  }
+
+  constexpr auto
+  atom(std::size_t i, std::size_t cont) noexcept -> std::size_t
+  {
+    auto const& node = _program.nodes[i];
+    switch (node.op) {
+    case regex_op::literal:
+      for (auto k = node.length; k-- != 0;) {
+        cont = emit({ .op = regex_inst_op::literal, .next = cont, .index = node.index + k });
+      }
+      return cont;
+    case regex_op::set:
+      return emit({ .op = regex_inst_op::set, .next = cont, .index = node.index });
+    case regex_op::any:
+      return emit({ .op = regex_inst_op::any, .next = cont });
+    case regex_op::line_begin:
+      return emit({ .op = regex_inst_op::line_begin, .next = cont });
+    case regex_op::line_end:
+      return emit({ .op = regex_inst_op::line_end, .next = cont });
+    case regex_op::word_boundary:
+      return emit({ .op = regex_inst_op::word_boundary, .next = cont });
+    case regex_op::not_word_boundary:
+      return emit({ .op = regex_inst_op::not_word_boundary, .next = cont });
+    case regex_op::group:
+      if (node.index == npos) {
+        return sequence(node.child, cont);
+      }
+      cont = emit({ .op = regex_inst_op::save, .next = cont, .index = 2 * node.index + 1 });
+      cont = sequence(node.child, cont);
+      return emit({ .op = regex_inst_op::save, .next = cont, .index = 2 * node.index });
+    case regex_op::alternation: {
+      auto entries = std::array<std::size_t, 2 * N + 2>{};
+      auto count = std::size_t{ 0 };
+      for (auto b = node.child; b != npos; b = _program.nodes[b].alternative) {
+        entries[count++] = sequence(_program.nodes[b].child, cont);
+      }
+      auto entry = entries[--count];
+      while (count != 0) {
+        --count;
+        entry = emit({ .op = regex_inst_op::split, .next = entries[count], .alternative = entry });
+      }
+      return entry;
+    }
+    case regex_op::repeat:
+      return repeat(node, cont);
+    }
+    return cont;
+  }
+
+  // whether every match of the sequence from node `i` consumes a character
+  [[nodiscard]] constexpr auto
+  consumes(std::size_t i) const noexcept -> bool
+  {
+    for (; i != npos; i = _program.nodes[i].next) {
+      auto const& node = _program.nodes[i];
+      auto result = false;
+      switch (node.op) {
+      case regex_op::literal:
+      case regex_op::set:
+      case regex_op::any:
+        return true;
+      case regex_op::group:
+        result = consumes(node.child);
+        break;
+      case regex_op::alternation:
+        result = true;
+        for (auto b = node.child; b != npos; b = _program.nodes[b].alternative) {
+          result = result && consumes(_program.nodes[b].child);
+        }
+        break;
+      case regex_op::repeat:
+        result = node.min != 0 && consumes(node.child);
+        break;
+      default:
+        break;
+      }
+      if (result) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  constexpr auto
+  repeat(regex_node const& node, std::size_t cont) noexcept -> std::size_t
+  {
+    auto entry = cont;
+    if (node.max != node.min) {
+      // the position an iteration started at is only needed if it can match nothing
+      auto const checked = !consumes(node.child);
+      auto const slot = checked ? _code.slots++ : 0;
+      auto const optional = [&](std::size_t again) {
+        if (!checked) {
+          return iteration(node, again);
+        }
+        auto const body = iteration(
+            node, emit({ .op = regex_inst_op::progress, .next = again, .index = slot }));
+        return emit({ .op = regex_inst_op::mark, .next = body, .index = slot });
+      };
+      auto const choice = [&](std::size_t iterate) {
+        return node.greedy ? regex_inst{ .op = regex_inst_op::split, .next = iterate,
+                                         .alternative = cont }
+                           : regex_inst{ .op = regex_inst_op::split, .next = cont,
+                                         .alternative = iterate };
+      };
+      if (node.max == npos) {
+        entry = emit({});
+        auto const inst = choice(optional(entry));
+        if constexpr (Size != 0) {
+          _code.insts[entry] = inst;
+        }
+      }
+      else {
+        for (auto k = node.min; k != node.max; ++k) {
+          entry = emit(choice(optional(entry)));
+        }
+      }
+    }
+    for (std::size_t k = 0; k != node.min; ++k) {
+      entry = iteration(node, entry);
+    }
+    return entry;
+  }
+
+  // the capture groups inside a repeat are reset at the start of every iteration
+  constexpr auto
+  iteration(regex_node const& node, std::size_t cont) noexcept -> std::size_t
+  {
+    auto const body = atom(node.child, cont);
+    if (node.length == 0) {
+      return body;
+    }
+    return emit({ .op = regex_inst_op::reset,
+                  .next = body,
+                  .index = 2 * node.index,
+                  .length = 2 * node.length });
+  }
+};
+
+template <basic_fixed_string Pattern>
+inline constexpr auto regex_code_v = [] {
+  using char_type = typename decltype(Pattern)::value_type;
+  constexpr auto const& program = regex_program_v<Pattern>;
+  constexpr auto size =
+      regex_compiler<char_type, Pattern.size(), 0>{ program }.compile().size;
+  return regex_compiler<char_type, Pattern.size(), size>{ program }.compile();
+}();
+
+// whether `Pattern` repeats more than single characters, which `regex_matcher` would backtrack
+// into with a recursion per iteration and, for nested choices, in exponential time
+template <basic_fixed_string Pattern>
+inline constexpr bool regex_repeats_groups_v = [] {
+  constexpr auto const& program = regex_program_v<Pattern>;
+  for (std::size_t i = 0; i < program.node_count; ++i) {
+    auto const& node = program.nodes[i];
+    if (node.op == regex_op::repeat) {
+      auto const& child = program.nodes[node.child];
+      if (!(child.op == regex_op::literal && child.length == 1) && child.op != regex_op::set
+          && child.op != regex_op::any) {
+        return true;
+      }
+    }
+  }
+  return false;
+}();
+
+// a pike vm: every thread of the nfa is stepped over the subject one character at a time, in
+// priority order and with its own capture slots, and of the threads reaching an instruction at a
+// position only the first is kept. that bounds the work per character by the program size, the
+// recursion by nothing (the closure over instructions that consume nothing keeps its own stack)
+// and the memory by the program size times the slots. the match is the one the backtracking
+// `regex_matcher` would find: the first thread to match cuts the ones behind it and is replaced
+// by one ahead of it matching later
+template <basic_fixed_string Pattern>
+class regex_vm
+{
+  using char_type = typename decltype(Pattern)::value_type;
+  using pointer = char_type const*;
+  using view = std::basic_string_view<char_type>;
+
+  static constexpr auto const& program = regex_program_v<Pattern>;
+  static constexpr auto const& code = regex_code_v<Pattern>;
+
+  // instructions that consume a character or match, the only ones threads wait at
+  static constexpr auto thread_capacity = [] {
+    auto count = std::size_t{ 0 };
+    for (std::size_t pc = 0; pc < code.size; ++pc) {
+      auto const op = code.insts[pc].op;
+      count += op == regex_inst_op::literal || op == regex_inst_op::set
+               || op == regex_inst_op::any || op == regex_inst_op::match;
+    }
+    return count;
+  }();
+
+  // every instruction is visited once per closure and pushes at most this many entries
+  static constexpr auto stack_capacity = [] {
+    auto count = std::size_t{ 1 };
+    for (std::size_t pc = 0; pc < code.size; ++pc) {
+      auto const& inst = code.insts[pc];
+      switch (inst.op) {
+      case regex_inst_op::split:
+      case regex_inst_op::save:
+      case regex_inst_op::mark:
+        count += 2;
+        break;
+      case regex_inst_op::reset:
+        count += inst.length + 1;
+        break;
+      default:
+        count += 1;
+        break;
+      }
+    }
+    return count;
+  }();
+
+  // the code units below 256 a match can start with, wider ones are not told apart. all of them
+  // for a pattern that can match nothing
+  static constexpr auto first_units = [] {
+    auto units = std::array<std::uint64_t, 4>{};
+    auto seen = std::array<bool, code.size>{};
+    auto stack = std::array<std::size_t, code.size>{};
+    auto size = std::size_t{ 0 };
+    stack[size++] = code.start;
+    seen[code.start] = true;
+    auto const push = [&](std::size_t pc) {
+      if (!seen[pc]) {
+        seen[pc] = true;
+        stack[size++] = pc;
+      }
+    };
+    while (size != 0) {
+      auto const& inst = code.insts[stack[--size]];
+      for (std::size_t u = 0; u < 256; ++u) {
+        auto const ch = static_cast<char_type>(u);
+        auto const in = (inst.op == regex_inst_op::literal && ch == program.text[inst.index])
+                        || (inst.op == regex_inst_op::set
+                            && regex_in_set(program, program.sets[inst.index], ch))
+                        || (inst.op == regex_inst_op::any && u != '\n' && u != '\r')
+                        || inst.op == regex_inst_op::match;
+        units[code_unit(ch) / 64] |= std::uint64_t{ in } << (code_unit(ch) % 64);
+      }
+      if (inst.op == regex_inst_op::split) {
+        push(inst.alternative);
+      }
+      if (inst.op != regex_inst_op::literal && inst.op != regex_inst_op::set
+          && inst.op != regex_inst_op::any && inst.op != regex_inst_op::match) {
+        push(inst.next);
+      }
+    }
+    return units;
+  }();
+
+  using slots = std::array<pointer, code.slots>;
+
+  // left uninitialized, only the threads below the size of a list and the entries below the top of
+  // the stack are read
+  struct thread
+  {
+    std::size_t pc;
+    slots slot;
+  };
+
+  struct thread_list
+  {
+    std::array<thread, thread_capacity> threads;
+    std::size_t size = 0;
+  };
+
+  // an instruction to visit, or with `pc` of `npos` a slot to restore on the way back
+  struct entry
+  {
+    std::size_t pc;
+    std::size_t slot;
+    pointer value;
+  };
+
+public:
+  static constexpr std::size_t groups = program.captures + 1;
+
+  std::array<view, groups> captures = {};
+
+  [[nodiscard]] constexpr regex_vm(pointer first, pointer last) noexcept
+      : _first{ first }
+      , _last{ last }
+  {}
+
+  // a match of the whole subject
+  [[nodiscard]] constexpr auto
+  match_all() noexcept -> bool
+  {
+    return run(_first, false, true);
+  }
+
+  // a match starting at `start`
+  [[nodiscard]] constexpr auto
+  match_at(pointer start) noexcept -> bool
+  {
+    return run(start, false, false);
+  }
+
+  // the first match starting from `start` on
+  [[nodiscard]] constexpr auto
+  search(pointer start) noexcept -> bool
+  {
+    return run(start, true, false);
+  }
+
+private:
+  pointer _first;
+  pointer _last;
+  std::array<thread_list, 2> _lists;
+  std::array<entry, stack_capacity> _stack;
+  std::array<std::size_t, code.size> _seen = {};
+  std::size_t _generation = 0;
+
+  static_assert(sizeof(_lists) + sizeof(_stack) + sizeof(_seen) <= MTP_REGEX_VM_BYTES,
+                "mtp::regex: the pattern is too large once its counted repeats are unrolled, "
+                "shrink them or raise MTP_REGEX_VM_BYTES");
+
+  // starts threads at every position from `start` on until one matches if `search` is set, and
+  // only accepts matches ending at the end of the subject if `whole` is
+  [[nodiscard]] constexpr auto
+  run(pointer start, bool search, bool whole) noexcept -> bool
+  {
+    auto* current = &_lists[0];
+    auto* next = &_lists[1];
+    auto matched = false;
+    current->size = 0;
+    ++_generation;
+    for (auto pos = start;; ++pos) {
+      if (!matched && (pos == start || (search && can_start(pos)))) {
+        if (search && current->size == 0) {
+          pos = skip(pos);
+        }
+        auto slot = slots{};
+        slot[0] = pos;
+        add(*current, code.start, pos, slot);
+      }
+      ++_generation;
+      next->size = 0;
+      for (std::size_t t = 0; t < current->size; ++t) {
+        auto& live = current->threads[t];
+        auto const& inst = code.insts[live.pc];
+        if (inst.op == regex_inst_op::match) {
+          if (!whole || pos == _last) {
+            live.slot[1] = pos;
+            for (std::size_t g = 0; g < groups; ++g) {
+              auto const* const first = live.slot[2 * g];
+              auto const* const last = live.slot[2 * g + 1];
+              captures[g] = first == nullptr || last == nullptr
+                                ? view{}
+                                : view(first, static_cast<std::size_t>(last - first));
+            }
+            matched = true;
+            break;
+          }
+        }
+        else if (pos != _last && consumes(inst, *pos)) {
+          add(*next, inst.next, pos + 1, live.slot);
+        }
+      }
+      std::swap(current, next);
+      if (pos == _last || (current->size == 0 && (matched || !search))) {
+        return matched;
+      }
+    }
+  }
+
+  // the first position from `pos` on where a match can start
+  [[nodiscard]] constexpr auto
+  skip(pointer pos) const noexcept -> pointer
+  {
+    constexpr auto const& prefix = regex_prefix_v<Pattern>;
+    if constexpr (prefix.size() != 0) {
+      auto const size = static_cast<std::size_t>(_last - _first);
+      auto const i = find_needle<prefix>(_first, size, static_cast<std::size_t>(pos - _first));
+      return i == npos ? _last : _first + i;
+    }
+    else {
+      while (!can_start(pos)) {
+        ++pos;
+      }
+      return pos;
+    }
+  }
+
+  [[nodiscard]] constexpr auto
+  can_start(pointer pos) const noexcept -> bool
+  {
+    if (pos == _last) {
+      return true;
+    }
+    auto const u = code_unit(*pos);
+    return u >= 256 || ((first_units[u / 64] >> (u % 64)) & 1) != 0;
+  }
+
+  [[nodiscard]] static constexpr auto
+  consumes(regex_inst const& inst, char_type ch) noexcept -> bool
+  {
+    switch (inst.op) {
+    case regex_inst_op::literal:
+      return ch == program.text[inst.index];
+    case regex_inst_op::any:
+      return ch != char_type{ '\n' } && ch != char_type{ '\r' };
+    default:
+      return regex_in_set(program, program.sets[inst.index], ch);
+    }
+  }
+
+  // adds to `list` the threads reached from `pc` at `pos` without consuming a character, in
+  // priority order, leaving `slot` as it found it
+  constexpr auto
+  add(thread_list& list, std::size_t pc, pointer pos, slots& slot) noexcept -> void
+  {
+    auto size = std::size_t{ 0 };
+    _stack[size++] = { .pc = pc, .slot = 0, .value = nullptr };
+    while (size != 0) {
+      auto const top = _stack[--size];
+      if (top.pc == npos) {
+        slot[top.slot] = top.value;
+        continue;
+      }
+      if (_seen[top.pc] == _generation) {
+        continue;
+      }
+      _seen[top.pc] = _generation;
+      auto const& inst = code.insts[top.pc];
+      auto passes = true;
+      switch (inst.op) {
+      case regex_inst_op::split:
+        _stack[size++] = { .pc = inst.alternative, .slot = 0, .value = nullptr };
+        break;
+      case regex_inst_op::save:
+      case regex_inst_op::mark:
+        _stack[size++] = { .pc = npos, .slot = inst.index, .value = slot[inst.index] };
+        slot[inst.index] = pos;
+        break;
+      case regex_inst_op::reset:
+        for (auto s = inst.index; s != inst.index + inst.length; ++s) {
+          _stack[size++] = { .pc = npos, .slot = s, .value = slot[s] };
+          slot[s] = nullptr;
+        }
+        break;
+      case regex_inst_op::progress:
+        passes = slot[inst.index] != pos;
+        break;
+      case regex_inst_op::line_begin:
+        passes = pos == _first;
+        break;
+      case regex_inst_op::line_end:
+        passes = pos == _last;
+        break;
+      case regex_inst_op::word_boundary:
+      case regex_inst_op::not_word_boundary:
+        passes = regex_at_word_boundary(_first, _last, pos)
+                 == (inst.op == regex_inst_op::word_boundary);
+        break;
+      default:
+        list.threads[list.size++] = { .pc = top.pc, .slot = slot };
+        passes = false;
+        break;
+      }
+      if (passes) {
+        _stack[size++] = { .pc = inst.next, .slot = 0, .value = nullptr };
+      }
+    }
+  }
+};
+
+template <basic_fixed_string Pattern>
+using regex_engine_t =
+    std::conditional_t<regex_repeats_groups_v<Pattern>, regex_vm<Pattern>, regex_matcher<Pattern>>;
+
+} // namespace detail
+
+// the groups of a match: the whole match and then every capture group in the order of their
+// opening parentheses. a group that took no part in the match is an empty view without data
+MTP_EXPORT template <typename CharT, std::size_t Groups>
+class basic_regex_result
+{
+public:
+  using value_type = std::basic_string_view<CharT>;
+  using size_type = std::size_t;
+  using const_iterator = typename std::array<value_type, Groups>::const_iterator;
+
+  [[nodiscard]] constexpr basic_regex_result() noexcept = default;
+
+  [[nodiscard]] explicit constexpr basic_regex_result(
+      std::array<value_type, Groups> const& groups) noexcept
+      : _groups{ groups }
+      , _matched{ true }
+  {}
+
+  [[nodiscard]] explicit constexpr
+  operator bool() const noexcept
+  {
+    return _matched;
+  }
+
+  [[nodiscard]] constexpr auto
+  operator[](size_type i) const noexcept -> value_type
+  {
+    MTP_EXPECTS(i < Groups);
+    return _groups[i];
+  }
+
+  template <size_type I>
+  [[nodiscard]] constexpr auto
+  get() const noexcept -> value_type
+  {
+    static_assert(I < Groups, "mtp::basic_regex_result::get: no such group");
+    return _groups[I];
+  }
+
+  [[nodiscard]] constexpr auto
+  begin() const noexcept -> const_iterator
+  {
+    return _groups.begin();
+  }
+
+  [[nodiscard]] constexpr auto
+  end() const noexcept -> const_iterator
+  {
+    return _groups.end();
+  }
+
+  [[nodiscard]] static constexpr auto
+  size() noexcept -> size_type
+  {
+    return Groups;
+  }
+
+private:
+  std::array<value_type, Groups> _groups = {};
+  bool _matched = false;
+};
+
+// whether `Pattern` matches all of `sv`
+MTP_EXPORT template <basic_fixed_string Pattern>
+[[nodiscard]] constexpr auto
+regex_match(std::basic_string_view<typename decltype(Pattern)::value_type> sv) noexcept
+    -> basic_regex_result<typename decltype(Pattern)::value_type,
+                          detail::regex_matcher<Pattern>::groups>
+{
+  using result = basic_regex_result<typename decltype(Pattern)::value_type,
+                                    detail::regex_matcher<Pattern>::groups>;
+
+  auto matcher = detail::regex_engine_t<Pattern>{ sv.data(), sv.data() + sv.size() };
+  return matcher.match_all() ? result{ matcher.captures } : result{};
+}
+
+// the first match of `Pattern` in `sv`, searching from `pos`. a pattern starting with a literal
+// skips to its occurrences with the compile time needle search, one starting with a set to the
+// characters in it
+MTP_EXPORT template <basic_fixed_string Pattern>
+[[nodiscard]] constexpr auto
+regex_search(std::basic_string_view<typename decltype(Pattern)::value_type> sv,
+             std::size_t pos = 0) noexcept
+    -> basic_regex_result<typename decltype(Pattern)::value_type,
+                          detail::regex_matcher<Pattern>::groups>
+{
+  using result = basic_regex_result<typename decltype(Pattern)::value_type,
+                                    detail::regex_matcher<Pattern>::groups>;
+  constexpr auto const& prefix = detail::regex_prefix_v<Pattern>;
+
+  auto matcher = detail::regex_engine_t<Pattern>{ sv.data(), sv.data() + sv.size() };
+  if constexpr (detail::regex_matcher<Pattern>::anchored()) {
+    if (pos == 0 && matcher.match_at(sv.data())) {
+      return result{ matcher.captures };
+    }
+    return result{};
+  }
+  else if constexpr (detail::regex_repeats_groups_v<Pattern>) {
+    if (pos <= sv.size() && matcher.search(sv.data() + pos)) {
+      return result{ matcher.captures };
+    }
+    return result{};
+  }
+  else {
+    for (; pos <= sv.size(); ++pos) {
+      if constexpr (prefix.size() != 0) {
+        pos = detail::find_needle<prefix>(sv.data(), sv.size(), pos);
+        if (pos == detail::npos) {
+          break;
+        }
+      }
+      else {
+        pos = static_cast<std::size_t>(matcher.next_start(sv.data() + pos) - sv.data());
+      }
+      if (matcher.match_at(sv.data() + pos)) {
+        return result{ matcher.captures };
+      }
+    }
+    return result{};
+  }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+// conversions between numbers and strings. `to_fixed_string<Value>()` spells a constant as a fixed
+// string of exactly its length, `parse<T, Str>()` reads an integer constant out of one and
+// `from_chars` parses run time strings, decimal digits four and eight at a time
+
+namespace detail {
+
+inline constexpr char base_digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+template <std::size_t Capacity>
+struct number_chars
+{
+  std::array<char, Capacity> chars = {};
+  std::size_t size = 0;
+
+  constexpr auto
+  push(char ch) noexcept -> void
+  {
+    chars[size++] = ch;
+  }
+
+  constexpr auto
+  append(char const* str) noexcept -> void
+  {
+    for (; *str != '\0'; ++str) {
+      push(*str);
+    }
+  }
+};
+
+template <std::integral T>
+[[nodiscard]] consteval auto
+integer_chars(T value, int base) noexcept
+{
+  using unsigned_type = std::make_unsigned_t<T>;
+
+  auto result = number_chars<std::numeric_limits<unsigned_type>::digits + 1>{};
+  auto magnitude = static_cast<unsigned_type>(value);
+  if constexpr (std::is_signed_v<T>) {
+    if (value < T{}) {
+      result.push('-');
+      magnitude = static_cast<unsigned_type>(unsigned_type{} - magnitude);
+    }
+  }
+
+  auto const radix = static_cast<unsigned_type>(base);
+  auto const first = result.size;
+  do {
+    result.push(base_digits[magnitude % radix]);
+    magnitude = static_cast<unsigned_type>(magnitude / radix);
+  } while (magnitude != 0);
+  std::reverse(result.chars.begin() + first, result.chars.begin() + result.size);
+  return result;
+}
+
+// -- shortest round trip representation of floating point values
+//
+// the value and the midpoints to its neighbours are expanded exactly into decimal digits, and the
+// fewest digits that land between the midpoints are picked, as `std::to_chars` does
+
+// wide enough for any double scaled to an integer, 2^55 * 5^1076 < 2^2560
+struct big_uint
+{
+  std::array<std::uint32_t, 80> limbs = {};
+  std::size_t size = 0;
+
+  constexpr explicit big_uint(std::uint64_t value) noexcept
+  {
+    for (; value != 0; value >>= 32) {
+      limbs[size++] = static_cast<std::uint32_t>(value);
+    }
+  }
+
+  constexpr auto
+  shift_left(std::size_t bits) noexcept -> void
+  {
+    auto const words = bits / 32;
+    auto const rest = bits % 32;
+    for (auto i = size; i-- > 0;) {
+      limbs[i + words] = limbs[i];
+    }
+    std::fill_n(limbs.begin(), words, 0u);
+    size += words;
+
+    if (rest != 0) {
+      auto carry = std::uint32_t{};
+      for (auto i = words; i < size; ++i) {
+        auto const limb = limbs[i];
+        limbs[i] = (limb << rest) | carry;
+        carry = limb >> (32 - rest);
+      }
+      if (carry != 0) {
+        limbs[size++] = carry;
+      }
+    }
+  }
+
+  constexpr auto
+  multiply(std::uint32_t factor) noexcept -> void
+  {
+    auto carry = std::uint64_t{};
+    for (std::size_t i = 0; i < size; ++i) {
+      auto const product = std::uint64_t{ limbs[i] } * factor + carry;
+      limbs[i] = static_cast<std::uint32_t>(product);
+      carry = product >> 32;
+    }
+    if (carry != 0) {
+      limbs[size++] = static_cast<std::uint32_t>(carry);
+    }
+  }
+
+  // divides in place and returns the remainder
+  constexpr auto
+  divide(std::uint32_t divisor) noexcept -> std::uint32_t
+  {
+    auto remainder = std::uint64_t{};
+    for (auto i = size; i-- > 0;) {
+      auto const current = (remainder << 32) | limbs[i];
+      limbs[i] = static_cast<std::uint32_t>(current / divisor);
+      remainder = current % divisor;
+    }
+    while (size > 0 && limbs[size - 1] == 0) {
+      --size;
+    }
+    return static_cast<std::uint32_t>(remainder);
+  }
+};
+
+// decimal digits, most significant first and without leading zeros
+struct decimal_digits
+{
+  std::array<char, 780> digits = {};
+  std::size_t size = 0;
+};
+
+// the digits of `mantissa * 2^exponent * 10^max(-exponent, 0)`
+[[nodiscard]] constexpr auto
+exact_decimal(std::uint64_t mantissa, int exponent) noexcept -> decimal_digits
+{
+  auto value = big_uint{ mantissa };
+  if (exponent >= 0) {
+    value.shift_left(static_cast<std::size_t>(exponent));
+  }
+  else {
+    // 5^13 is the largest power of five that fits a limb
+    auto fives = -exponent;
+    for (; fives >= 13; fives -= 13) {
+      value.multiply(1220703125);
+    }
+    for (; fives > 0; --fives) {
+      value.multiply(5);
+    }
+  }
+
+  auto result = decimal_digits{};
+  while (value.size > 0) {
+    auto group = value.divide(1000000000);
+    auto const count = value.size > 0 ? 9 : count_digits(group);
+    for (std::size_t i = 0; i < count; ++i, group /= 10) {
+      result.digits[result.size++] = static_cast<char>('0' + group % 10);
+    }
+  }
+  std::reverse(result.digits.begin(), result.digits.begin() + result.size);
+  return result;
+}
+
+// `digits[0, count)` followed by zeros up to `length` digits
+struct decimal_candidate
+{
+  std::array<char, 24> digits = {};
+  std::size_t count = 0;
+  std::size_t length = 0;
+};
+
+[[nodiscard]] constexpr auto
+compare_decimal(decimal_candidate const& lhs, decimal_digits const& rhs) noexcept -> int
+{
+  if (lhs.length != rhs.size) {
+    return lhs.length < rhs.size ? -1 : 1;
+  }
+  for (std::size_t i = 0; i < lhs.length; ++i) {
+    auto const digit = i < lhs.count ? lhs.digits[i] : '0';
+    if (digit != rhs.digits[i]) {
+      return digit < rhs.digits[i] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+template <std::floating_point T>
+[[nodiscard]] consteval auto
+shortest_chars(T value) noexcept
+{
+  constexpr auto precision = std::numeric_limits<T>::digits;
+  static_assert(std::numeric_limits<T>::is_iec559 && (precision == 24 || precision == 53),
+                "mtp::to_fixed_string: only binary32 and binary64 floating point is supported");
+
+  using bits_type = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+  constexpr auto mantissa_bits = precision - 1;
+  constexpr auto exponent_mask = (bits_type{ 1 } << (8 * sizeof(T) - 1 - mantissa_bits)) - 1;
+  constexpr auto bias = std::numeric_limits<T>::max_exponent - 1;
+
+  auto const bits = std::bit_cast<bits_type>(value);
+  auto const fraction = bits & ((bits_type{ 1 } << mantissa_bits) - 1);
+  auto const biased = static_cast<int>((bits >> mantissa_bits) & exponent_mask);
+
+  auto result = number_chars<32>{};
+  if (bits >> (8 * sizeof(T) - 1) != 0) {
+    result.push('-');
+  }
+  if (biased == static_cast<int>(exponent_mask)) {
+    result.append(fraction == 0 ? "inf" : "nan");
+    return result;
+  }
+  if (biased == 0 && fraction == 0) {
+    result.push('0');
+    return result;
+  }
+
+  // value = mantissa * 2^exponent, the midpoints are a quarter step either side, or an eighth
+  // below at the bottom of a binade
+  auto const mantissa =
+      std::uint64_t{ biased == 0 ? fraction : fraction | (bits_type{ 1 } << mantissa_bits) };
+  auto const exponent = std::max(biased, 1) - bias - mantissa_bits - 2;
+  auto const lower_closer = fraction == 0 && biased > 1;
+  auto const fractional_digits = static_cast<std::size_t>(std::max(-exponent, 0));
+
+  auto const exact = exact_decimal(4 * mantissa, exponent);
+  auto const low = exact_decimal(4 * mantissa - (lower_closer ? 1 : 2), exponent);
+  auto const high = exact_decimal(4 * mantissa + 2, exponent);
+  auto const inclusive = mantissa % 2 == 0;
+
+  auto const inside = [&](decimal_candidate const& candidate) {
+    auto const above = compare_decimal(candidate, low);
+    auto const below = compare_decimal(candidate, high);
+    return inclusive ? above >= 0 && below <= 0 : above > 0 && below < 0;
+  };
+
+  auto shortest = decimal_candidate{};
+  for (std::size_t count = 1;; ++count) {
+    auto down = decimal_candidate{ {}, count, exact.size };
+    std::copy_n(exact.digits.begin(), count, down.digits.begin());
+
+    auto up = down;
+    auto i = count;
+    for (; i > 0 && up.digits[i - 1] == '9'; --i) {
+      up.digits[i - 1] = '0';
+    }
+    if (i > 0) {
+      ++up.digits[i - 1];
+    }
+    else {
+      up.digits[0] = '1';
+      up.count = 1;
+      ++up.length;
+    }
+
+    auto round_up = false;
+    if (count < exact.size) {
+      auto const next = exact.digits[count];
+      auto const rest_zero = std::all_of(exact.digits.begin() + count + 1,
+                                         exact.digits.begin() + exact.size,
+                                         [](char digit) { return digit == '0'; });
+      auto const odd = (down.digits[count - 1] - '0') % 2 != 0;
+      round_up = next > '5' || (next == '5' && (!rest_zero || odd));
+    }
+
+    auto const& nearer = round_up ? up : down;
+    auto const& farther = round_up ? down : up;
+    if (inside(nearer) || inside(farther)) {
+      shortest = inside(nearer) ? nearer : farther;
+      break;
+    }
+  }
+  while (shortest.count > 1 && shortest.digits[shortest.count - 1] == '0') {
+    --shortest.count;
+  }
+
+  // printf's "%f" unless "%e" is shorter. integers are printed in full, past the shortest digits
+  auto const digits = static_cast<int>(shortest.count);
+  auto const point =
+      static_cast<int>(shortest.length) - static_cast<int>(fractional_digits) - 1;
+  auto const magnitude = point < 0 ? -point : point;
+  auto const fixed_size =
+      point >= digits - 1 ? point + 1 : (point >= 0 ? digits + 1 : digits + 1 - point);
+  auto const scientific_size =
+      digits + (digits > 1 ? 1 : 0) + 2 + (magnitude >= 100 ? 3 : 2);
+
+  if (fixed_size <= scientific_size && point >= digits - 1) {
+    for (std::size_t d = 0; d < exact.size - fractional_digits; ++d) {
+      result.push(exact.digits[d]);
+    }
+  }
+  else if (fixed_size <= scientific_size) {
+    if (point < 0) {
+      result.append("0.");
+      for (auto z = 0; z < -point - 1; ++z) {
+        result.push('0');
+      }
+    }
+    for (std::size_t d = 0; d < shortest.count; ++d) {
+      if (point >= 0 && d == static_cast<std::size_t>(point) + 1) {
+        result.push('.');
+      }
+      result.push(shortest.digits[d]);
+    }
+  }
+  else {
+    result.push(shortest.digits[0]);
+    if (digits > 1) {
+      result.push('.');
+      for (std::size_t d = 1; d < shortest.count; ++d) {
+        result.push(shortest.digits[d]);
+      }
+    }
+    result.push('e');
+    result.push(point < 0 ? '-' : '+');
+    if (magnitude >= 100) {
+      result.push(static_cast<char>('0' + magnitude / 100));
+    }
+    result.push(static_cast<char>('0' + magnitude / 10 % 10));
+    result.push(static_cast<char>('0' + magnitude % 10));
+  }
+  return result;
+}
+
+template <auto Value, int Base>
+inline constexpr auto number_chars_v = [] {
+  using value_type = decltype(Value);
+  if constexpr (std::is_enum_v<value_type>) {
+    return integer_chars(static_cast<std::underlying_type_t<value_type>>(Value), Base);
+  }
+  else if constexpr (std::floating_point<value_type>) {
+    static_assert(Base == 10, "mtp::to_fixed_string: floating point values are only decimal");
+    return shortest_chars(Value);
+  }
+  else {
+    return integer_chars(Value, Base);
+  }
+}();
+
+// -- integer parsing
+
+template <typename CharT>
+struct parse_result
+{
+  CharT const* ptr;
+  std::errc ec;
+};
+
+inline auto
+parse_invalid_number() -> void
+{}
+
+inline auto
+parse_out_of_range() -> void
+{}
+
+// 0 to 35 for digits and letters of either case, 36 for anything else
+template <typename CharT>
+[[nodiscard]] constexpr auto
+digit_value(CharT ch) noexcept -> unsigned
+{
+  if (ch >= CharT{ '0' } && ch <= CharT{ '9' }) {
+    return static_cast<unsigned>(ch - CharT{ '0' });
+  }
+  if (ch >= CharT{ 'a' } && ch <= CharT{ 'z' }) {
+    return static_cast<unsigned>(ch - CharT{ 'a' }) + 10;
+  }
+  if (ch >= CharT{ 'A' } && ch <= CharT{ 'Z' }) {
+    return static_cast<unsigned>(ch - CharT{ 'A' }) + 10;
+  }
+  return 36;
+}
+
+// `std::from_chars` for integers of any character type, one digit at a time
+template <typename CharT, std::integral T>
+constexpr auto
+parse_integer(CharT const* first, CharT const* last, T& value, int base) noexcept
+    -> parse_result<CharT>
+{
+  using unsigned_type = std::make_unsigned_t<T>;
+
+  auto const* it = first;
+  auto negative = false;
+  if constexpr (std::is_signed_v<T>) {
+    if (it != last && *it == CharT{ '-' }) {
+      negative = true;
+      ++it;
+    }
+  }
+
+  auto const radix = static_cast<unsigned>(base);
+  auto const limit = static_cast<unsigned_type>(
+      static_cast<unsigned_type>(std::numeric_limits<T>::max()) + (negative ? 1u : 0u));
+  auto magnitude = unsigned_type{};
+  auto overflow = false;
+  auto const* const digits = it;
+  for (; it != last; ++it) {
+    auto const digit = digit_value(*it);
+    if (digit >= radix) {
+      break;
+    }
+    if (magnitude > (limit - digit) / radix) {
+      overflow = true;
+    }
+    else {
+      magnitude = static_cast<unsigned_type>(magnitude * radix + digit);
+    }
+  }
+
+  if (it == digits) {
+    return { first, std::errc::invalid_argument };
+  }
+  if (overflow) {
+    return { it, std::errc::result_out_of_range };
+  }
+  value = negative ? static_cast<T>(unsigned_type{} - magnitude) : static_cast<T>(magnitude);
+  return { it, std::errc{} };
+}
+
+// -- swar decimal parsing, eight characters per 64 bit word with the first one in the low byte
+
+template <std::size_t Count>
+[[nodiscard]] constexpr auto
+swar_all_digits(std::uint64_t word) noexcept -> bool
+{
+  constexpr auto ones = std::uint64_t{ 0x0101010101010101 } >> (8 * (8 - Count));
+  return (word & (0xF0 * ones)) == 0x30 * ones
+         && ((word + 0x06 * ones) & (0xF0 * ones)) == 0x30 * ones;
+}
+
+[[nodiscard]] constexpr auto
+swar_parse4(std::uint64_t word) noexcept -> std::uint64_t
+{
+  word -= 0x30303030;
+  word = word * 10 + (word >> 8);
+  return (word & 0xFF) * 100 + ((word >> 16) & 0xFF);
+}
+
+[[nodiscard]] constexpr auto
+swar_parse8(std::uint64_t word) noexcept -> std::uint64_t
+{
+  // pairs of digits, then four digits, then all eight
+  word -= 0x3030303030303030;
+  word = word * 10 + (word >> 8);
+  return (((word & 0x000000FF000000FF) * (100 + (1000000ull << 32)))
+          + (((word >> 16) & 0x000000FF000000FF) * (1 + (10000ull << 32))))
+         >> 32;
+}
+
+// exactly `Width` decimal digits
+template <std::size_t Width>
+[[nodiscard]] constexpr auto
+parse_digits(char const* ptr, std::uint64_t& value) noexcept -> bool
+{
+  auto result = std::uint64_t{};
+  auto i = std::size_t{};
+  for (; i + 8 <= Width; i += 8) {
+    auto const word = read_word<8>(ptr + i);
+    if (!swar_all_digits<8>(word)) {
+      return false;
+    }
+    result = result * 100000000 + swar_parse8(word);
+  }
+  if constexpr (Width % 8 >= 4) {
+    auto const word = read_word<4>(ptr + i);
+    if (!swar_all_digits<4>(word)) {
+      return false;
+    }
+    result = result * 10000 + swar_parse4(word);
+    i += 4;
+  }
+  for (; i < Width; ++i) {
+    auto const digit = digit_value(ptr[i]);
+    if (digit > 9) {
+      return false;
+    }
+    result = result * 10 + digit;
+  }
+  value = result;
+  return true;
+}
+
+[[nodiscard]] constexpr auto
+digit_run(char const* first, char const* last) noexcept -> char const*
+{
+  for (; last - first >= 8 && swar_all_digits<8>(read_word<8>(first)); first += 8) {}
+  if (last - first >= 4 && swar_all_digits<4>(read_word<4>(first))) {
+    first += 4;
+  }
+  for (; first != last && is_digit(*first); ++first) {}
+  return first;
+}
+
+// the value of `count <= 19` characters known to be decimal digits
+[[nodiscard]] constexpr auto
+digits_value(char const* ptr, std::size_t count) noexcept -> std::uint64_t
+{
+  auto result = std::uint64_t{};
+  for (; count >= 8; ptr += 8, count -= 8) {
+    result = result * 100000000 + swar_parse8(read_word<8>(ptr));
+  }
+  if (count >= 4) {
+    result = result * 10000 + swar_parse4(read_word<4>(ptr));
+    ptr += 4;
+    count -= 4;
+  }
+  for (; count > 0; ++ptr, --count) {
+    result = result * 10 + static_cast<std::uint64_t>(*ptr - '0');
+  }
+  return result;
+}
+
+} // namespace detail
+
+// the shortest string of `Value` in `Base` that `std::from_chars` reads back, a fixed string of
+// exactly that length. enumerations are spelled by their underlying value, floating point values
+// are decimal and chosen like `std::to_chars(first, last, value)` does
+MTP_EXPORT template <auto Value, int Base = 10, typename CharT = char>
+  requires((std::integral<decltype(Value)> && !std::same_as<decltype(Value), bool>)
+           || std::is_enum_v<decltype(Value)> || std::floating_point<decltype(Value)>)
+[[nodiscard]] consteval auto
+to_fixed_string() noexcept
+{
+  static_assert(Base >= 2 && Base <= 36, "mtp::to_fixed_string: base must be in [2, 36]");
+
+  constexpr auto number = detail::number_chars_v<Value, Base>;
+  return basic_fixed_string<CharT, number.size>{ number.chars.begin(),
+                                                 number.chars.begin() + number.size };
+}
+
+// the integer spelled by all of `Str`, as read by `std::from_chars`. anything else does not compile
+MTP_EXPORT template <std::integral T, basic_fixed_string Str, int Base = 10>
+  requires(!std::same_as<T, bool>)
+[[nodiscard]] consteval auto
+parse() noexcept -> T
+{
+  static_assert(Base >= 2 && Base <= 36, "mtp::parse: base must be in [2, 36]");
+
+  auto const str = Str;
+  auto value = T{};
+  auto const [ptr, ec] = detail::parse_integer(str.begin(), str.end(), value, Base);
+  if (ec == std::errc::result_out_of_range) {
+    detail::parse_out_of_range();
+  }
+  else if (ec != std::errc{} || ptr != str.end()) {
+    detail::parse_invalid_number();
+  }
+  return value;
+}
+
+// `std::from_chars` for integers with the string as a view
+MTP_EXPORT template <std::integral T>
+  requires(!std::same_as<T, bool>)
+constexpr auto
+from_chars(std::string_view str, T& value, int base = 10) noexcept -> std::from_chars_result
+{
+  MTP_EXPECTS(base >= 2 && base <= 36);
+
+  auto const* const first = str.data();
+  auto const* const last = first + str.size();
+  if (base != 10 || sizeof(T) > sizeof(std::uint64_t)) {
+    auto const [ptr, ec] = detail::parse_integer(first, last, value, base);
+    return { ptr, ec };
+  }
+
+  using unsigned_type = std::make_unsigned_t<T>;
+
+  auto const* it = first;
+  auto negative = false;
+  if constexpr (std::is_signed_v<T>) {
+    if (it != last && *it == '-') {
+      negative = true;
+      ++it;
+    }
+  }
+
+  auto const* const end = detail::digit_run(it, last);
+  if (end == it) {
+    return { first, std::errc::invalid_argument };
+  }
+  for (; *it == '0' && it + 1 != end; ++it) {}
+
+  // up to 19 digits fit in 64 bits, a twentieth needs checking
+  auto const count = static_cast<std::size_t>(end - it);
+  if (count > std::numeric_limits<std::uint64_t>::digits10 + 1) {
+    return { end, std::errc::result_out_of_range };
+  }
+  auto magnitude = std::uint64_t{};
+  if (count <= std::numeric_limits<std::uint64_t>::digits10) {
+    magnitude = detail::digits_value(it, count);
+  }
+  else {
+    magnitude = detail::digits_value(it, count - 1);
+    auto const digit = static_cast<std::uint64_t>(end[-1] - '0');
+    if (magnitude > (std::numeric_limits<std::uint64_t>::max() - digit) / 10) {
+      return { end, std::errc::result_out_of_range };
+    }
+    magnitude = magnitude * 10 + digit;
+  }
+
+  auto const limit =
+      static_cast<std::uint64_t>(std::numeric_limits<T>::max()) + (negative ? 1u : 0u);
+  if (magnitude > limit) {
+    return { end, std::errc::result_out_of_range };
+  }
+  auto const bits = static_cast<unsigned_type>(magnitude);
+  value = negative ? static_cast<T>(static_cast<unsigned_type>(unsigned_type{} - bits))
+                   : static_cast<T>(bits);
+  return { end, std::errc{} };
+}
+
+// exactly `Width` decimal digits at the front of `str` without a sign, as found in fixed width
+// fields such as dates and timestamps
+MTP_EXPORT template <std::size_t Width, std::integral T>
+  requires(!std::same_as<T, bool> && Width > 0
+           && Width <= std::numeric_limits<std::uint64_t>::digits10)
+constexpr auto
+from_chars(std::string_view str, T& value) noexcept -> std::from_chars_result
+{
+  auto const* const first = str.data();
+  auto digits = std::uint64_t{};
+  if (str.size() < Width || !detail::parse_digits<Width>(first, digits)) {
+    return { first, std::errc::invalid_argument };
+  }
+  if constexpr (Width > std::numeric_limits<T>::digits10) {
+    if (digits > static_cast<std::uint64_t>(std::numeric_limits<T>::max())) {
+      return { first + Width, std::errc::result_out_of_range };
+    }
+  }
+  value = static_cast<T>(digits);
+  return { first + Width, std::errc{} };
+}
+
+// -------------------------------------------------------------------------------------------------
+
+// compile time transformations of a fixed string given as a template argument. each result is a
+// fixed string of exactly the length it needs, with the character type and layout of the source,
+// and can itself be a template argument
+
+namespace detail {
+
+template <typename CharT>
+inline constexpr basic_fixed_string<CharT, 6> whitespace_v{ CharT{ ' ' },  CharT{ '\t' },
+                                                            CharT{ '\n' }, CharT{ '\v' },
+                                                            CharT{ '\f' }, CharT{ '\r' } };
+
+// the first position and the length of `Str` once characters in `Chars` are dropped from the front
+// and the back as asked
+template <basic_fixed_string Str, basic_fixed_string Chars, bool Left, bool Right>
+inline constexpr auto trim_bounds_v = [] {
+  auto const str = Str;
+  auto const chars = Chars;
+  auto first = std::size_t{};
+  auto last = str.size();
+  if constexpr (Left) {
+    for (; first != last && chars.view().find(str[first]) != npos; ++first) {}
+  }
+  if constexpr (Right) {
+    for (; last != first && chars.view().find(str[last - 1]) != npos; --last) {}
+  }
+  return std::pair{ first, last - first };
+}();
+
+template <basic_fixed_string Str, basic_fixed_string From>
+inline constexpr auto occurrences_v = [] {
+  auto const str = Str;
+  auto const from = From;
+  auto count = std::size_t{};
+  for (auto pos = str.view().find(from.view()); pos != npos;
+       pos = str.view().find(from.view(), pos + from.size())) {
+    ++count;
+  }
+  return count;
+}();
+
+// the first position and the length of each part of `Str` between separators
+template <basic_fixed_string Str, basic_fixed_string Sep>
+inline constexpr auto split_bounds_v = [] {
+  auto const str = Str;
+  auto const sep = Sep;
+  std::array<std::pair<std::size_t, std::size_t>, occurrences_v<Str, Sep> + 1> parts = {};
+  auto first = std::size_t{};
+  for (auto& part : parts) {
+    auto const last = std::min(str.view().find(sep.view(), first), str.size());
+    part = { first, last - first };
+    first = last + sep.size();
+  }
+  return parts;
+}();
+
+template <basic_fixed_string Str, typename Transform>
+consteval auto
+transform_chars(Transform transform) noexcept
+{
+  using fixed_string_type = decltype(Str);
+  using char_type = typename fixed_string_type::value_type;
+
+  auto const str = Str;
+  char_type chars[str.size() + 1] = {};
+  for (auto i = std::size_t{}; i != str.size(); ++i) {
+    chars[i] = transform(str, i);
+  }
+  return basic_fixed_string<char_type, str.size(), typename fixed_string_type::layout_type>{
+    chars, chars + str.size()
+  };
+}
+
+} // namespace detail
+
+// `Len` characters of `Str` from `Pos` on, or all of them up to the end
+MTP_EXPORT template <basic_fixed_string Str, std::size_t Pos, std::size_t Len = detail::npos>
+[[nodiscard]] consteval auto
+substr() noexcept
+{
+  static_assert(Pos <= Str.size(), "mtp::substr: position is out of range");
+
+  using fixed_string_type = decltype(Str);
+  using char_type = typename fixed_string_type::value_type;
+  constexpr auto count = std::min(Len, Str.size() - Pos);
+
+  auto const str = Str;
+  return basic_fixed_string<char_type, count, typename fixed_string_type::layout_type>{
+    str.begin() + Pos, str.begin() + Pos + count
+  };
+}
+
+// `Str` without the characters in `Chars` at both ends, white space by default
+MTP_EXPORT template <basic_fixed_string Str,
+                     basic_fixed_string Chars =
+                         detail::whitespace_v<typename decltype(Str)::value_type>>
+[[nodiscard]] consteval auto
+trim() noexcept
+{
+  constexpr auto bounds = detail::trim_bounds_v<Str, Chars, true, true>;
+  return substr<Str, bounds.first, bounds.second>();
+}
+
+MTP_EXPORT template <basic_fixed_string Str,
+                     basic_fixed_string Chars =
+                         detail::whitespace_v<typename decltype(Str)::value_type>>
+[[nodiscard]] consteval auto
+trim_left() noexcept
+{
+  constexpr auto bounds = detail::trim_bounds_v<Str, Chars, true, false>;
+  return substr<Str, bounds.first, bounds.second>();
+}
+
+MTP_EXPORT template <basic_fixed_string Str,
+                     basic_fixed_string Chars =
+                         detail::whitespace_v<typename decltype(Str)::value_type>>
+[[nodiscard]] consteval auto
+trim_right() noexcept
+{
+  constexpr auto bounds = detail::trim_bounds_v<Str, Chars, false, true>;
+  return substr<Str, bounds.first, bounds.second>();
+}
+
+// `Str` with every occurrence of `From` replaced by `To`, left to right without overlaps
+MTP_EXPORT template <basic_fixed_string Str, basic_fixed_string From, basic_fixed_string To>
+  requires(std::same_as<typename decltype(Str)::value_type, typename decltype(From)::value_type>
+           && std::same_as<typename decltype(Str)::value_type, typename decltype(To)::value_type>)
+[[nodiscard]] consteval auto
+replace() noexcept
+{
+  static_assert(From.size() != 0, "mtp::replace: the replaced string must not be empty");
+
+  using fixed_string_type = decltype(Str);
+  using char_type = typename fixed_string_type::value_type;
+  constexpr auto count = detail::occurrences_v<Str, From>;
+  constexpr auto size = Str.size() - count * From.size() + count * To.size();
+
+  auto const str = Str;
+  auto const from = From;
+  auto const to = To;
+  char_type chars[size + 1] = {};
+  auto* out = chars;
+  auto first = std::size_t{};
+  for (auto pos = str.view().find(from.view()); pos != detail::npos;
+       pos = str.view().find(from.view(), first)) {
+    out = std::ranges::copy(str.begin() + first, str.begin() + pos, out).out;
+    out = std::ranges::copy(to, out).out;
+    first = pos + from.size();
+  }
+  out = std::ranges::copy(str.begin() + first, str.end(), out).out;
+  return basic_fixed_string<char_type, size, typename fixed_string_type::layout_type>{ chars, out };
+}
+
+// the parts of `Str` between occurrences of `Sep` as a tuple of fixed strings. there is always one
+// more part than separators, so empty parts are kept
+MTP_EXPORT template <basic_fixed_string Str, basic_fixed_string Sep>
+  requires(std::same_as<typename decltype(Str)::value_type, typename decltype(Sep)::value_type>)
+[[nodiscard]] consteval auto
+split() noexcept
+{
+  static_assert(Sep.size() != 0, "mtp::split: the separator must not be empty");
+
+  constexpr auto& parts = detail::split_bounds_v<Str, Sep>;
+  return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+    return std::tuple{ substr<Str, parts[Is].first, parts[Is].second>()... };
+  }(std::make_index_sequence<parts.size()>{});
+}
+
+MTP_EXPORT template <basic_fixed_string Str, typename decltype(Str)::value_type Sep>
+[[nodiscard]] consteval auto
+split() noexcept
+{
+  return split<Str, basic_fixed_string<typename decltype(Str)::value_type, 1>{ Sep }>();
+}
+
+// ascii letters in upper case, other characters are kept
+MTP_EXPORT template <basic_fixed_string Str>
+[[nodiscard]] consteval auto
+to_upper() noexcept
+{
+  return detail::transform_chars<Str>([](auto const& str, std::size_t i) {
+    auto const ch = str[i];
+    return ch >= 'a' && ch <= 'z' ? static_cast<decltype(ch)>(ch - 'a' + 'A') : ch;
+  });
+}
+
+// ascii letters in lower case, other characters are kept
+MTP_EXPORT template <basic_fixed_string Str>
+[[nodiscard]] consteval auto
+to_lower() noexcept
+{
+  return detail::transform_chars<Str>([](auto const& str, std::size_t i) {
+    auto const ch = str[i];
+    return ch >= 'A' && ch <= 'Z' ? static_cast<decltype(ch)>(ch - 'A' + 'a') : ch;
+  });
+}
+
+// the characters of `Str` back to front, code unit by code unit
+MTP_EXPORT template <basic_fixed_string Str>
+[[nodiscard]] consteval auto
+reverse() noexcept
+{
+  return detail::transform_chars<Str>(
+      [](auto const& str, std::size_t i) { return str[str.size() - 1 - i]; });
+}
+
+// -------------------------------------------------------------------------------------------------
+
+// ascii case insensitive comparison and hashing. letters are folded to lower case as they are read,
+// a word or a vector at a time, so no folded copy is made, and other characters compare exactly. a
+// fixed string given as a template argument is folded at compile time. `ihash` of a string is the
+// `hash` of its folded form
+
+namespace detail {
+
+#ifdef MTP_HAS_SSE2
+// 'A' to 'Z' are the only bytes that land below -102 once shifted by 0x3f
+[[nodiscard]] inline auto
+fold_sse2(__m128i bytes) noexcept -> __m128i
+{
+  auto const shifted = _mm_add_epi8(bytes, _mm_set1_epi8(0x3f));
+  auto const upper = _mm_cmplt_epi8(shifted, _mm_set1_epi8(-102));
+  return _mm_or_si128(bytes, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+
+template <bool FoldRhs>
+[[nodiscard]] inline auto
+idiff_sse2(unsigned char const* lhs, unsigned char const* rhs) noexcept -> std::uint32_t
+{
+  auto const a = fold_sse2(_mm_loadu_si128(reinterpret_cast<__m128i const*>(lhs)));
+  auto b = _mm_loadu_si128(reinterpret_cast<__m128i const*>(rhs));
+  if constexpr (FoldRhs) {
+    b = fold_sse2(b);
+  }
+  return ~static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b))) & 0xFFFFu;
+}
+#endif
+
+#ifdef MTP_HAS_AVX2
+[[nodiscard]] inline auto
+fold_avx2(__m256i bytes) noexcept -> __m256i
+{
+  auto const shifted = _mm256_add_epi8(bytes, _mm256_set1_epi8(0x3f));
+  auto const upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(-102), shifted);
+  return _mm256_or_si256(bytes, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+
+template <bool FoldRhs>
+[[nodiscard]] inline auto
+idiff_avx2(unsigned char const* lhs, unsigned char const* rhs) noexcept -> std::uint32_t
+{
+  auto const a = fold_avx2(_mm256_loadu_si256(reinterpret_cast<__m256i const*>(lhs)));
+  auto b = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(rhs));
+  if constexpr (FoldRhs) {
+    b = fold_avx2(b);
+  }
+  return ~static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+}
+#endif
+
+// offset of the first character that differs once ascii letters are in lower case, or `count`.
+// `rhs` is taken as already folded unless `FoldRhs`. past one block the final block is loaded at
+// `count - width` and overlaps the previous one, as in `equal_bytes`
+template <bool FoldRhs, typename CharT>
+[[nodiscard]] constexpr auto
+imismatch(CharT const* lhs, CharT const* rhs, std::size_t count) noexcept -> std::size_t
+{
+  if (!std::is_constant_evaluated()) {
+#ifdef MTP_HAS_SSE2
+    if constexpr (sizeof(CharT) == 1) {
+      auto const* const a = reinterpret_cast<unsigned char const*>(lhs);
+      auto const* const b = reinterpret_cast<unsigned char const*>(rhs);
+#  ifdef MTP_HAS_AVX2
+      if (count >= 32) {
+        for (std::size_t i = 0; i < count - 32; i += 32) {
+          if (auto const diff = idiff_avx2<FoldRhs>(a + i, b + i); diff != 0) {
+            return i + static_cast<std::size_t>(std::countr_zero(diff));
+          }
+        }
+        auto const diff = idiff_avx2<FoldRhs>(a + count - 32, b + count - 32);
+        return diff != 0 ? count - 32 + static_cast<std::size_t>(std::countr_zero(diff)) : count;
+      }
+#  endif
+      if (count >= 16) {
+        for (std::size_t i = 0; i < count - 16; i += 16) {
+          if (auto const diff = idiff_sse2<FoldRhs>(a + i, b + i); diff != 0) {
+            return i + static_cast<std::size_t>(std::countr_zero(diff));
+          }
+        }
+        auto const diff = idiff_sse2<FoldRhs>(a + count - 16, b + count - 16);
+        return diff != 0 ? count - 16 + static_cast<std::size_t>(std::countr_zero(diff)) : count;
+      }
+    }
+#endif
+
+    constexpr auto word = 8 / sizeof(CharT);
+    auto const lane = [](std::uint64_t diff) {
+      return static_cast<std::size_t>(std::countr_zero(diff)) / (8 * sizeof(CharT));
+    };
+    if (count >= word) {
+      for (std::size_t i = 0; i < count - word; i += word) {
+        if (auto const diff = read_word<word, true>(lhs + i) ^ read_word<word, FoldRhs>(rhs + i);
+            diff != 0) {
+          return i + lane(diff);
+        }
+      }
+      auto const diff =
+          read_word<word, true>(lhs + count - word) ^ read_word<word, FoldRhs>(rhs + count - word);
+      return diff != 0 ? count - word + lane(diff) : count;
+    }
+  }
+
+  for (std::size_t i = 0; i < count; ++i) {
+    if (ascii_lower(lhs[i]) != (FoldRhs ? ascii_lower(rhs[i]) : rhs[i])) {
+      return i;
+    }
+  }
+  return count;
+}
+
+template <bool FoldRhs, typename CharT>
+[[nodiscard]] constexpr auto
+icompare(CharT const* lhs, std::size_t lhs_size, CharT const* rhs, std::size_t rhs_size) noexcept
+    -> std::weak_ordering
+{
+  using unsigned_type = std::make_unsigned_t<CharT>;
+
+  auto const common = lhs_size < rhs_size ? lhs_size : rhs_size;
+  auto const i = imismatch<FoldRhs>(lhs, rhs, common);
+  if (i == common) {
+    return lhs_size <=> rhs_size;
+  }
+  auto const a = static_cast<unsigned_type>(ascii_lower(lhs[i]));
+  auto const b = static_cast<unsigned_type>(FoldRhs ? ascii_lower(rhs[i]) : rhs[i]);
+  return a <=> b;
+}
+
+template <basic_fixed_string Str>
+inline constexpr auto folded_v = to_lower<Str>();
+
+} // namespace detail
+
+// ascii case insensitive equality of two strings of the same character type
+MTP_EXPORT template <concepts::string_view_like L, concepts::string_view_like R>
+  requires(std::same_as<typename L::value_type, typename R::value_type>)
+[[nodiscard]] constexpr auto
+iequals(L const& lhs, R const& rhs) noexcept -> bool
+{
+  auto const a = std::basic_string_view<typename L::value_type>(lhs);
+  auto const b = std::basic_string_view<typename R::value_type>(rhs);
+  return a.size() == b.size() && detail::imismatch<true>(a.data(), b.data(), a.size()) == a.size();
+}
+
+// ascii case insensitive equality with a string known at compile time, which is folded ahead
+MTP_EXPORT template <basic_fixed_string Str>
+[[nodiscard]] constexpr auto
+iequals(std::basic_string_view<typename decltype(Str)::value_type> str) noexcept -> bool
+{
+  constexpr auto& folded = detail::folded_v<Str>;
+  return str.size() == folded.size()
+         && detail::imismatch<false>(str.data(), folded.data(), folded.size()) == folded.size();
+}
+
+// ascii case insensitive ordering, as if both strings had their letters in lower case
+MTP_EXPORT template <concepts::string_view_like L, concepts::string_view_like R>
+  requires(std::same_as<typename L::value_type, typename R::value_type>)
+[[nodiscard]] constexpr auto
+icompare(L const& lhs, R const& rhs) noexcept -> std::weak_ordering
+{
+  auto const a = std::basic_string_view<typename L::value_type>(lhs);
+  auto const b = std::basic_string_view<typename R::value_type>(rhs);
+  return detail::icompare<true>(a.data(), a.size(), b.data(), b.size());
+}
+
+MTP_EXPORT template <basic_fixed_string Str>
+[[nodiscard]] constexpr auto
+icompare(std::basic_string_view<typename decltype(Str)::value_type> str) noexcept
+    -> std::weak_ordering
+{
+  constexpr auto& folded = detail::folded_v<Str>;
+  return detail::icompare<false>(str.data(), str.size(), folded.data(), folded.size());
+}
+
+MTP_EXPORT struct ihash
+{
+  using is_transparent = void;
+
+  template <concepts::string_view_like S>
+  [[nodiscard]] constexpr auto
+  operator()(S const& str) const noexcept -> std::size_t
+  {
+    auto const sv = std::basic_string_view<typename S::value_type>(str);
+    return static_cast<std::size_t>(detail::wyhash<true>(sv.data(), sv.size(), 0));
+  }
+};
+
+MTP_EXPORT struct iequal_to
+{
+  using is_transparent = void;
+
+  template <concepts::string_view_like L, concepts::string_view_like R>
+  [[nodiscard]] constexpr auto
+  operator()(L const& lhs, R const& rhs) const noexcept -> bool
+  {
+    return iequals(lhs, rhs);
+  }
+};
+
+MTP_EXPORT struct iless
+{
+  using is_transparent = void;
+
+  template <concepts::string_view_like L, concepts::string_view_like R>
+  [[nodiscard]] constexpr auto
+  operator()(L const& lhs, R const& rhs) const noexcept -> bool
+  {
+    return icompare(lhs, rhs) < 0;
+  }
+};
+
+MTP_EXPORT template <basic_fixed_string Str>
+inline constexpr std::size_t ihash_v = hash_v<detail::folded_v<Str>>;
+
+// -------------------------------------------------------------------------------------------------
+
+// transcoding between the unicode encodings of the character types: `char` and `char8_t` hold
+// utf-8, `char16_t` utf-16, `char32_t` utf-32 and `wchar_t` whichever of the last two fits its
+// size. input is validated as it is decoded, so overlong forms, surrogates outside of pairs and
+// code points past U+10FFFF are errors. runs of ascii are copied 16 characters at a time
+
+namespace detail {
+
+template <typename CharT>
+inline constexpr std::size_t utf_width = sizeof(CharT) == 1 ? 8 : sizeof(CharT) == 2 ? 16 : 32;
+
+// the code point at `first` and the number of code units it takes, or a length of 0 if `first`
+// does not start a valid sequence
+template <typename CharT>
+[[nodiscard]] constexpr auto
+decode_utf(CharT const* first, CharT const* last, char32_t& cp) noexcept -> std::size_t
+{
+  auto const lead = code_unit(*first);
+  if constexpr (utf_width<CharT> == 8) {
+    auto const available = static_cast<std::size_t>(last - first);
+    auto const continuation = [&](std::size_t i, std::size_t low, std::size_t high) {
+      return i < available && code_unit(first[i]) >= low && code_unit(first[i]) <= high;
+    };
+    auto const payload = [&](std::size_t i) { return code_unit(first[i]) & 0x3Fu; };
+
+    if (lead < 0x80) {
+      cp = static_cast<char32_t>(lead);
+      return 1;
+    }
+    if (lead >= 0xC2 && lead <= 0xDF && continuation(1, 0x80, 0xBF)) {
+      cp = static_cast<char32_t>(((lead & 0x1Fu) << 6) | payload(1));
+      return 2;
+    }
+    if (lead >= 0xE0 && lead <= 0xEF
+        && continuation(1, lead == 0xE0 ? 0xA0 : 0x80, lead == 0xED ? 0x9F : 0xBF)
+        && continuation(2, 0x80, 0xBF)) {
+      cp = static_cast<char32_t>(((lead & 0x0Fu) << 12) | (payload(1) << 6) | payload(2));
+      return 3;
+    }
+    if (lead >= 0xF0 && lead <= 0xF4
+        && continuation(1, lead == 0xF0 ? 0x90 : 0x80, lead == 0xF4 ? 0x8F : 0xBF)
+        && continuation(2, 0x80, 0xBF) && continuation(3, 0x80, 0xBF)) {
+      cp = static_cast<char32_t>(((lead & 0x07u) << 18) | (payload(1) << 12) | (payload(2) << 6)
+                                 | payload(3));
+      return 4;
+    }
+    return 0;
+  }
+  else if constexpr (utf_width<CharT> == 16) {
+    if (lead < 0xD800 || lead > 0xDFFF) {
+      cp = static_cast<char32_t>(lead);
+      return 1;
+    }
+    if (lead <= 0xDBFF && last - first >= 2 && code_unit(first[1]) >= 0xDC00
+        && code_unit(first[1]) <= 0xDFFF) {
+      auto const trail = code_unit(first[1]);
+      cp = static_cast<char32_t>(0x10000 + ((lead - 0xD800) << 10) + (trail - 0xDC00));
+      return 2;
+    }
+    return 0;
+  }
+  else {
+    if (lead > 0x10FFFF || (lead >= 0xD800 && lead <= 0xDFFF)) {
+      return 0;
+    }
+    cp = static_cast<char32_t>(lead);
+    return 1;
+  }
+}
+
+template <typename CharT>
+[[nodiscard]] constexpr auto
+encoded_length(char32_t cp) noexcept -> std::size_t
+{
+  if constexpr (utf_width<CharT> == 8) {
+    return cp < 0x80 ? 1 : cp < 0x800 ? 2 : cp < 0x10000 ? 3 : 4;
+  }
+  else if constexpr (utf_width<CharT> == 16) {
+    return cp < 0x10000 ? 1 : 2;
+  }
+  else {
+    return 1;
+  }
+}
+
+template <typename CharT>
+constexpr auto
+encode_utf(char32_t cp, CharT* out) noexcept -> CharT*
+{
+  auto const unit = [](std::uint32_t value) { return static_cast<CharT>(value); };
+  auto const value = static_cast<std::uint32_t>(cp);
+  if constexpr (utf_width<CharT> == 8) {
+    if (value < 0x80) {
+      *out++ = unit(value);
+    }
+    else if (value < 0x800) {
+      *out++ = unit(0xC0 | (value >> 6));
+      *out++ = unit(0x80 | (value & 0x3F));
+    }
+    else if (value < 0x10000) {
+      *out++ = unit(0xE0 | (value >> 12));
+      *out++ = unit(0x80 | ((value >> 6) & 0x3F));
+      *out++ = unit(0x80 | (value & 0x3F));
+    }
+    else {
+      *out++ = unit(0xF0 | (value >> 18));
+      *out++ = unit(0x80 | ((value >> 12) & 0x3F));
+      *out++ = unit(0x80 | ((value >> 6) & 0x3F));
+      *out++ = unit(0x80 | (value & 0x3F));
+    }
+  }
+  else if constexpr (utf_width<CharT> == 16) {
+    if (value < 0x10000) {
+      *out++ = unit(value);
+    }
+    else {
+      *out++ = unit(0xD800 + ((value - 0x10000) >> 10));
+      *out++ = unit(0xDC00 + ((value - 0x10000) & 0x3FF));
+    }
+  }
+  else {
+    *out++ = unit(value);
+  }
+  return out;
+}
+
+#ifdef MTP_HAS_SSE2
+// stores 16 ascii characters held one per byte as `To`
+template <typename To>
+inline auto
+store_ascii(__m128i bytes, To* out) noexcept -> void
+{
+  auto* const dst = reinterpret_cast<__m128i*>(out);
+  auto const zero = _mm_setzero_si128();
+  if constexpr (sizeof(To) == 1) {
+    _mm_storeu_si128(dst, bytes);
+  }
+  else if constexpr (sizeof(To) == 2) {
+    _mm_storeu_si128(dst, _mm_unpacklo_epi8(bytes, zero));
+    _mm_storeu_si128(dst + 1, _mm_unpackhi_epi8(bytes, zero));
+  }
+  else {
+    auto const low = _mm_unpacklo_epi8(bytes, zero);
+    auto const high = _mm_unpackhi_epi8(bytes, zero);
+    _mm_storeu_si128(dst, _mm_unpacklo_epi16(low, zero));
+    _mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(low, zero));
+    _mm_storeu_si128(dst + 2, _mm_unpacklo_epi16(high, zero));
+    _mm_storeu_si128(dst + 3, _mm_unpackhi_epi16(high, zero));
+  }
+}
+
+// the next 16 characters as one byte each if all of them are ascii
+template <typename From>
+inline auto
+load_ascii(From const* in, __m128i& bytes) noexcept -> bool
+{
+  auto const* const src = reinterpret_cast<__m128i const*>(in);
+  if constexpr (sizeof(From) == 1) {
+    bytes = _mm_loadu_si128(src);
+    return _mm_movemask_epi8(bytes) == 0;
+  }
+  else if constexpr (sizeof(From) == 2) {
+    auto const a = _mm_loadu_si128(src);
+    auto const b = _mm_loadu_si128(src + 1);
+    auto const high = _mm_and_si128(_mm_or_si128(a, b), _mm_set1_epi16(-0x80));
+    bytes = _mm_packus_epi16(a, b);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(high, _mm_setzero_si128())) == 0xFFFF;
+  }
+  else {
+    auto const a = _mm_loadu_si128(src);
+    auto const b = _mm_loadu_si128(src + 1);
+    auto const c = _mm_loadu_si128(src + 2);
+    auto const d = _mm_loadu_si128(src + 3);
+    auto const all = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+    auto const high = _mm_and_si128(all, _mm_set1_epi32(-0x80));
+    bytes = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(high, _mm_setzero_si128())) == 0xFFFF;
+  }
+}
+#endif
+
+// copies the run of ascii at `first` 16 characters at a time, as far as whole blocks fit in both
+// ranges, and returns the number of characters copied
+template <typename From, typename To>
+inline auto
+copy_ascii([[maybe_unused]] From const* first, [[maybe_unused]] std::size_t in_size,
+           [[maybe_unused]] To* out, [[maybe_unused]] std::size_t out_size) noexcept -> std::size_t
+{
+  auto count = std::size_t{};
+#ifdef MTP_HAS_SSE2
+  auto bytes = __m128i{};
+  for (; in_size - count >= 16 && out_size - count >= 16 && load_ascii(first + count, bytes);
+       count += 16) {
+    store_ascii(bytes, out + count);
+  }
+#endif
+  return count;
+}
+
+template <typename To, typename From>
+[[nodiscard]] constexpr auto
+transcoded_size(From const* first, From const* last) noexcept -> std::size_t
+{
+  auto size = std::size_t{};
+  auto cp = char32_t{};
+  while (first != last) {
+    auto const length = decode_utf(first, last, cp);
+    if (length == 0) {
+      return npos;
+    }
+    first += length;
+    size += encoded_length<To>(cp);
+  }
+  return size;
+}
+
+inline auto
+transcode_invalid_sequence() -> void
+{}
+
+template <typename To, basic_fixed_string Str>
+inline constexpr std::size_t transcoded_size_v = [] {
+  auto const str = Str;
+  auto const size = transcoded_size<To>(str.begin(), str.end());
+  if (size == npos) {
+    transcode_invalid_sequence();
+  }
+  return size;
+}();
+
+} // namespace detail
+
+MTP_EXPORT template <typename FromCharT, typename ToCharT>
+struct transcode_result
+{
+  FromCharT const* in;
+  ToCharT* out;
+  std::errc ec;
+};
+
+// the number of `ToCharT` that `str` transcodes to, or `npos` if it is not valid
+MTP_EXPORT template <concepts::char_type ToCharT, concepts::char_type FromCharT>
+[[nodiscard]] constexpr auto
+transcoded_size(std::basic_string_view<FromCharT> str) noexcept -> std::size_t
+{
+  return detail::transcoded_size<ToCharT>(str.data(), str.data() + str.size());
+}
+
+// transcodes `str` into `[first, last)`. on success `in` is the end of `str` and `out` the end of
+// the output. otherwise `ec` is `std::errc::illegal_byte_sequence` with `in` at the invalid
+// sequence, or `std::errc::value_too_large` with `in` at the first code point that did not fit,
+// and everything before `in` is written
+MTP_EXPORT template <concepts::char_type ToCharT, concepts::char_type FromCharT>
+constexpr auto
+transcode(std::basic_string_view<FromCharT> str, ToCharT* first, ToCharT* last) noexcept
+    -> transcode_result<FromCharT, ToCharT>
+{
+  auto const* in = str.data();
+  auto const* const in_last = in + str.size();
+  auto* out = first;
+  auto cp = char32_t{};
+  while (in != in_last) {
+    if (!std::is_constant_evaluated()) {
+      auto const count = detail::copy_ascii(in, static_cast<std::size_t>(in_last - in), out,
+                                            static_cast<std::size_t>(last - out));
+      in += count;
+      out += count;
+      if (in == in_last) {
+        break;
+      }
+    }
+    auto const length = detail::decode_utf(in, in_last, cp);
+    if (length == 0) {
+      return { in, out, std::errc::illegal_byte_sequence };
+    }
+    if (static_cast<std::size_t>(last - out) < detail::encoded_length<ToCharT>(cp)) {
+      return { in, out, std::errc::value_too_large };
+    }
+    in += length;
+    out = detail::encode_utf(cp, out);
+  }
+  return { in, out, std::errc{} };
+}
+
+// transcodes `str` into `out`, which holds whatever was written when the result is an error
+MTP_EXPORT template <concepts::char_type ToCharT, std::size_t Capacity,
+                     concepts::char_type FromCharT>
+constexpr auto
+transcode(std::basic_string_view<FromCharT> str,
+          basic_inplace_string<ToCharT, Capacity>& out) noexcept
+    -> transcode_result<FromCharT, ToCharT>
+{
+  auto result = transcode_result<FromCharT, ToCharT>{};
+  out.resize_and_overwrite(Capacity, [&](ToCharT* first, std::size_t) {
+    result = transcode(str, first, first + Capacity);
+    return static_cast<std::size_t>(result.out - first);
+  });
+  return result;
+}
+
+// `Str` in the encoding of `ToCharT`, a fixed string of exactly the transcoded length. an invalid
+// `Str` does not compile
+MTP_EXPORT template <concepts::char_type ToCharT, basic_fixed_string Str>
+[[nodiscard]] consteval auto
+transcode() noexcept
+{
+  constexpr auto size = detail::transcoded_size_v<ToCharT, Str>;
+
+  auto const str = Str;
+  ToCharT chars[size + 1] = {};
+  transcode(str.view(), chars, chars + size);
+  return basic_fixed_string<ToCharT, size>{ chars, chars + size };
+}
+
+// -------------------------------------------------------------------------------------------------
+
+// symbols are names known at compile time that are handled as dense 32 bit ids at run time. each
+// `symbol<Name>` takes the next free id the first time it is asked for one and the registry maps
+// ids back to names. `symbol_table<Names...>` finds the ids of a closed set of names through a
+// perfect hash table. ids are unique within one linked program, a shared library counts its own
+
+#ifndef MTP_SYMBOL_CAPACITY
+#  define MTP_SYMBOL_CAPACITY 4096
+#endif
+
+namespace detail {
+
+struct symbol_registry
+{
+  std::array<std::string_view, MTP_SYMBOL_CAPACITY> names = {};
+  std::atomic<std::uint32_t> size = 0;
+};
+
+inline constinit auto symbol_names = symbol_registry{};
+
+[[nodiscard]] inline auto
+intern_symbol(std::string_view name) MTP_NOEXCEPT -> std::uint32_t
+{
+  auto const id = symbol_names.size.fetch_add(1, std::memory_order_relaxed);
+#ifdef MTP_NO_EXCEPTIONS
+  MTP_EXPECTS(id < symbol_names.names.size());
+#else
+  if (id >= symbol_names.names.size()) {
+    throw std::length_error("mtp::symbol: more than MTP_SYMBOL_CAPACITY symbols");
+  }
+#endif
+  symbol_names.names[id] = name;
+  return id;
+}
+
+} // namespace detail
+
+MTP_EXPORT class symbol_id
+{
+public:
+  static constexpr auto invalid = std::numeric_limits<std::uint32_t>::max();
+
+  [[nodiscard]] constexpr symbol_id() noexcept = default;
+
+  [[nodiscard]] explicit constexpr symbol_id(std::uint32_t value) noexcept
+      : _value{ value }
+  {}
+
+  [[nodiscard]] constexpr auto
+  value() const noexcept -> std::uint32_t
+  {
+    return _value;
+  }
+
+  [[nodiscard]] constexpr auto
+  valid() const noexcept -> bool
+  {
+    return _value != invalid;
+  }
+
+  // the name the id was given for, empty for ids that were not
+  [[nodiscard]] auto
+  name() const noexcept -> std::string_view
+  {
+    return _value < detail::symbol_names.names.size() ? detail::symbol_names.names[_value]
+                                                       : std::string_view{};
+  }
+
+  [[nodiscard]] friend constexpr auto
+  operator==(symbol_id lhs, symbol_id rhs) noexcept -> bool = default;
+
+#ifdef MTP_HAS_THREE_WAY_COMPARE
+  [[nodiscard]] friend constexpr auto
+  operator<=>(symbol_id lhs, symbol_id rhs) noexcept -> std::strong_ordering = default;
+#endif
+
+  friend auto
+  operator<<(std::ostream& os, symbol_id id) noexcept -> std::ostream&
+  {
+    return os << id.name();
+  }
+
+private:
+  std::uint32_t _value = invalid;
+};
+
+MTP_EXPORT template <basic_fixed_string Name>
+  requires std::same_as<typename decltype(Name)::value_type, char>
+struct symbol
+{
+  [[nodiscard]] static constexpr auto
+  name() noexcept -> std::string_view
+  {
+    return Name.view();
+  }
+
+  [[nodiscard]] static auto
+  id() MTP_NOEXCEPT -> symbol_id
+  {
+    static auto const value = symbol_id{ detail::intern_symbol(Name.view()) };
+    return value;
+  }
+
+  [[nodiscard]] operator symbol_id() const MTP_NOEXCEPT
+  {
+    return id();
+  }
+};
+
+MTP_EXPORT template <basic_fixed_string... Names>
+  requires(sizeof...(Names) > 0
+           && (... && std::same_as<typename decltype(Names)::value_type, char>))
+class symbol_table
+{
+public:
+  static constexpr std::integral_constant<std::size_t, sizeof...(Names)> size{};
+
+  // the id of `name` if it is one of `Names...`
+  [[nodiscard]] static auto
+  find(std::string_view name) MTP_NOEXCEPT -> std::optional<symbol_id>
+  {
+    auto const i = static_map<bool, Names...>::index_of(name);
+    if (i == static_map<bool, Names...>::npos) {
+      return std::nullopt;
+    }
+    return ids()[i];
+  }
+
+  [[nodiscard]] static auto
+  ids() MTP_NOEXCEPT -> std::array<symbol_id, size()> const&
+  {
+    static auto const table = std::array{ symbol<Names>::id()... };
+    return table;
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+
+// columns of same-width codes (tickers, isins, country codes) stored as one flat buffer of records
+// without terminators. `layout::packed` records are `N` characters, `layout::simd<Width>` records
+// are zero padded to a multiple of `Width` bytes. elements are proxies converting to
+// `basic_fixed_string` and `basic_string_view`, and the bulk kernels compare several records per
+// vector instruction, writing their results as bitmaps where bit `i % 64` of word `i / 64` stands
+// for element `i`
+
+namespace detail {
+
+template <typename CharT, std::size_t N, typename Layout>
+inline constexpr std::size_t column_stride = [] {
+  constexpr auto width = layout_traits<Layout>::width;
+  if constexpr (width == 0) {
+    return N;
+  }
+  else {
+    return (N * sizeof(CharT) + width - 1) / width * width / sizeof(CharT);
+  }
+}();
+
+#ifdef MTP_HAS_SSE2
+// records narrower than a vector are compared a block of `lcm(Bytes, width)` bytes at a time: the
+// pattern repeated over one block (`repeated`) lines up with every block, the chunks' difference
+// masks are concatenated into a bit string and each record's bits are cut out of it
+template <std::size_t Bytes>
+inline constexpr std::size_t record_block =
+    Bytes / std::min(std::size_t{ 1 } << std::countr_zero(Bytes), filter_chunk::width)
+    * filter_chunk::width;
+
+// bit `r` is set iff record `r` of the block agrees with the pattern on the bits of `care`
+template <std::size_t Bytes>
+[[nodiscard]] inline auto
+match_record_block(unsigned char const* block, unsigned char const* repeated,
+                   std::uint64_t care) noexcept -> std::uint64_t
+{
+  using chunk = filter_chunk;
+  constexpr auto size = record_block<Bytes>;
+
+  // one spare word, read by the record whose bits end the last one
+  std::uint64_t diff[(size + 63) / 64 + 1] = {};
+  for (std::size_t j = 0; j < size; j += chunk::width) {
+    diff[j / 64] |= std::uint64_t{ chunk::diff(block + j, repeated + j) } << (j % 64);
+  }
+  std::uint64_t matches = 0;
+  for (std::size_t r = 0; r < size / Bytes; ++r) {
+    auto const bit = r * Bytes;
+    auto const bits =
+        (diff[bit / 64] >> (bit % 64)) | ((diff[bit / 64 + 1] << 1) << (63 - bit % 64));
+    matches |= std::uint64_t{ (bits & care) == 0 } << r;
+  }
+  return matches;
+}
+#endif
+
+// marks the records of `Bytes` bytes whose first `prefix` bytes equal those of `pattern` and
+// returns how many there are. each bitmap word is built in a register, since stores through
+// `bitmap` could alias the records. records padded to `Width` byte blocks (`Width` 0 for none) are
+// compared whole a block at a time
+template <std::size_t Bytes, std::size_t Width>
+[[nodiscard]] inline auto
+match_records(unsigned char const* records, std::size_t count, unsigned char const* pattern,
+              std::size_t prefix, std::uint64_t* bitmap) noexcept -> std::size_t
+{
+#ifdef MTP_HAS_SSE2
+  constexpr auto blocked = Bytes < filter_chunk::width;
+  [[maybe_unused]] constexpr auto per_block = blocked ? record_block<Bytes> / Bytes : 1;
+  unsigned char repeated[blocked ? record_block<Bytes> : 1];
+  if constexpr (blocked) {
+    for (std::size_t j = 0; j < record_block<Bytes>; ++j) {
+      repeated[j] = pattern[j % Bytes];
+    }
+  }
+  [[maybe_unused]] auto const care = (std::uint64_t{ 1 } << (blocked ? prefix : 0)) - 1;
+#endif
+
+  // one loop per kind of comparison, so that none is chosen per record
+  auto const mark = [&](auto match) {
+    std::size_t matches = 0;
+    for (std::size_t i = 0; i < count; i += 64) {
+      auto const* base = records + i * Bytes;
+      auto const n = std::min<std::size_t>(count - i, 64);
+      std::uint64_t word = 0;
+      std::size_t r = 0;
+#ifdef MTP_HAS_SSE2
+      if constexpr (blocked) {
+        // `per_block` is a power of two, so blocks never straddle bitmap words
+        for (; r + per_block <= n; r += per_block) {
+          word |= match_record_block<Bytes>(base + r * Bytes, repeated, care) << r;
+        }
+      }
+#endif
+      for (; r < n; ++r) {
+        word |= std::uint64_t{ match(base + r * Bytes) } << r;
+      }
+      bitmap[i / 64] = word;
+      matches += static_cast<std::size_t>(std::popcount(word));
+    }
+    return matches;
+  };
+
+  if (prefix != Bytes) {
+    return mark([&](unsigned char const* record) {
+      return std::memcmp(record, pattern, prefix) == 0;
+    });
+  }
+  if constexpr (Width != 0) {
+    return mark([&](unsigned char const* record) {
+      return equal_blocks<Bytes, Width>(record, pattern);
+    });
+  }
+  else {
+    return mark([&](unsigned char const* record) { return equal_bytes<Bytes>(record, pattern); });
+  }
+}
+
+} // namespace detail
+
+MTP_EXPORT template <typename CharT, std::size_t N, typename Layout>
+class basic_fixed_string_column
+{
+public:
+  using value_type = basic_fixed_string<CharT, N>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using layout_type = Layout;
+
+  // characters from the start of one record to the next
+  static constexpr std::integral_constant<size_type, detail::column_stride<CharT, N, Layout>>
+      stride{};
+
+  static_assert(N > 0, "mtp::basic_fixed_string_column: records must not be empty");
+
+  // an element: reads as its value, assigning to it overwrites the record
+  template <bool Const>
+  class basic_reference
+  {
+  public:
+    using pointer = std::conditional_t<Const, CharT const*, CharT*>;
+
+    [[nodiscard]] explicit constexpr basic_reference(pointer ptr) noexcept
+        : _ptr{ ptr }
+    {}
+
+    template <bool Const2>
+      requires(Const && !Const2)
+    [[nodiscard]] constexpr basic_reference(basic_reference<Const2> other) noexcept
+        : _ptr{ other.data() }
+    {}
+
+    [[nodiscard]] constexpr basic_reference(basic_reference const&) noexcept = default;
+
+    constexpr auto
+    operator=(basic_reference const& other) const noexcept -> basic_reference const&
+      requires(!Const)
+    {
+      std::copy_n(other.data(), N, _ptr);
+      return *this;
+    }
+
+    template <typename Layout2>
+    constexpr auto
+    operator=(basic_fixed_string<CharT, N, Layout2> const& fs) const noexcept
+        -> basic_reference const&
+      requires(!Const)
+    {
+      std::copy_n(fs.data(), N, _ptr);
+      return *this;
+    }
+
+    [[nodiscard]] constexpr auto
+    data() const noexcept -> pointer
+    {
+      return _ptr;
+    }
+
+    [[nodiscard]] constexpr auto
+    view() const noexcept -> std::basic_string_view<CharT>
+    {
+      return { _ptr, N };
+    }
+
+    [[nodiscard]] constexpr
+    operator std::basic_string_view<CharT>() const noexcept
+    {
+      return view();
+    }
+
+    [[nodiscard]] constexpr
+    operator value_type() const noexcept
+    {
+      return value_type{ _ptr, _ptr + N };
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator==(basic_reference lhs, std::basic_string_view<CharT> rhs) noexcept -> bool
+    {
+      return lhs.view() == rhs;
+    }
+
+#ifdef MTP_HAS_THREE_WAY_COMPARE
+    [[nodiscard]] friend constexpr auto
+    operator<=>(basic_reference lhs, std::basic_string_view<CharT> rhs) noexcept
+        -> std::strong_ordering
+    {
+      return lhs.view() <=> rhs;
+    }
+#endif
+
+  private:
+    pointer _ptr;
+  };
+
+  using reference = basic_reference<false>;
+  using const_reference = basic_reference<true>;
+
+  template <bool Const>
+  class basic_iterator
+  {
+  public:
+    using value_type = basic_fixed_string<CharT, N>;
+    using difference_type = std::ptrdiff_t;
+    using reference = basic_reference<Const>;
+    using pointer = void;
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+
+    [[nodiscard]] constexpr basic_iterator() noexcept = default;
+
+    [[nodiscard]] explicit constexpr basic_iterator(typename reference::pointer ptr) noexcept
+        : _ptr{ ptr }
+    {}
+
+    template <bool Const2>
+      requires(Const && !Const2)
+    [[nodiscard]] constexpr basic_iterator(basic_iterator<Const2> other) noexcept
+        : _ptr{ other.base() }
+    {}
+
+    [[nodiscard]] constexpr auto
+    base() const noexcept -> typename reference::pointer
+    {
+      return _ptr;
+    }
+
+    [[nodiscard]] constexpr auto
+    operator*() const noexcept -> reference
+    {
+      return reference{ _ptr };
+    }
+
+    [[nodiscard]] constexpr auto
+    operator[](difference_type n) const noexcept -> reference
+    {
+      return *(*this + n);
+    }
+
+    constexpr auto
+    operator++() noexcept -> basic_iterator&
+    {
+      _ptr += stride;
+      return *this;
+    }
+
+    constexpr auto
+    operator++(int) noexcept -> basic_iterator
+    {
+      auto const it = *this;
+      ++*this;
+      return it;
+    }
+
+    constexpr auto
+    operator--() noexcept -> basic_iterator&
+    {
+      _ptr -= stride;
+      return *this;
+    }
+
+    constexpr auto
+    operator--(int) noexcept -> basic_iterator
+    {
+      auto const it = *this;
+      --*this;
+      return it;
+    }
+
+    constexpr auto
+    operator+=(difference_type n) noexcept -> basic_iterator&
+    {
+      _ptr += n * static_cast<difference_type>(stride());
+      return *this;
+    }
+
+    constexpr auto
+    operator-=(difference_type n) noexcept -> basic_iterator&
+    {
+      return *this += -n;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator+(basic_iterator it, difference_type n) noexcept -> basic_iterator
+    {
+      return it += n;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator+(difference_type n, basic_iterator it) noexcept -> basic_iterator
+    {
+      return it += n;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator-(basic_iterator it, difference_type n) noexcept -> basic_iterator
+    {
+      return it -= n;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator-(basic_iterator lhs, basic_iterator rhs) noexcept -> difference_type
+    {
+      return (lhs._ptr - rhs._ptr) / static_cast<difference_type>(stride());
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator==(basic_iterator, basic_iterator) noexcept -> bool = default;
+
+    [[nodiscard]] friend constexpr auto
+    operator<=>(basic_iterator, basic_iterator) noexcept = default;
+
+  private:
+    typename reference::pointer _ptr = nullptr;
+  };
+
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  [[nodiscard]] constexpr basic_fixed_string_column() noexcept = default;
+
+  // `count` elements of `N` zero characters
+  [[nodiscard]] explicit constexpr basic_fixed_string_column(size_type count)
+      : _chars(count * stride)
+  {}
+
+  [[nodiscard]] constexpr auto
+  size() const noexcept -> size_type
+  {
+    return _chars.size() / stride;
+  }
+
+  [[nodiscard]] constexpr auto
+  empty() const noexcept -> bool
+  {
+    return _chars.empty();
+  }
+
+  [[nodiscard]] constexpr auto
+  capacity() const noexcept -> size_type
+  {
+    return _chars.capacity() / stride;
+  }
+
+  // words of a bitmap over all elements
+  [[nodiscard]] constexpr auto
+  bitmap_size() const noexcept -> size_type
+  {
+    return (size() + 63) / 64;
+  }
+
+  // the flat buffer, record `i` starts at `data() + i * stride`
+  [[nodiscard]] constexpr auto
+  data() const noexcept -> CharT const*
+  {
+    return _chars.data();
+  }
+
+  constexpr auto
+  reserve(size_type count) -> void
+  {
+    _chars.reserve(count * stride);
+  }
+
+  constexpr auto
+  resize(size_type count) -> void
+  {
+    _chars.resize(count * stride);
+  }
+
+  constexpr auto
+  clear() noexcept -> void
+  {
+    _chars.clear();
+  }
+
+  template <typename Layout2>
+  constexpr auto
+  push_back(basic_fixed_string<CharT, N, Layout2> const& fs) -> void
+  {
+    resize(size() + 1);
+    back() = fs;
+  }
+
+  constexpr auto
+  push_back(std::basic_string_view<CharT> sv) -> void
+  {
+#ifdef MTP_NO_EXCEPTIONS
+    MTP_EXPECTS(sv.size() == N);
+#else
+    if (sv.size() != N) {
+      throw std::length_error("mtp::basic_fixed_string_column::push_back");
+    }
+#endif
+    resize(size() + 1);
+    std::copy_n(sv.data(), N, _chars.data() + (size() - 1) * stride);
+  }
+
+  constexpr auto
+  pop_back() noexcept -> void
+  {
+    MTP_EXPECTS(!empty());
+    _chars.resize(_chars.size() - stride);
+  }
+
+  [[nodiscard]] constexpr auto
+  operator[](size_type i) const noexcept -> const_reference
+  {
+    MTP_EXPECTS(i < size());
+    return const_reference{ _chars.data() + i * stride };
+  }
+
+  [[nodiscard]] constexpr auto
+  operator[](size_type i) noexcept -> reference
+  {
+    MTP_EXPECTS(i < size());
+    return reference{ _chars.data() + i * stride };
+  }
+
+  [[nodiscard]] constexpr auto
+  at(size_type i) const MTP_NOEXCEPT -> const_reference
+  {
+    check_position(i < size(), "mtp::basic_fixed_string_column::at");
+    return (*this)[i];
+  }
+
+  [[nodiscard]] constexpr auto
+  at(size_type i) MTP_NOEXCEPT -> reference
+  {
+    check_position(i < size(), "mtp::basic_fixed_string_column::at");
+    return (*this)[i];
+  }
+
+  [[nodiscard]] constexpr auto
+  front() const noexcept -> const_reference
+  {
+    MTP_EXPECTS(!empty());
+    return (*this)[0];
+  }
+
+  [[nodiscard]] constexpr auto
+  front() noexcept -> reference
+  {
+    MTP_EXPECTS(!empty());
+    return (*this)[0];
+  }
+
+  [[nodiscard]] constexpr auto
+  back() const noexcept -> const_reference
+  {
+    MTP_EXPECTS(!empty());
+    return (*this)[size() - 1];
+  }
+
+  [[nodiscard]] constexpr auto
+  back() noexcept -> reference
+  {
+    MTP_EXPECTS(!empty());
+    return (*this)[size() - 1];
+  }
+
+  [[nodiscard]] constexpr auto
+  begin() const noexcept -> const_iterator
+  {
+    return const_iterator{ _chars.data() };
+  }
+
+  [[nodiscard]] constexpr auto
+  begin() noexcept -> iterator
+  {
+    return iterator{ _chars.data() };
+  }
+
+  [[nodiscard]] constexpr auto
+  end() const noexcept -> const_iterator
+  {
+    return const_iterator{ _chars.data() + _chars.size() };
+  }
+
+  [[nodiscard]] constexpr auto
+  end() noexcept -> iterator
+  {
+    return iterator{ _chars.data() + _chars.size() };
+  }
+
+  [[nodiscard]] constexpr auto
+  cbegin() const noexcept -> const_iterator
+  {
+    return begin();
+  }
+
+  [[nodiscard]] constexpr auto
+  cend() const noexcept -> const_iterator
+  {
+    return end();
+  }
+
+  // marks the elements equal to `fs` in `bitmap` (of `bitmap_size()` words) and returns how many
+  // there are. padded records are compared with their zeroed padding, whole blocks at a time
+  template <typename Layout2>
+  auto
+  equals(basic_fixed_string<CharT, N, Layout2> const& fs, std::uint64_t* bitmap) const noexcept
+      -> size_type
+  {
+    CharT record[stride] = {};
+    std::copy_n(fs.data(), N, record);
+    return match(record, stride, bitmap);
+  }
+
+  // marks the elements starting with `prefix` in `bitmap` and returns how many there are
+  auto
+  starts_with(std::basic_string_view<CharT> prefix, std::uint64_t* bitmap) const noexcept
+      -> size_type
+  {
+    MTP_EXPECTS(prefix.size() <= N);
+    CharT record[stride] = {};
+    std::copy_n(prefix.data(), prefix.size(), record);
+    return match(record, prefix.size(), bitmap);
+  }
+
+  // `out[i]` is the `mtp::hash` of element `i`. one record at a time: the hash is two 64 x 64 ->
+  // 128 bit multiplies, which vector instructions only emulate from 32 bit ones, more slowly
+  auto
+  hash_to(std::size_t* out) const noexcept -> void
+  {
+    auto const* record = _chars.data();
+    for (size_type i = 0; i < size(); ++i, record += stride) {
+      out[i] = static_cast<std::size_t>(detail::wyhash(record, N, 0));
+    }
+  }
+
+  // appends the elements at `indices[0, count)` to `out`
+  auto
+  gather(size_type const* indices, size_type count, basic_fixed_string_column& out) const -> void
+  {
+    auto const first = out.size();
+    out.resize(first + count);
+    auto* dest = out._chars.data() + first * stride;
+    for (size_type i = 0; i < count; ++i, dest += stride) {
+      MTP_EXPECTS(indices[i] < size());
+      std::copy_n(_chars.data() + indices[i] * stride, stride(), dest);
+    }
+  }
+
+  // overwrites the element at `indices[i]` with `values[i]` for every element of `values`
+  auto
+  scatter(size_type const* indices, basic_fixed_string_column const& values) noexcept -> void
+  {
+    auto const* src = values._chars.data();
+    for (size_type i = 0; i < values.size(); ++i, src += stride) {
+      MTP_EXPECTS(indices[i] < size());
+      std::copy_n(src, stride(), _chars.data() + indices[i] * stride);
+    }
+  }
+
+  [[nodiscard]] friend constexpr auto
+  operator==(basic_fixed_string_column const&, basic_fixed_string_column const&) -> bool = default;
+
+private:
+  std::vector<CharT> _chars;
+
+  auto
+  match(CharT const* record, size_type prefix, std::uint64_t* bitmap) const noexcept -> size_type
+  {
+    return detail::match_records<stride * sizeof(CharT), detail::layout_traits<Layout>::width>(
+        reinterpret_cast<unsigned char const*>(_chars.data()), size(),
+        reinterpret_cast<unsigned char const*>(record), prefix * sizeof(CharT), bitmap);
+  }
+
+  static constexpr auto
+  check_position(bool valid, [[maybe_unused]] char const* what) MTP_NOEXCEPT -> void
+  {
+#ifdef MTP_NO_EXCEPTIONS
+    MTP_EXPECTS(valid);
+#else
+    if (!valid) {
+      throw std::out_of_range(what);
+    }
+#endif
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+
+// open addressing hash map (and set) keyed by fixed strings of one width, in the style of swiss
+// tables. elements are stored inline in cache line aligned groups of 16 slots, each with a
+// control byte holding 7 bits of its key's hash or marking it empty or deleted. a lookup matches
+// the control bytes of a whole group at once and only compares the keys whose bits match, with the
+// fixed width comparison of `basic_fixed_string`. keys hash with `mtp::hash`, so any view of the
+// right length finds them without building a key, and nothing is allocated per element
+
+namespace detail {
+
+// views of `CharT` strings, the character type is checked first so that no `basic_string_view` of
+// another range's elements is formed. string literals are keys without their terminator
+template <typename K, typename CharT>
+concept map_key = (std::is_bounded_array_v<K> && std::same_as<std::remove_extent_t<K>, CharT>)
+                  || (std::same_as<typename K::value_type, CharT>
+                      && concepts::string_view_like<K>);
+
+inline constexpr std::uint8_t ctrl_empty = 0x80;
+inline constexpr std::uint8_t ctrl_deleted = 0xFE;
+
+template <typename Slot>
+struct alignas(64) flat_group
+{
+  static constexpr std::size_t width = 16;
+
+  // full slots hold the low 7 bits of the hash, empty and deleted ones have the top bit set
+  std::uint8_t ctrl[width];
+  alignas(Slot) unsigned char storage[width * sizeof(Slot)];
+
+  [[nodiscard]] auto
+  place(std::size_t i) noexcept -> Slot*
+  {
+    return reinterpret_cast<Slot*>(storage) + i;
+  }
+
+  [[nodiscard]] auto
+  slot(std::size_t i) noexcept -> Slot*
+  {
+    return std::launder(place(i));
+  }
+
+  // bit `i` is set iff control byte `i` is `ch`
+  [[nodiscard]] auto
+  match(std::uint8_t ch) const noexcept -> std::uint32_t
+  {
+#ifdef MTP_HAS_SSE2
+    return sse2_chunk::matches(ctrl, ch);
+#else
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < width; ++i) {
+      mask |= std::uint32_t{ ctrl[i] == ch } << i;
+    }
+    return mask;
+#endif
+  }
+
+  [[nodiscard]] auto
+  match_empty() const noexcept -> std::uint32_t
+  {
+    return match(ctrl_empty);
+  }
+
+  // empty or deleted
+  [[nodiscard]] auto
+  match_free() const noexcept -> std::uint32_t
+  {
+#ifdef MTP_HAS_SSE2
+    auto const bytes = _mm_load_si128(reinterpret_cast<__m128i const*>(ctrl));
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(bytes));
+#else
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < width; ++i) {
+      mask |= static_cast<std::uint32_t>(ctrl[i] >> 7) << i;
+    }
+    return mask;
+#endif
+  }
+
+  [[nodiscard]] auto
+  match_full() const noexcept -> std::uint32_t
+  {
+    return ~match_free() & ((std::uint32_t{ 1 } << width) - 1);
+  }
+};
+
+// at most 14 of every 16 slots are used, so every probe sequence ends at an empty slot
+inline constexpr std::size_t group_load = 14;
+
+// groups for `count` elements, a power of two
+[[nodiscard]] constexpr auto
+groups_for(std::size_t count) noexcept -> std::size_t
+{
+  return count == 0 ? 0 : std::bit_ceil((count + group_load - 1) / group_load);
+}
+
+} // namespace detail
+
+MTP_EXPORT template <typename CharT, std::size_t N, typename V>
+class basic_fixed_string_map
+{
+  static constexpr bool is_set = std::is_void_v<V>;
+
+public:
+  using key_type = basic_fixed_string<CharT, N>;
+  using mapped_type = V;
+  using value_type = std::conditional_t<is_set, key_type, std::pair<key_type const, V>>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using hasher = hash<key_type>;
+  using reference = value_type&;
+  using const_reference = value_type const&;
+
+  static_assert(N > 0, "mtp::basic_fixed_string_map: keys must not be empty");
+
+private:
+  using group = detail::flat_group<value_type>;
+
+public:
+  template <bool Const>
+  class basic_iterator
+  {
+  public:
+    using value_type = basic_fixed_string_map::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<Const, value_type const&, value_type&>;
+    using pointer = std::conditional_t<Const, value_type const*, value_type*>;
+    using iterator_category = std::forward_iterator_tag;
+
+    [[nodiscard]] constexpr basic_iterator() noexcept = default;
+
+    template <bool Const2>
+      requires(Const && !Const2)
+    [[nodiscard]] constexpr basic_iterator(basic_iterator<Const2> other) noexcept
+        : _group{ other._group }
+        , _index{ other._index }
+        , _end{ other._end }
+    {}
+
+    [[nodiscard]] auto
+    operator*() const noexcept -> reference
+    {
+      return *_group->slot(_index);
+    }
+
+    [[nodiscard]] auto
+    operator->() const noexcept -> pointer
+    {
+      return _group->slot(_index);
+    }
+
+    auto
+    operator++() noexcept -> basic_iterator&
+    {
+      ++_index;
+      skip_free();
+      return *this;
+    }
+
+    auto
+    operator++(int) noexcept -> basic_iterator
+    {
+      auto const it = *this;
+      ++*this;
+      return it;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator==(basic_iterator const& lhs, basic_iterator const& rhs) noexcept -> bool
+    {
+      return lhs._group == rhs._group && lhs._index == rhs._index;
+    }
+
+  private:
+    friend class basic_fixed_string_map;
+
+    group* _group = nullptr;
+    size_type _index = 0;
+    group* _end = nullptr;
+
+    [[nodiscard]] constexpr basic_iterator(group* g, size_type index, group* end) noexcept
+        : _group{ g }
+        , _index{ index }
+        , _end{ end }
+    {}
+
+    // to the next full slot at or after the current one, or to the end
+    auto
+    skip_free() noexcept -> void
+    {
+      for (; _group != _end; ++_group, _index = 0) {
+        if (auto const full = _group->match_full() >> _index; full != 0) {
+          _index += static_cast<size_type>(std::countr_zero(full));
+          return;
+        }
+      }
+      _index = 0;
+    }
+  };
+
+  // the elements of a set are its keys, which must not be modified in place
+  using iterator = basic_iterator<is_set>;
+  using const_iterator = basic_iterator<true>;
+
+  [[nodiscard]] constexpr basic_fixed_string_map() noexcept = default;
+
+  // room for `count` elements without rehashing
+  [[nodiscard]] explicit basic_fixed_string_map(size_type count)
+  {
+    reserve(count);
+  }
+
+  [[nodiscard]] basic_fixed_string_map(std::initializer_list<value_type> values)
+      : basic_fixed_string_map(values.size())
+  {
+    for (auto const& value : values) {
+      insert(value);
+    }
+  }
+
+  // the copy has the same groups, so every element goes to the same slot
+  [[nodiscard]] basic_fixed_string_map(basic_fixed_string_map const& other)
+      : basic_fixed_string_map()
+  {
+    if (other._groups == nullptr) {
+      return;
+    }
+    _groups = allocate(other.group_count());
+    _mask = other._mask;
+    _growth_left = other._growth_left + other._size;
+    for (size_type g = 0; g < group_count(); ++g) {
+      for (auto full = other._groups[g].match_full(); full != 0; full &= full - 1) {
+        auto const i = static_cast<size_type>(std::countr_zero(full));
+        std::construct_at(_groups[g].place(i), *other._groups[g].slot(i));
+        _groups[g].ctrl[i] = other._groups[g].ctrl[i];
+        ++_size;
+        --_growth_left;
+      }
+    }
+  }
+
+  [[nodiscard]] basic_fixed_string_map(basic_fixed_string_map&& other) noexcept
+      : _groups{ std::exchange(other._groups, nullptr) }
+      , _mask{ std::exchange(other._mask, 0) }
+      , _size{ std::exchange(other._size, 0) }
+      , _growth_left{ std::exchange(other._growth_left, 0) }
+  {}
+
+  auto
+  operator=(basic_fixed_string_map const& other) -> basic_fixed_string_map&
+  {
+    auto copy = other;
+    swap(copy);
+    return *this;
+  }
+
+  auto
+  operator=(basic_fixed_string_map&& other) noexcept -> basic_fixed_string_map&
+  {
+    auto moved = std::move(other);
+    swap(moved);
+    return *this;
+  }
+
+  ~basic_fixed_string_map()
+  {
+    release();
+  }
+
+  [[nodiscard]] auto
+  begin() noexcept -> iterator
+  {
+    auto it = iterator{ _groups, 0, end_group() };
+    it.skip_free();
+    return it;
+  }
+
+  [[nodiscard]] auto
+  begin() const noexcept -> const_iterator
+  {
+    auto it = const_iterator{ _groups, 0, end_group() };
+    it.skip_free();
+    return it;
+  }
+
+  [[nodiscard]] auto
+  end() noexcept -> iterator
+  {
+    return iterator{ end_group(), 0, end_group() };
+  }
+
+  [[nodiscard]] auto
+  end() const noexcept -> const_iterator
+  {
+    return const_iterator{ end_group(), 0, end_group() };
+  }
+
+  [[nodiscard]] auto
+  cbegin() const noexcept -> const_iterator
+  {
+    return begin();
+  }
+
+  [[nodiscard]] auto
+  cend() const noexcept -> const_iterator
+  {
+    return end();
+  }
+
+  [[nodiscard]] auto
+  size() const noexcept -> size_type
+  {
+    return _size;
+  }
+
+  [[nodiscard]] auto
+  empty() const noexcept -> bool
+  {
+    return _size == 0;
+  }
+
+  // slots, of which at most 7 in 8 are used before the table grows
+  [[nodiscard]] auto
+  capacity() const noexcept -> size_type
+  {
+    return group_count() * group::width;
+  }
+
+  [[nodiscard]] auto
+  load_factor() const noexcept -> float
+  {
+    return _size == 0 ? 0.0f : static_cast<float>(_size) / static_cast<float>(capacity());
+  }
+
+  [[nodiscard]] static constexpr auto
+  max_load_factor() noexcept -> float
+  {
+    return static_cast<float>(detail::group_load) / static_cast<float>(group::width);
+  }
+
+  // destroys the elements and keeps the groups
+  auto
+  clear() noexcept -> void
+  {
+    destroy_all();
+    for (size_type g = 0; g < group_count(); ++g) {
+      std::fill_n(_groups[g].ctrl, group::width, detail::ctrl_empty);
+    }
+    _size = 0;
+    _growth_left = group_count() * detail::group_load;
+  }
+
+  // room for `count` elements without rehashing
+  auto
+  reserve(size_type count) -> void
+  {
+    if (auto const groups = detail::groups_for(count); groups > group_count()) {
+      resize(groups);
+    }
+  }
+
+  // rebuilds the table with at least `count` slots (and room for the elements), which also drops
+  // the markers left by erased elements
+  auto
+  rehash(size_type count) -> void
+  {
+    auto const groups = std::max(std::bit_ceil((count + group::width - 1) / group::width),
+                                 detail::groups_for(_size));
+    if (count == 0 && _size == 0) {
+      release();
+    }
+    else {
+      resize(groups);
+    }
+  }
+
+  template <detail::map_key<CharT> K>
+  [[nodiscard]] auto
+  find(K const& key) noexcept -> iterator
+  {
+    return to_iterator<iterator>(find_slot(key_chars(key)));
+  }
+
+  template <detail::map_key<CharT> K>
+  [[nodiscard]] auto
+  find(K const& key) const noexcept -> const_iterator
+  {
+    return to_iterator<const_iterator>(find_slot(key_chars(key)));
+  }
+
+  template <detail::map_key<CharT> K>
+  [[nodiscard]] auto
+  contains(K const& key) const noexcept -> bool
+  {
+    return find_slot(key_chars(key)).first != nullptr;
+  }
+
+  template <detail::map_key<CharT> K>
+  [[nodiscard]] auto
+  count(K const& key) const noexcept -> size_type
+  {
+    return contains(key) ? 1 : 0;
+  }
+
+  // inserts `key` (a set) or `key` with a value made from `args` (a map) unless the key is already
+  // there, a view must have exactly `N` characters
+  template <detail::map_key<CharT> K, typename... Args>
+  auto
+  try_emplace(K const& key, Args&&... args) -> std::pair<iterator, bool>
+  {
+    static_assert(!is_set || sizeof...(Args) == 0, "mtp::basic_fixed_string_set: keys only");
+    return emplace_key(checked_key_chars(key), std::forward<Args>(args)...);
+  }
+
+  auto
+  insert(value_type const& value) -> std::pair<iterator, bool>
+  {
+    if constexpr (is_set) {
+      return emplace_key(value.data());
+    }
+    else {
+      return emplace_key(value.first.data(), value.second);
+    }
+  }
+
+  auto
+  insert(value_type&& value) -> std::pair<iterator, bool>
+  {
+    if constexpr (is_set) {
+      return emplace_key(value.data());
+    }
+    else {
+      return emplace_key(value.first.data(), std::move(value.second));
+    }
+  }
+
+  template <detail::map_key<CharT> K>
+    requires(is_set)
+  auto
+  insert(K const& key) -> std::pair<iterator, bool>
+  {
+    return try_emplace(key);
+  }
+
+  template <detail::map_key<CharT> K, typename M>
+    requires(!is_set)
+  auto
+  insert_or_assign(K const& key, M&& value) -> std::pair<iterator, bool>
+  {
+    auto result = try_emplace(key, std::forward<M>(value));
+    if (!result.second) {
+      result.first->second = std::forward<M>(value);
+    }
+    return result;
+  }
+
+  template <detail::map_key<CharT> K>
+    requires(!is_set)
+  auto
+  operator[](K const& key) -> std::add_lvalue_reference_t<mapped_type>
+  {
+    return try_emplace(key).first->second;
+  }
+
+  template <detail::map_key<CharT> K>
+    requires(!is_set)
+  [[nodiscard]] auto
+  at(K const& key) MTP_NOEXCEPT -> std::add_lvalue_reference_t<mapped_type>
+  {
+    auto const [g, i] = find_slot(key_chars(key));
+    check_found(g != nullptr);
+    return g->slot(i)->second;
+  }
+
+  template <detail::map_key<CharT> K>
+    requires(!is_set)
+  [[nodiscard]] auto
+  at(K const& key) const MTP_NOEXCEPT -> std::add_lvalue_reference_t<mapped_type const>
+  {
+    auto const [g, i] = find_slot(key_chars(key));
+    check_found(g != nullptr);
+    return g->slot(i)->second;
+  }
+
+  template <detail::map_key<CharT> K>
+  auto
+  erase(K const& key) noexcept -> size_type
+  {
+    auto const [g, i] = find_slot(key_chars(key));
+    if (g == nullptr) {
+      return 0;
+    }
+    erase_slot(g, i);
+    return 1;
+  }
+
+  // the iterator to the element after `pos`
+  auto
+  erase(const_iterator pos) noexcept -> iterator
+  {
+    auto next = iterator{ pos._group, pos._index, pos._end };
+    ++next;
+    erase_slot(pos._group, pos._index);
+    return next;
+  }
+
+  auto
+  swap(basic_fixed_string_map& other) noexcept -> void
+  {
+    std::swap(_groups, other._groups);
+    std::swap(_mask, other._mask);
+    std::swap(_size, other._size);
+    std::swap(_growth_left, other._growth_left);
+  }
+
+  friend auto
+  swap(basic_fixed_string_map& lhs, basic_fixed_string_map& rhs) noexcept -> void
+  {
+    lhs.swap(rhs);
+  }
+
+private:
+  group* _groups = nullptr;
+  // group count - 1, groups are probed as `h, h + 1, h + 3, h + 6, ...` modulo the count
+  size_type _mask = 0;
+  size_type _size = 0;
+  // elements that fit before the table grows, slots freed by an erase do not count
+  size_type _growth_left = 0;
+
+  [[nodiscard]] auto
+  group_count() const noexcept -> size_type
+  {
+    return _groups == nullptr ? 0 : _mask + 1;
+  }
+
+  [[nodiscard]] auto
+  end_group() const noexcept -> group*
+  {
+    return _groups + group_count();
+  }
+
+  [[nodiscard]] static auto
+  key_of(value_type const& value) noexcept -> key_type const&
+  {
+    if constexpr (is_set) {
+      return value;
+    }
+    else {
+      return value.first;
+    }
+  }
+
+  [[nodiscard]] static auto
+  hash_of(CharT const* key) noexcept -> std::uint64_t
+  {
+    return detail::wyhash(key, N, 0);
+  }
+
+  // the `N` characters of a key, or null for a view of another length
+  template <typename K>
+  [[nodiscard]] static auto
+  key_chars(K const& key) noexcept -> CharT const*
+  {
+    if constexpr (std::same_as<K, key_type>) {
+      return key.data();
+    }
+    else if constexpr (std::is_array_v<K>) {
+      return std::extent_v<K> == N + 1 ? key : nullptr;
+    }
+    else {
+      auto const sv = std::basic_string_view<CharT>(key);
+      return sv.size() == N ? sv.data() : nullptr;
+    }
+  }
+
+  template <typename K>
+  [[nodiscard]] static auto
+  checked_key_chars(K const& key) MTP_NOEXCEPT -> CharT const*
+  {
+    auto const* chars = key_chars(key);
+#ifdef MTP_NO_EXCEPTIONS
+    MTP_EXPECTS(chars != nullptr);
+#else
+    if (chars == nullptr) {
+      throw std::length_error("mtp::basic_fixed_string_map::insert");
+    }
+#endif
+    return chars;
+  }
+
+  static auto
+  check_found([[maybe_unused]] bool found) MTP_NOEXCEPT -> void
+  {
+#ifdef MTP_NO_EXCEPTIONS
+    MTP_EXPECTS(found);
+#else
+    if (!found) {
+      detail::throw_out_of_range("mtp::basic_fixed_string_map::at");
+    }
+#endif
+  }
+
+  template <typename It>
+  [[nodiscard]] auto
+  to_iterator(std::pair<group*, size_type> slot) const noexcept -> It
+  {
+    return slot.first == nullptr ? It{ end_group(), 0, end_group() }
+                                 : It{ slot.first, slot.second, end_group() };
+  }
+
+  [[nodiscard]] auto
+  find_slot(CharT const* key) const noexcept -> std::pair<group*, size_type>
+  {
+    if (key == nullptr || _groups == nullptr) {
+      return {};
+    }
+    return find_slot(key, hash_of(key));
+  }
+
+  [[nodiscard]] auto
+  find_slot(CharT const* key, std::uint64_t hash) const noexcept -> std::pair<group*, size_type>
+  {
+    auto const h2 = static_cast<std::uint8_t>(hash & 0x7F);
+    auto pos = static_cast<size_type>(hash >> 7) & _mask;
+    for (size_type stride = 1;; pos = (pos + stride++) & _mask) {
+      auto& g = _groups[pos];
+      for (auto match = g.match(h2); match != 0; match &= match - 1) {
+        auto const i = static_cast<size_type>(std::countr_zero(match));
+        if (detail::equal<CharT, N>(key_of(*g.slot(i)).data(), key)) {
+          return { &g, i };
+        }
+      }
+      if (g.match_empty() != 0) {
+        return {};
+      }
+    }
+  }
+
+  // the first empty or deleted slot of the key's probe sequence
+  [[nodiscard]] auto
+  find_free(std::uint64_t hash) const noexcept -> std::pair<group*, size_type>
+  {
+    auto pos = static_cast<size_type>(hash >> 7) & _mask;
+    for (size_type stride = 1;; pos = (pos + stride++) & _mask) {
+      if (auto const free = _groups[pos].match_free(); free != 0) {
+        return { &_groups[pos], static_cast<size_type>(std::countr_zero(free)) };
+      }
+    }
+  }
+
+  template <typename... Args>
+  auto
+  emplace_key(CharT const* key, Args&&... args) -> std::pair<iterator, bool>
+  {
+    auto const hash = hash_of(key);
+    if (_groups != nullptr) {
+      if (auto const slot = find_slot(key, hash); slot.first != nullptr) {
+        return { to_iterator<iterator>(slot), false };
+      }
+    }
+
+    auto [g, i] = _groups == nullptr ? std::pair<group*, size_type>{} : find_free(hash);
+    if (g == nullptr || (_growth_left == 0 && g->ctrl[i] == detail::ctrl_empty)) {
+      // the key may be an element of this table, which moves
+      auto const copy = key_type{ key, key + N };
+      // a table at most half full is mostly deleted slots, rebuilding it at its size drops them
+      auto const full = _size + 1 > group_count() * detail::group_load / 2;
+      resize(_groups == nullptr ? 1 : full ? group_count() * 2 : group_count());
+      std::tie(g, i) = find_free(hash);
+      construct(g->place(i), copy.data(), std::forward<Args>(args)...);
+    }
+    else {
+      construct(g->place(i), key, std::forward<Args>(args)...);
+    }
+
+    _growth_left -= g->ctrl[i] == detail::ctrl_empty;
+    g->ctrl[i] = static_cast<std::uint8_t>(hash & 0x7F);
+    ++_size;
+    return { iterator{ g, i, end_group() }, true };
+  }
+
+  template <typename... Args>
+  static auto
+  construct(value_type* slot, CharT const* key, Args&&... args) -> void
+  {
+    if constexpr (is_set) {
+      std::construct_at(slot, key, key + N);
+    }
+    else {
+      std::construct_at(slot, std::piecewise_construct, std::forward_as_tuple(key, key + N),
+                        std::forward_as_tuple(std::forward<Args>(args)...));
+    }
+  }
+
+  // a slot becomes empty again if its group has an empty slot, as no probe sequence then goes past
+  // the group, otherwise it is marked deleted
+  auto
+  erase_slot(group* g, size_type i) noexcept -> void
+  {
+    std::destroy_at(g->slot(i));
+    if (g->match_empty() != 0) {
+      g->ctrl[i] = detail::ctrl_empty;
+      ++_growth_left;
+    }
+    else {
+      g->ctrl[i] = detail::ctrl_deleted;
+    }
+    --_size;
+  }
+
+  // moves the elements into `count` new groups, or copies them when their move may throw. as with
+  // the reallocation of `std::vector`, a copy that throws leaves the table as it was
+  auto
+  resize(size_type count) -> void
+  {
+    auto* const old_groups = _groups;
+    [[maybe_unused]] auto const old_mask = _mask;
+    [[maybe_unused]] auto const old_growth_left = _growth_left;
+    auto const old_count = group_count();
+
+    _groups = allocate(count);
+    _mask = count - 1;
+    _growth_left = count * detail::group_load - _size;
+
+#ifndef MTP_NO_EXCEPTIONS
+    try {
+#endif
+      for (size_type g = 0; g < old_count; ++g) {
+        for (auto full = old_groups[g].match_full(); full != 0; full &= full - 1) {
+          auto* const slot = old_groups[g].slot(static_cast<size_type>(std::countr_zero(full)));
+          auto const hash = hash_of(key_of(*slot).data());
+          auto const [to, j] = find_free(hash);
+          std::construct_at(to->place(j), std::move_if_noexcept(*slot));
+          to->ctrl[j] = static_cast<std::uint8_t>(hash & 0x7F);
+        }
+      }
+#ifndef MTP_NO_EXCEPTIONS
+    }
+    catch (...) {
+      destroy(_groups, count);
+      deallocate(_groups, count);
+      _groups = old_groups;
+      _mask = old_mask;
+      _growth_left = old_growth_left;
+      throw;
+    }
+#endif
+    destroy(old_groups, old_count);
+    deallocate(old_groups, old_count);
+  }
+
+  static auto
+  destroy(group* groups, size_type count) noexcept -> void
+  {
+    if constexpr (!std::is_trivially_destructible_v<value_type>) {
+      for (size_type g = 0; g < count; ++g) {
+        for (auto full = groups[g].match_full(); full != 0; full &= full - 1) {
+          std::destroy_at(groups[g].slot(static_cast<size_type>(std::countr_zero(full))));
+        }
+      }
+    }
+  }
+
+  auto
+  destroy_all() noexcept -> void
+  {
+    destroy(_groups, group_count());
+  }
+
+  auto
+  release() noexcept -> void
+  {
+    destroy_all();
+    deallocate(_groups, group_count());
+    _groups = nullptr;
+    _mask = 0;
+    _size = 0;
+    _growth_left = 0;
+  }
+
+  [[nodiscard]] static auto
+  allocate(size_type count) -> group*
+  {
+    auto* const groups = static_cast<group*>(
+        ::operator new(count * sizeof(group), std::align_val_t{ alignof(group) }));
+    for (size_type g = 0; g < count; ++g) {
+      std::fill_n(groups[g].ctrl, group::width, detail::ctrl_empty);
+    }
+    return groups;
+  }
+
+  static auto
+  deallocate(group* groups, size_type count) noexcept -> void
+  {
+    if (groups != nullptr) {
+      ::operator delete(groups, count * sizeof(group), std::align_val_t{ alignof(group) });
+    }
+  }
+};
+
+// -------------------------------------------------------------------------------------------------
+
+// radix sorting ranges of `basic_fixed_string`. every element has the same `N * sizeof(CharT)` key
+// bytes, taken most significant first from each character (with the sign flipped for signed
+// characters) so that byte order is `char_traits<CharT>::lt` order. `stable_sort` is an lsd sort
+// through a buffer that skips the bytes all elements share, `sort` an msd sort that permutes in
+// place (american flag) once a bucket fits the cache, or the lsd sort for large ranges of short
+// keys, and `parallel_sort` partitions on leading bytes across worker threads. the latter is opt
+// in with `MTP_PARALLEL_SORT`, so that the rest of the library does not need the threads library
+
+namespace detail {
+
+template <typename T>
+struct radix_traits;
+
+template <typename CharT, std::size_t N, typename Layout>
+struct radix_traits<basic_fixed_string<CharT, N, Layout>>
+{
+  static constexpr std::size_t digits = N * sizeof(CharT);
+
+  [[nodiscard]] static auto
+  digit(basic_fixed_string<CharT, N, Layout> const& fs, std::size_t d) noexcept -> std::size_t
+  {
+    using key_type = std::make_unsigned_t<std::conditional_t<sizeof(CharT) == 1, char, CharT>>;
+    constexpr auto sign = std::is_signed_v<CharT> && sizeof(CharT) > 1
+                              ? key_type{ 1 } << (8 * sizeof(CharT) - 1)
+                              : key_type{ 0 };
+
+    auto const key = static_cast<key_type>(static_cast<key_type>(fs[d / sizeof(CharT)]) ^ sign);
+    return static_cast<std::size_t>(key >> (8 * (sizeof(CharT) - 1 - d % sizeof(CharT))))
+           & 0xFF;
+  }
+};
+
+// below this many elements a bucket is left to `std::sort`
+inline constexpr std::size_t radix_cutoff = 64;
+
+// ranges up to this size are permuted in place
+inline constexpr std::size_t radix_in_place_bytes = std::size_t{ 256 } * 1024;
+
+// larger ranges of keys up to this long are sorted lsd: a streaming pass per key byte is cheaper
+// than the msd recursion and the comparison sorts of its small buckets
+inline constexpr std::size_t lsd_digits = 16;
+
+using radix_counts = std::array<std::size_t, 256>;
+
+template <typename T>
+auto
+msd_sort(T* first, std::size_t count, std::size_t digit) noexcept -> void
+{
+  using traits = radix_traits<T>;
+
+  while (count > radix_cutoff && digit < traits::digits) {
+    auto counts = radix_counts{};
+    for (std::size_t i = 0; i < count; ++i) {
+      ++counts[traits::digit(first[i], digit)];
+    }
+    if (counts[traits::digit(first[0], digit)] == count) {
+      ++digit;
+      continue;
+    }
+
+    auto heads = radix_counts{};
+    auto tails = radix_counts{};
+    for (std::size_t b = 0, offset = 0; b < 256; ++b) {
+      heads[b] = offset;
+      offset += counts[b];
+      tails[b] = offset;
+    }
+    // american flag permutation: each bucket's head is filled by swapping in elements until one
+    // belonging there arrives
+    for (std::size_t b = 0; b < 256; ++b) {
+      while (heads[b] < tails[b]) {
+        auto& element = first[heads[b]];
+        auto const target = traits::digit(element, digit);
+        if (target == b) {
+          ++heads[b];
+        }
+        else {
+          std::swap(element, first[heads[target]++]);
+        }
+      }
+    }
+
+    for (std::size_t b = 0, offset = 0; b < 256; offset += counts[b], ++b) {
+      if (counts[b] > 1) {
+        msd_sort(first + offset, counts[b], digit + 1);
+      }
+    }
+    return;
+  }
+  if (digit < traits::digits) {
+    std::sort(first, first + count);
+  }
+}
+
+template <typename T>
+auto
+lsd_sort(T* first, std::size_t count, T* buffer) -> void
+{
+  using traits = radix_traits<T>;
+
+  auto counts = std::vector<radix_counts>(traits::digits);
+  for (std::size_t i = 0; i < count; ++i) {
+    for (std::size_t d = 0; d < traits::digits; ++d) {
+      ++counts[d][traits::digit(first[i], d)];
+    }
+  }
+
+  auto* src = first;
+  auto* dst = buffer;
+  for (auto d = traits::digits; d-- > 0;) {
+    if (counts[d][traits::digit(src[0], d)] == count) {
+      continue;
+    }
+    auto offsets = radix_counts{};
+    for (std::size_t b = 0, offset = 0; b < 256; ++b) {
+      offsets[b] = offset;
+      offset += counts[d][b];
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+      dst[offsets[traits::digit(src[i], d)]++] = src[i];
+    }
+    std::swap(src, dst);
+  }
+  if (src != first) {
+    std::copy_n(src, count, first);
+  }
+}
+
+// scratch space for the sorts, left uninitialized: the elements are trivially copyable and each
+// one is assigned before it is read
+template <typename T>
+struct radix_buffer_delete
+{
+  auto
+  operator()(T* buffer) const noexcept -> void
+  {
+    ::operator delete(buffer, std::align_val_t{ alignof(T) });
+  }
+};
+
+template <typename T>
+using radix_buffer = std::unique_ptr<T[], radix_buffer_delete<T>>;
+
+template <typename T>
+[[nodiscard]] auto
+make_radix_buffer(std::size_t count) -> radix_buffer<T>
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+  return radix_buffer<T>{ static_cast<T*>(
+      ::operator new(count * sizeof(T), std::align_val_t{ alignof(T) })) };
+}
+
+// the steps of a sort on the calling thread alone
+struct inline_workers
+{
+  [[nodiscard]] static constexpr auto
+  size() noexcept -> std::size_t
+  {
+    return 1;
+  }
+
+  template <typename Fn>
+  static auto
+  run(Fn const& fn) -> void
+  {
+    fn(std::size_t{ 0 });
+  }
+};
+
+#ifdef MTP_PARALLEL_SORT
+
+// `threads - 1` worker threads started once per parallel sort and handed each of its steps in
+// turn. `run(fn)` calls `fn(t)` for `t` in `[0, threads)`, `t = 0` on the calling thread, and
+// returns once all the calls have, even if some threw: the first exception is then rethrown
+class thread_workers
+{
+public:
+  explicit thread_workers(std::size_t threads)
+      : _threads{ threads }
+  {
+#ifndef MTP_NO_EXCEPTIONS
+    try {
+#endif
+      _workers.reserve(threads - 1);
+      for (std::size_t t = 1; t < threads; ++t) {
+        _workers.emplace_back([this, t] { work(t); });
+      }
+#ifndef MTP_NO_EXCEPTIONS
+    }
+    catch (...) {
+      // the threads started are joined by `_workers` on the way out, which they must not wait for
+      stop();
+      throw;
+    }
+#endif
+  }
+
+  thread_workers(thread_workers const&) = delete;
+  auto operator=(thread_workers const&) -> thread_workers& = delete;
+
+  // the threads are joined by `_workers`, destroyed first
+  ~thread_workers()
+  {
+    stop();
+  }
+
+  [[nodiscard]] auto
+  size() const noexcept -> std::size_t
+  {
+    return _threads;
+  }
+
+  template <typename Fn>
+  auto
+  run(Fn const& fn) -> void
+  {
+    {
+      auto const lock = std::scoped_lock{ _mutex };
+      _task = &fn;
+      _call = [](void const* task, std::size_t t) { (*static_cast<Fn const*>(task))(t); };
+      _pending = _threads - 1;
+      ++_generation;
+    }
+    _start.notify_all();
+    call(&fn, _call, 0);
+
+    auto lock = std::unique_lock{ _mutex };
+    _done.wait(lock, [&] { return _pending == 0; });
+#ifndef MTP_NO_EXCEPTIONS
+    if (_error) {
+      std::rethrow_exception(std::exchange(_error, nullptr));
+    }
+#endif
+  }
+
+private:
+  auto
+  stop() noexcept -> void
+  {
+    {
+      auto const lock = std::scoped_lock{ _mutex };
+      _stop = true;
+    }
+    _start.notify_all();
+  }
+
+  // keeps the first exception of a step for `run`, which must not leave before every thread is
+  // done with `fn`
+  auto
+  call(void const* task, void (*fn)(void const*, std::size_t), std::size_t t) -> void
+  {
+#ifndef MTP_NO_EXCEPTIONS
+    try {
+#endif
+      fn(task, t);
+#ifndef MTP_NO_EXCEPTIONS
+    }
+    catch (...) {
+      auto const lock = std::scoped_lock{ _mutex };
+      if (!_error) {
+        _error = std::current_exception();
+      }
+    }
+#endif
+  }
+
+  auto
+  work(std::size_t t) -> void
+  {
+    auto seen = std::size_t{ 0 };
+    auto lock = std::unique_lock{ _mutex };
+    for (;;) {
+      _start.wait(lock, [&] { return _stop || _generation != seen; });
+      if (_stop) {
+        return;
+      }
+      seen = _generation;
+      auto const* const task = _task;
+      auto* const fn = _call;
+
+      lock.unlock();
+      call(task, fn, t);
+      lock.lock();
+      if (--_pending == 0) {
+        _done.notify_one();
+      }
+    }
+  }
+
+  std::size_t _threads;
+  void const* _task = nullptr;
+  void (*_call)(void const*, std::size_t) = nullptr;
+  std::size_t _pending = 0;
+  std::size_t _generation = 0;
+  bool _stop = false;
+#ifndef MTP_NO_EXCEPTIONS
+  std::exception_ptr _error;
+#endif
+  std::mutex _mutex;
+  std::condition_variable _start;
+  std::condition_variable _done;
+  std::vector<std::jthread> _workers;
+};
+
+#endif
+
+// msd sort through `buffer` on the threads of `workers`: ranges larger than the cache are
+// scattered into `buffer` with streaming stores and copied back, since the swap chains of the
+// in-place permutation miss the cache on every step. buckets with more than their share of the
+// elements are partitioned again on all threads, the rest are handed out to the threads largest
+// first
+template <typename T, typename Workers>
+auto
+msd_sort(T* first, std::size_t count, std::size_t digit, T* buffer, Workers& workers) -> void
+{
+  using traits = radix_traits<T>;
+  auto const threads = workers.size();
+
+  if (threads == 1 && count * sizeof(T) <= radix_in_place_bytes) {
+    msd_sort(first, count, digit);
+    return;
+  }
+  if (threads == 1 && traits::digits <= lsd_digits) {
+    lsd_sort(first, count, buffer);
+    return;
+  }
+
+  auto const chunk = [&](std::size_t t) { return count * t / threads; };
+  auto counts = std::vector<radix_counts>(threads);
+  for (;; ++digit) {
+    if (digit == traits::digits) {
+      return;
+    }
+    workers.run([&](std::size_t t) {
+      counts[t] = {};
+      for (auto i = chunk(t); i < chunk(t + 1); ++i) {
+        ++counts[t][traits::digit(first[i], digit)];
+      }
+    });
+    auto const b = traits::digit(first[0], digit);
+    auto total = std::size_t{ 0 };
+    for (auto const& c : counts) {
+      total += c[b];
+    }
+    if (total != count) {
+      break;
+    }
+  }
+
+  auto buckets = radix_counts{};
+  auto sizes = radix_counts{};
+  for (std::size_t b = 0, offset = 0; b < 256; ++b) {
+    buckets[b] = offset;
+    for (auto& c : counts) {
+      sizes[b] += c[b];
+      offset += std::exchange(c[b], offset);
+    }
+  }
+  workers.run([&](std::size_t t) {
+    for (auto i = chunk(t); i < chunk(t + 1); ++i) {
+      buffer[counts[t][traits::digit(first[i], digit)]++] = first[i];
+    }
+  });
+  workers.run([&](std::size_t t) {
+    std::copy(buffer + chunk(t), buffer + chunk(t + 1), first + chunk(t));
+  });
+
+  auto rest = std::vector<std::size_t>{};
+  for (std::size_t b = 0; b < 256; ++b) {
+    if (threads > 1 && sizes[b] > count / threads
+        && sizes[b] * sizeof(T) > radix_in_place_bytes) {
+      msd_sort(first + buckets[b], sizes[b], digit + 1, buffer + buckets[b], workers);
+    }
+    else if (sizes[b] > 1) {
+      rest.push_back(b);
+    }
+  }
+  std::sort(rest.begin(), rest.end(), [&](auto a, auto b) { return sizes[a] > sizes[b]; });
+  auto next = std::atomic<std::size_t>{ 0 };
+  workers.run([&](std::size_t) {
+    auto alone = inline_workers{};
+    for (auto i = next++; i < rest.size(); i = next++) {
+      auto const b = rest[i];
+      msd_sort(first + buckets[b], sizes[b], digit + 1, buffer + buckets[b], alone);
+    }
+  });
+}
+
+} // namespace detail
+
+namespace concepts {
+
+template <typename R>
+concept radix_sortable_range =
+    std::ranges::contiguous_range<R> && std::ranges::sized_range<R>
+    && requires { detail::radix_traits<std::ranges::range_value_t<R>>::digits; };
+
+} // namespace concepts
+
+// sorts the strings into `operator<=>` order, not stable. ranges larger than the cache take a
+// buffer as large as the range
+MTP_EXPORT template <concepts::radix_sortable_range R>
+auto
+sort(R&& range) -> void
+{
+  using value_type = std::ranges::range_value_t<R>;
+
+  auto const count = std::ranges::size(range);
+  if (count * sizeof(value_type) <= detail::radix_in_place_bytes) {
+    detail::msd_sort(std::ranges::data(range), count, 0);
+    return;
+  }
+  auto const buffer = detail::make_radix_buffer<value_type>(count);
+  auto workers = detail::inline_workers{};
+  detail::msd_sort(std::ranges::data(range), count, 0, buffer.get(), workers);
+}
+
+// sorts the strings into `operator<=>` order, keeping equal strings in their order. takes a buffer
+// as large as the range
+MTP_EXPORT template <concepts::radix_sortable_range R>
+auto
+stable_sort(R&& range) -> void
+{
+  if (auto const count = std::ranges::size(range); count > 1) {
+    auto const buffer = detail::make_radix_buffer<std::ranges::range_value_t<R>>(count);
+    detail::lsd_sort(std::ranges::data(range), count, buffer.get());
+  }
+}
+
+#ifdef MTP_PARALLEL_SORT
+
+// `sort` on `threads` threads (all hardware threads by default), not stable. takes a buffer as
+// large as the range, small ranges are sorted on the calling thread
+MTP_EXPORT template <concepts::radix_sortable_range R>
+auto
+parallel_sort(R&& range, std::size_t threads = 0) -> void
+{
+  auto const count = std::ranges::size(range);
+  if (threads == 0) {
+    threads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  if (threads == 1 || count < 16 * 1024) {
+    mtp::sort(range);
+    return;
+  }
+  auto const buffer = detail::make_radix_buffer<std::ranges::range_value_t<R>>(count);
+  auto workers = detail::thread_workers{ threads };
+  detail::msd_sort(std::ranges::data(range), count, 0, buffer.get(), workers);
+}
+
+#endif
+
+// -------------------------------------------------------------------------------------------------
+
+// zero-copy access to fixed-width text in external buffers. `basic_fixed_string_ref` aliases `N`
+// characters it does not own and reads like a `basic_fixed_string`. `record_ref` is one fixed-size
+// record of a binary file, its text fields are refs, and `strided_view` is a random-access range
+// over the records, or one field of each, in a buffer. `mapped_file` maps a whole file read-only
+// (posix only), so that scanning it copies and allocates nothing per record
+
+MTP_EXPORT template <typename CharT, std::size_t N>
+class basic_fixed_string_ref
+{
+public:
+  using value_type = CharT;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using const_pointer = value_type const*;
+  using pointer = const_pointer;
+  using const_reference = value_type const&;
+  using reference = const_reference;
+  using const_iterator = const_pointer;
+  using iterator = const_iterator;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using reverse_iterator = const_reverse_iterator;
+
+  static constexpr std::integral_constant<size_type, N> size{};
+  static constexpr std::integral_constant<size_type, N> length{};
+  static constexpr std::integral_constant<size_type, N> max_size{};
+  static constexpr std::bool_constant<N == 0> empty{};
+
+  static constexpr size_type npos = detail::npos;
+
+  // `ptr` must point to `N` readable characters for as long as the ref is used
+  [[nodiscard]] explicit constexpr basic_fixed_string_ref(const_pointer ptr) noexcept
+      : _ptr{ ptr }
+  {}
+
+  template <typename Layout>
+  [[nodiscard]] constexpr basic_fixed_string_ref(
+      basic_fixed_string<CharT, N, Layout> const& fs) noexcept
+      : _ptr{ fs.data() }
+  {}
+
+  template <typename Layout>
+  basic_fixed_string_ref(basic_fixed_string<CharT, N, Layout> const&&) = delete;
+
+  [[nodiscard]] constexpr auto
+  data() const noexcept -> const_pointer
+  {
+    return _ptr;
+  }
+
+  [[nodiscard]] constexpr auto
+  cbegin() const noexcept -> const_iterator
+  {
+    return data();
+  }
+
+  [[nodiscard]] constexpr auto
+  cend() const noexcept -> const_iterator
+  {
+    return data() + size();
+  }
+
+  [[nodiscard]] constexpr auto
+  begin() const noexcept -> const_iterator
+  {
+    return cbegin();
+  }
+
+  [[nodiscard]] constexpr auto
+  end() const noexcept -> const_iterator
+  {
+    return cend();
+  }
+
+  [[nodiscard]] constexpr auto
+  rbegin() const noexcept -> const_reverse_iterator
+  {
+    return const_reverse_iterator{ end() };
+  }
+
+  [[nodiscard]] constexpr auto
+  rend() const noexcept -> const_reverse_iterator
+  {
+    return const_reverse_iterator{ begin() };
+  }
+
+  [[nodiscard]] constexpr auto
+  operator[](size_type pos) const noexcept -> const_reference
+  {
+    MTP_EXPECTS(pos < size());
+    return _ptr[pos];
+  }
+
+  [[nodiscard]] constexpr auto
+  at(size_type pos) const MTP_NOEXCEPT -> const_reference
+  {
+#ifdef MTP_NO_EXCEPTIONS
+    MTP_EXPECTS(pos < size());
+#else
+    if (pos >= size()) {
+      throw std::out_of_range("mtp::basic_fixed_string_ref::at");
+    }
+#endif
+    return (*this)[pos];
+  }
+
+  [[nodiscard]] constexpr auto
+  front() const noexcept -> const_reference
+  {
+    MTP_EXPECTS(!empty());
+    return (*this)[0];
+  }
+
+  [[nodiscard]] constexpr auto
+  back() const noexcept -> const_reference
+  {
+    MTP_EXPECTS(!empty());
+    return (*this)[size() - 1];
+  }
+
+  [[nodiscard]] constexpr auto
+  find(std::basic_string_view<CharT> sv, size_type pos = 0) const noexcept -> size_type
+  {
+    return view().find(sv, pos);
+  }
+
+  [[nodiscard]] constexpr auto
+  find(CharT ch, size_type pos = 0) const noexcept -> size_type
+  {
+    return view().find(ch, pos);
+  }
+
+  template <::mtp::basic_fixed_string Needle>
+    requires(std::same_as<typename decltype(Needle)::value_type, CharT>)
+  [[nodiscard]] constexpr auto
+  find(size_type pos = 0) const noexcept -> size_type
+  {
+    return detail::find_needle<Needle>(data(), size(), pos);
+  }
+
+  [[nodiscard]] constexpr auto
+  starts_with(std::basic_string_view<CharT> sv) const noexcept -> bool
+  {
+    return view().starts_with(sv);
+  }
+
+  [[nodiscard]] constexpr auto
+  ends_with(std::basic_string_view<CharT> sv) const noexcept -> bool
+  {
+    return view().ends_with(sv);
+  }
+
+  [[nodiscard]] constexpr auto
+  view() const noexcept -> std::basic_string_view<CharT>
+  {
+    return { _ptr, N };
+  }
+
+  [[nodiscard]] constexpr
+  operator std::basic_string_view<CharT>() const noexcept
+  {
+    return view();
+  }
+
+  // a copy of the characters
+  [[nodiscard]] constexpr auto
+  value() const noexcept -> basic_fixed_string<CharT, N>
+  {
+    return basic_fixed_string<CharT, N>{ begin(), end() };
   }
 
   template <std::size_t N2>
   [[nodiscard]] friend constexpr auto
-  operator==(basic_fixed_string const& lhs, basic_fixed_string<CharT, N2> const& rhs) noexcept
+  operator==(basic_fixed_string_ref lhs, basic_fixed_string_ref<CharT, N2> rhs) noexcept -> bool
+  {
+    if constexpr (N != N2) {
+      return false;
+    }
+    else {
+      if (std::is_constant_evaluated()) {
+        return lhs.view() == rhs.view();
+      }
+      if constexpr (detail::outline<CharT, N>) {
+        return detail::outline_equal(lhs.data(), rhs.data(), N * sizeof(CharT));
+      }
+      else {
+        return detail::equal<CharT, N>(lhs.data(), rhs.data());
+      }
+    }
+  }
+
+  template <std::size_t N2, typename Layout>
+  [[nodiscard]] friend constexpr auto
+  operator==(basic_fixed_string_ref lhs, basic_fixed_string<CharT, N2, Layout> const& rhs) noexcept
       -> bool
   {
-    return lhs.view() == rhs.view();
+    return lhs == basic_fixed_string_ref<CharT, N2>{ rhs };
+  }
+
+  [[nodiscard]] friend constexpr auto
+  operator==(basic_fixed_string_ref lhs, std::basic_string_view<CharT> rhs) noexcept -> bool
+  {
+    return lhs.view() == rhs;
+  }
+
+#ifdef MTP_HAS_THREE_WAY_COMPARE
+  template <std::size_t N2>
+  [[nodiscard]] friend constexpr auto
+  operator<=>(basic_fixed_string_ref lhs, basic_fixed_string_ref<CharT, N2> rhs) noexcept
+      -> std::strong_ordering
+  {
+    if (std::is_constant_evaluated()) {
+      return lhs.view() <=> rhs.view();
+    }
+    if constexpr (detail::outline<CharT, std::min(N, N2)>) {
+      if (auto const cmp = detail::outline_compare(lhs.data(), rhs.data(), std::min(N, N2));
+          cmp != 0) {
+        return cmp < 0 ? std::strong_ordering::less : std::strong_ordering::greater;
+      }
+      return N <=> N2;
+    }
+    else {
+      return detail::compare<CharT, N, N2>(lhs.data(), rhs.data());
+    }
+  }
+
+  template <std::size_t N2, typename Layout>
+  [[nodiscard]] friend constexpr auto
+  operator<=>(basic_fixed_string_ref lhs,
+              basic_fixed_string<CharT, N2, Layout> const& rhs) noexcept -> std::strong_ordering
+  {
+    return lhs <=> basic_fixed_string_ref<CharT, N2>{ rhs };
+  }
+
+  [[nodiscard]] friend constexpr auto
+  operator<=>(basic_fixed_string_ref lhs, std::basic_string_view<CharT> rhs) noexcept
+      -> std::strong_ordering
+  {
+    return lhs.view() <=> rhs;
+  }
+#endif
+
+  friend auto
+  operator<<(std::basic_ostream<CharT>& os, basic_fixed_string_ref fs) noexcept
+      -> std::basic_ostream<CharT>&
+  {
+    return os << fs.view();
+  }
+
+private:
+  const_pointer _ptr;
+};
+
+MTP_EXPORT template <typename CharT, std::size_t N, typename Layout>
+basic_fixed_string_ref(basic_fixed_string<CharT, N, Layout> const&)
+    -> basic_fixed_string_ref<CharT, N>;
+
+MTP_EXPORT template <typename CharT, std::size_t N>
+struct hash<basic_fixed_string_ref<CharT, N>>
+{
+  [[nodiscard]] constexpr auto
+  operator()(basic_fixed_string_ref<CharT, N> fs) const noexcept -> std::size_t
+  {
+    return static_cast<std::size_t>(detail::wyhash(fs.data(), N, 0));
+  }
+};
+
+// `Bytes` bytes of a binary record, read in place
+MTP_EXPORT template <std::size_t Bytes>
+class record_ref
+{
+public:
+  using const_pointer = unsigned char const*;
+
+  static constexpr std::integral_constant<std::size_t, Bytes> size{};
+
+  [[nodiscard]] explicit constexpr record_ref(const_pointer ptr) noexcept
+      : _ptr{ ptr }
+  {}
+
+  [[nodiscard]] constexpr auto
+  data() const noexcept -> const_pointer
+  {
+    return _ptr;
+  }
+
+  // the `N` characters at byte `Offset`, wider characters must be suitably aligned
+  template <std::size_t Offset, std::size_t N, typename CharT = char>
+    requires(Offset + N * sizeof(CharT) <= Bytes)
+  [[nodiscard]] auto
+  field() const noexcept -> basic_fixed_string_ref<CharT, N>
+  {
+    return basic_fixed_string_ref<CharT, N>{ reinterpret_cast<CharT const*>(_ptr + Offset) };
+  }
+
+  // the bytes at `Offset` copied out as a `T` (in the host's byte order)
+  template <typename T, std::size_t Offset>
+    requires(std::is_trivially_copyable_v<T> && Offset + sizeof(T) <= Bytes)
+  [[nodiscard]] auto
+  read() const noexcept -> T
+  {
+    T value;
+    std::memcpy(&value, _ptr + Offset, sizeof(T));
+    return value;
+  }
+
+private:
+  const_pointer _ptr;
+};
+
+// `Element`s constructed from pointers `stride` bytes apart, as a random-access range
+MTP_EXPORT template <typename Element>
+class strided_view
+{
+public:
+  using value_type = Element;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  class iterator
+  {
+  public:
+    using value_type = Element;
+    using difference_type = std::ptrdiff_t;
+    using reference = Element;
+    using pointer = void;
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+
+    [[nodiscard]] constexpr iterator() noexcept = default;
+
+    [[nodiscard]] constexpr iterator(unsigned char const* ptr, difference_type stride) noexcept
+        : _ptr{ ptr }
+        , _stride{ stride }
+    {}
+
+    [[nodiscard]] auto
+    operator*() const noexcept -> reference
+    {
+      return Element{ reinterpret_cast<typename Element::const_pointer>(_ptr) };
+    }
+
+    [[nodiscard]] auto
+    operator[](difference_type n) const noexcept -> reference
+    {
+      return *(*this + n);
+    }
+
+    constexpr auto
+    operator++() noexcept -> iterator&
+    {
+      _ptr += _stride;
+      return *this;
+    }
+
+    constexpr auto
+    operator++(int) noexcept -> iterator
+    {
+      auto const it = *this;
+      ++*this;
+      return it;
+    }
+
+    constexpr auto
+    operator--() noexcept -> iterator&
+    {
+      _ptr -= _stride;
+      return *this;
+    }
+
+    constexpr auto
+    operator--(int) noexcept -> iterator
+    {
+      auto const it = *this;
+      --*this;
+      return it;
+    }
+
+    constexpr auto
+    operator+=(difference_type n) noexcept -> iterator&
+    {
+      _ptr += n * _stride;
+      return *this;
+    }
+
+    constexpr auto
+    operator-=(difference_type n) noexcept -> iterator&
+    {
+      return *this += -n;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator+(iterator it, difference_type n) noexcept -> iterator
+    {
+      return it += n;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator+(difference_type n, iterator it) noexcept -> iterator
+    {
+      return it += n;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator-(iterator it, difference_type n) noexcept -> iterator
+    {
+      return it -= n;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator-(iterator lhs, iterator rhs) noexcept -> difference_type
+    {
+      return lhs._stride == 0 ? 0 : (lhs._ptr - rhs._ptr) / lhs._stride;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator==(iterator lhs, iterator rhs) noexcept -> bool
+    {
+      return lhs._ptr == rhs._ptr;
+    }
+
+    [[nodiscard]] friend constexpr auto
+    operator<=>(iterator lhs, iterator rhs) noexcept -> std::strong_ordering
+    {
+      return lhs._ptr <=> rhs._ptr;
+    }
+
+  private:
+    unsigned char const* _ptr = nullptr;
+    difference_type _stride = 0;
+  };
+
+  using const_iterator = iterator;
+
+  [[nodiscard]] constexpr strided_view() noexcept = default;
+
+  [[nodiscard]] strided_view(void const* first, size_type count, size_type stride) noexcept
+      : _first{ static_cast<unsigned char const*>(first) }
+      , _count{ count }
+      , _stride{ stride }
+  {}
+
+  [[nodiscard]] constexpr auto
+  size() const noexcept -> size_type
+  {
+    return _count;
   }
 
-#ifdef MTP_HAS_THREE_WAY_COMPARE
-  template <std::size_t N2>
-  [[nodiscard]] friend constexpr auto
-  operator<=>(basic_fixed_string const& lhs, basic_fixed_string<CharT, N2> const& rhs) noexcept
-      -> std::strong_ordering
+  [[nodiscard]] constexpr auto
+  empty() const noexcept -> bool
   {
-    return lhs.view() <=> rhs.view();
+    return _count == 0;
   }
-#endif
 
-  template <std::size_t N2>
-  [[nodiscard]] friend consteval auto
-  operator==(basic_fixed_string const& lhs, CharT const (&rhs)[N2]) noexcept -> bool
+  [[nodiscard]] constexpr auto
+  stride() const noexcept -> size_type
   {
-    MTP_EXPECTS(rhs[N2 - 1] == CharT{});
-    return lhs.view() == std::basic_string_view<CharT>{ rhs, N2 - 1 };
+    return _stride;
   }
 
-#ifdef MTP_HAS_THREE_WAY_COMPARE
-  template <std::size_t N2>
-  [[nodiscard]] friend consteval auto
-  operator<=>(basic_fixed_string const& lhs, CharT const (&rhs)[N2]) noexcept
-      -> std::strong_ordering
+  [[nodiscard]] constexpr auto
+  begin() const noexcept -> iterator
   {
-    MTP_EXPECTS(rhs[N2 - 1] == CharT{});
-    return lhs.view() <=> std::basic_string_view<CharT>{ rhs, N2 - 1 };
+    return iterator{ _first, static_cast<difference_type>(_stride) };
   }
-#endif
 
-  friend auto
-  operator<<(std::basic_ostream<CharT>& os, basic_fixed_string const& fs) noexcept
-      -> std::basic_ostream<CharT>&
+  [[nodiscard]] constexpr auto
+  end() const noexcept -> iterator
   {
-    return os << fs.view();
+    return begin() + static_cast<difference_type>(_count);
+  }
+
+  [[nodiscard]] auto
+  operator[](size_type i) const noexcept -> Element
+  {
+    MTP_EXPECTS(i < size());
+    return begin()[static_cast<difference_type>(i)];
+  }
+
+  [[nodiscard]] auto
+  front() const noexcept -> Element
+  {
+    MTP_EXPECTS(!empty());
+    return (*this)[0];
+  }
+
+  [[nodiscard]] auto
+  back() const noexcept -> Element
+  {
+    MTP_EXPECTS(!empty());
+    return (*this)[size() - 1];
   }
+
+private:
+  unsigned char const* _first = nullptr;
+  size_type _count = 0;
+  size_type _stride = 0;
 };
 
-namespace concepts {
+// the whole records of `Bytes` bytes in `[data, data + size)`, without a trailing partial one
+MTP_EXPORT template <std::size_t Bytes>
+[[nodiscard]] inline auto
+records(void const* data, std::size_t size) noexcept -> strided_view<record_ref<Bytes>>
+{
+  return { data, size / Bytes, Bytes };
+}
 
-template <typename T, typename... Ts>
-concept any_of = (... || std::same_as<T, Ts>);
+// the text field of `N` characters at byte `Offset` of every record of `Bytes` bytes
+MTP_EXPORT template <std::size_t Bytes, std::size_t Offset, std::size_t N, typename CharT = char>
+  requires(Offset + N * sizeof(CharT) <= Bytes)
+[[nodiscard]] inline auto
+fields(void const* data, std::size_t size) noexcept
+    -> strided_view<basic_fixed_string_ref<CharT, N>>
+{
+  return { static_cast<unsigned char const*>(data) + Offset, size / Bytes, Bytes };
+}
+
+#ifdef MTP_HAS_MMAP
+// a read-only private mapping of a whole file, kept until destruction. `access` is passed on to
+// `madvise` (sequential read-ahead drops pages behind the scan), `huge_pages` asks for transparent
+// huge pages where the kernel backs file mappings with them and `populate` faults the whole file in
+// up front
+MTP_EXPORT enum class mapped_file_access
+{
+  normal,
+  sequential,
+  random,
+};
+
+MTP_EXPORT struct mapped_file_options
+{
+  mapped_file_access pattern = mapped_file_access::sequential;
+  bool huge_pages = false;
+  bool populate = false;
+};
+
+MTP_EXPORT class mapped_file
+{
+public:
+  using access = mapped_file_access;
+  using options = mapped_file_options;
+
+  [[nodiscard]] mapped_file() noexcept = default;
+
+#  ifndef MTP_NO_EXCEPTIONS
+  // throws `std::system_error` if the file cannot be opened or mapped
+  [[nodiscard]] explicit mapped_file(char const* path, options opts = {})
+  {
+    auto ec = std::error_code{};
+    *this = open(path, opts, ec);
+    if (ec) {
+      throw std::system_error(ec, "mtp::mapped_file");
+    }
+  }
+#  endif
+
+  [[nodiscard]] mapped_file(mapped_file&& other) noexcept
+      : _data{ std::exchange(other._data, nullptr) }
+      , _size{ std::exchange(other._size, 0) }
+  {}
+
+  auto
+  operator=(mapped_file&& other) noexcept -> mapped_file&
+  {
+    if (this != &other) {
+      unmap();
+      _data = std::exchange(other._data, nullptr);
+      _size = std::exchange(other._size, 0);
+    }
+    return *this;
+  }
+
+  ~mapped_file()
+  {
+    unmap();
+  }
+
+  // an empty file maps to an empty `mapped_file` without error
+  [[nodiscard]] static auto
+  open(char const* path, options opts, std::error_code& ec) noexcept -> mapped_file
+  {
+    ec.clear();
+    auto const fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      ec.assign(errno, std::system_category());
+      return {};
+    }
+
+    auto file = mapped_file{};
+    struct stat st = {};
+    if (::fstat(fd, &st) != 0) {
+      ec.assign(errno, std::system_category());
+    }
+    else if (st.st_size > 0) {
+      auto flags = MAP_PRIVATE;
+#  ifdef MAP_POPULATE
+      if (opts.populate) {
+        flags |= MAP_POPULATE;
+      }
+#  endif
+      auto const size = static_cast<std::size_t>(st.st_size);
+      if (auto* const ptr = ::mmap(nullptr, size, PROT_READ, flags, fd, 0); ptr == MAP_FAILED) {
+        ec.assign(errno, std::system_category());
+      }
+      else {
+        file._data = static_cast<unsigned char const*>(ptr);
+        file._size = size;
+        file.advise(opts.pattern);
+#  ifdef MADV_HUGEPAGE
+        if (opts.huge_pages) {
+          ::madvise(ptr, size, MADV_HUGEPAGE);
+        }
+#  endif
+      }
+    }
+    ::close(fd);
+    return file;
+  }
+
+  [[nodiscard]] auto
+  data() const noexcept -> unsigned char const*
+  {
+    return _data;
+  }
+
+  [[nodiscard]] auto
+  size() const noexcept -> std::size_t
+  {
+    return _size;
+  }
+
+  [[nodiscard]] auto
+  empty() const noexcept -> bool
+  {
+    return _size == 0;
+  }
+
+  // a hint for the whole mapping, failures are ignored
+  auto
+  advise(access pattern) const noexcept -> void
+  {
+    if (_data != nullptr) {
+      auto const advice = pattern == access::sequential ? MADV_SEQUENTIAL
+                          : pattern == access::random   ? MADV_RANDOM
+                                                        : MADV_NORMAL;
+      ::madvise(const_cast<unsigned char*>(_data), _size, advice);
+    }
+  }
+
+  // starts reading `[offset, offset + length)` in ahead of use
+  auto
+  prefetch(std::size_t offset, std::size_t length) const noexcept -> void
+  {
+    if (offset < _size) {
+      auto const page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+      auto const first = offset / page * page;
+      length = std::min(length, _size - offset) + (offset - first);
+      ::madvise(const_cast<unsigned char*>(_data + first), length, MADV_WILLNEED);
+    }
+  }
+
+private:
+  unsigned char const* _data = nullptr;
+  std::size_t _size = 0;
+
+  auto
+  unmap() noexcept -> void
+  {
+    if (_data != nullptr) {
+      ::munmap(const_cast<unsigned char*>(_data), _size);
+    }
+  }
+};
+#endif
 
+// -------------------------------------------------------------------------------------------------
+
+// binary encoding of text fields in fixed-layout messages. a `basic_wire_string` is a field of
+// `Width` code units in byte order `Order`, holding a value of up to `Width` characters followed
+// by NULs or spaces, or after a length prefix of the smallest unsigned type that holds `Width` (in
+// the same byte order, the code units past the value are NULs). a NUL ends a NUL padded value and
+// trailing spaces of a space padded one are padding, a length prefix keeps any value. `encode` and
+// `decode` handle one field at the front of a byte span, `wire_layout` lays fields end to end at
+// offsets known at compile time. the padding of a field is stored as one constant block and the
+// value over it, fixed strings with constant sizes, so that a message is a few wide stores.
+// decoded `char` fields are views into the buffer, other character types are copied out into an
+// inplace string in the host's byte order. `wchar_t` is left out, its width is not portable
+
+namespace detail {
+
+template <std::unsigned_integral T>
+[[nodiscard]] constexpr auto
+byteswap(T value) noexcept -> T
+{
+  auto result = T{ 0 };
+  for (std::size_t i = 0; i < sizeof(T); ++i) {
+    result = static_cast<T>(result << 8 | (value & 0xFF));
+    value = static_cast<T>(value >> 8);
+  }
+  return result;
+}
+
+template <std::endian Order, typename T>
+[[nodiscard]] inline auto
+wire_load(std::byte const* in) noexcept -> T
+{
+  auto value = load<std::make_unsigned_t<T>>(reinterpret_cast<unsigned char const*>(in));
+  if constexpr (sizeof(T) > 1 && Order != std::endian::native) {
+    value = byteswap(value);
+  }
+  return static_cast<T>(value);
+}
+
+template <std::endian Order, typename T>
+inline auto
+wire_store(std::byte* out, T value) noexcept -> void
+{
+  auto bits = static_cast<std::make_unsigned_t<T>>(value);
+  if constexpr (sizeof(T) > 1 && Order != std::endian::native) {
+    bits = byteswap(bits);
+  }
+  std::memcpy(out, &bits, sizeof(T));
+}
+
+// the number of characters of a value known from its type, `npos` if it is only known at run time
 template <typename T>
-concept char_type =
-#ifdef MTP_HAS_CHAR8_TYPE
-    any_of<T, char, wchar_t, char8_t, char16_t, char32_t>;
+inline constexpr std::size_t wire_static_size = npos;
+
+template <typename CharT, std::size_t N, typename Layout>
+inline constexpr std::size_t wire_static_size<basic_fixed_string<CharT, N, Layout>> = N;
+
+template <typename CharT, std::size_t N>
+inline constexpr std::size_t wire_static_size<basic_fixed_string_ref<CharT, N>> = N;
+
+template <typename T, typename Field>
+concept wire_value =
+    std::convertible_to<T const&, std::basic_string_view<typename Field::char_type>>
+    && (wire_static_size<T> == npos || wire_static_size<T> <= Field::width);
+
+// the bytes of a field holding the empty string
+template <typename Field>
+inline constexpr auto wire_blank = [] {
+  using char_type = typename Field::char_type;
+  auto bytes = std::array<std::byte, Field::size>{};
+  if constexpr (Field::padding == wire_padding::space) {
+    for (std::size_t i = 0; i < Field::width * sizeof(char_type); ++i) {
+      auto const byte = i % sizeof(char_type);
+      auto const shift = Field::order == std::endian::little ? byte : sizeof(char_type) - 1 - byte;
+      bytes[i] = static_cast<std::byte>(code_unit(char_type{ ' ' }) >> (8 * shift) & 0xFF);
+    }
+  }
+  return bytes;
+}();
+
+template <typename Field>
+inline auto
+wire_write(std::byte* out, std::basic_string_view<typename Field::char_type> value) noexcept
+    -> void
+{
+  using char_type = typename Field::char_type;
+  MTP_EXPECTS(value.size() <= Field::width);
+  std::memcpy(out, wire_blank<Field>.data(), Field::size);
+  if constexpr (Field::padding == wire_padding::length_prefix) {
+    wire_store<Field::order>(out, static_cast<typename Field::length_type>(value.size()));
+    out += sizeof(typename Field::length_type);
+  }
+  if constexpr (sizeof(char_type) == 1 || Field::order == std::endian::native) {
+    if (!value.empty()) {
+      std::memcpy(out, value.data(), value.size() * sizeof(char_type));
+    }
+  }
+  else {
+    for (std::size_t i = 0; i < value.size(); ++i) {
+      wire_store<Field::order>(out + i * sizeof(char_type), value[i]);
+    }
+  }
+}
+
+template <typename Field, typename T>
+inline auto
+wire_encode(std::byte* out, T const& value) MTP_NOEXCEPT -> void
+{
+  auto const sv = std::basic_string_view<typename Field::char_type>{ value };
+  if constexpr (wire_static_size<T> == npos) {
+#ifdef MTP_NO_EXCEPTIONS
+    MTP_EXPECTS(sv.size() <= Field::width);
 #else
-    any_of<T, char, wchar_t, char16_t, char32_t>;
+    if (sv.size() > Field::width) {
+      throw std::length_error("mtp::encode");
+    }
 #endif
+  }
+  wire_write<Field>(out, sv);
+}
 
-} // namespace concepts
+template <wire_padding Padding, typename CharT>
+[[nodiscard]] constexpr auto
+wire_trim(std::basic_string_view<CharT> sv) noexcept -> std::basic_string_view<CharT>
+{
+  if constexpr (Padding == wire_padding::nul) {
+    return sv.substr(0, sv.find(CharT{}));
+  }
+  else if constexpr (Padding == wire_padding::space) {
+    return sv.substr(0, sv.find_last_not_of(CharT{ ' ' }) + 1);
+  }
+  else {
+    return sv;
+  }
+}
 
-MTP_EXPORT template <concepts::char_type CharT, std::convertible_to<CharT>... CharTs>
-basic_fixed_string(CharT, CharTs...) -> basic_fixed_string<CharT, 1 + sizeof...(CharTs)>;
+template <typename Field>
+[[nodiscard]] inline auto
+wire_decode(std::byte const* in) MTP_NOEXCEPT -> typename Field::value_type
+{
+  using char_type = typename Field::char_type;
+  auto length = std::size_t{ Field::width };
+  if constexpr (Field::padding == wire_padding::length_prefix) {
+    length = wire_load<Field::order, typename Field::length_type>(in);
+    in += sizeof(typename Field::length_type);
+    // the prefix comes off the wire, with `MTP_NO_EXCEPTIONS` it is clamped rather than trusted
+    if (length > Field::width) {
+#ifdef MTP_NO_EXCEPTIONS
+      length = Field::width;
+#else
+      throw std::length_error("mtp::decode");
+#endif
+    }
+  }
+  if constexpr (std::same_as<char_type, char>) {
+    return wire_trim<Field::padding>(std::string_view{ reinterpret_cast<char const*>(in), length });
+  }
+  else {
+    auto result = typename Field::value_type{};
+    result.resize_and_overwrite(length, [&](char_type* units, std::size_t count) {
+      if constexpr (sizeof(char_type) == 1 || Field::order == std::endian::native) {
+        std::memcpy(units, in, count * sizeof(char_type));
+      }
+      else {
+        for (std::size_t i = 0; i < count; ++i) {
+          units[i] = wire_load<Field::order, char_type>(in + i * sizeof(char_type));
+        }
+      }
+      return wire_trim<Field::padding>(std::basic_string_view<char_type>{ units, count }).size();
+    });
+    return result;
+  }
+}
 
-MTP_EXPORT template <concepts::char_type CharT, std::size_t N>
-basic_fixed_string(CharT const (&)[N]) -> basic_fixed_string<CharT, N - 1>;
+inline auto
+wire_check_size(std::size_t needed, std::size_t size, [[maybe_unused]] char const* what)
+    MTP_NOEXCEPT -> void
+{
+#ifdef MTP_NO_EXCEPTIONS
+  MTP_EXPECTS(needed <= size);
+#else
+  if (needed > size) {
+    throw_out_of_range(what);
+  }
+#endif
+}
 
-MTP_EXPORT template <concepts::char_type CharT, std::size_t N>
-basic_fixed_string(std::from_range_t, std::array<CharT, N>) -> basic_fixed_string<CharT, N>;
+} // namespace detail
+
+MTP_EXPORT template <typename CharT, std::size_t Width, wire_padding Padding, std::endian Order>
+  requires(Width > 0)
+struct basic_wire_string
+{
+  using char_type = CharT;
+  using length_type = detail::uint_least_t<Width>;
+  // what `decode` returns
+  using value_type = std::conditional_t<std::same_as<CharT, char>, std::string_view,
+                                        basic_inplace_string<CharT, Width>>;
+
+  static constexpr std::integral_constant<std::size_t, Width> width{};
+  static constexpr wire_padding padding = Padding;
+  static constexpr std::endian order = Order;
+  // bytes on the wire
+  static constexpr std::integral_constant<
+      std::size_t, (Padding == wire_padding::length_prefix ? sizeof(length_type) : 0)
+                       + Width * sizeof(CharT)>
+      size{};
+};
+
+// writes `value` as a `Field` at the front of `out` and returns the rest of `out`. throws
+// `std::out_of_range` if `out` is shorter than the field and `std::length_error` if `value` is
+// longer, a fixed string longer than the field does not compile
+MTP_EXPORT template <typename Field, typename T>
+  requires(detail::wire_value<T, Field>)
+inline auto
+encode(std::span<std::byte> out, T const& value) MTP_NOEXCEPT -> std::span<std::byte>
+{
+  detail::wire_check_size(Field::size, out.size(), "mtp::encode");
+  detail::wire_encode<Field>(out.data(), value);
+  return out.subspan(Field::size);
+}
+
+// reads the `Field` at the front of `in`. throws `std::out_of_range` if `in` is shorter than the
+// field and `std::length_error` if a length prefix is past the width
+MTP_EXPORT template <typename Field>
+[[nodiscard]] inline auto
+decode(std::span<std::byte const> in) MTP_NOEXCEPT -> typename Field::value_type
+{
+  detail::wire_check_size(Field::size, in.size(), "mtp::decode");
+  return detail::wire_decode<Field>(in.data());
+}
+
+// `Fields` end to end, the first at offset 0
+MTP_EXPORT template <typename... Fields>
+struct wire_layout
+{
+  using value_type = std::tuple<typename Fields::value_type...>;
+
+  static constexpr std::integral_constant<std::size_t, (std::size_t{ 0 } + ... + Fields::size)>
+      size{};
+
+  template <std::size_t I>
+    requires(I < sizeof...(Fields))
+  static constexpr std::size_t offset = [] {
+    constexpr auto sizes = std::array<std::size_t, sizeof...(Fields)>{ Fields::size... };
+    auto result = std::size_t{ 0 };
+    for (std::size_t i = 0; i < I; ++i) {
+      result += sizes[i];
+    }
+    return result;
+  }();
+
+  // writes one value per field at the front of `out` and returns the rest of `out`, see `encode`
+  template <typename... Ts>
+    requires(sizeof...(Ts) == sizeof...(Fields) && (... && detail::wire_value<Ts, Fields>))
+  static auto
+  encode(std::span<std::byte> out, Ts const&... values) MTP_NOEXCEPT -> std::span<std::byte>
+  {
+    detail::wire_check_size(size, out.size(), "mtp::wire_layout::encode");
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      (detail::wire_encode<Fields>(out.data() + offset<Is>, values), ...);
+    }(std::index_sequence_for<Fields...>{});
+    return out.subspan(size);
+  }
+
+  // the values of the fields at the front of `in`, see `decode`
+  [[nodiscard]] static auto
+  decode(std::span<std::byte const> in) MTP_NOEXCEPT -> value_type
+  {
+    detail::wire_check_size(size, in.size(), "mtp::wire_layout::decode");
+    return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      return value_type{ detail::wire_decode<Fields>(in.data() + offset<Is>)... };
+    }(std::index_sequence_for<Fields...>{});
+  }
+};
 
 } // namespace mtp
 
 namespace std {
 
-MTP_EXPORT template <typename CharT, size_t N>
+MTP_EXPORT template <typename CharT, size_t N, typename Layout>
 constexpr auto
-swap(::mtp::basic_fixed_string<CharT, N>& a, ::mtp::basic_fixed_string<CharT, N>& b) noexcept
-    -> void
+swap(::mtp::basic_fixed_string<CharT, N, Layout>& a,
+     ::mtp::basic_fixed_string<CharT, N, Layout>& b) noexcept -> void
 {
   a.swap(b);
 }
@@ -451,29 +10157,91 @@ MTP_EXPORT template <size_t N>
 struct hash<::mtp::fixed_u32string<N>> : hash<u32string_view>
 {};
 
-#ifdef MTP_HAS_FORMAT
+MTP_EXPORT template <typename CharT, size_t N, size_t Width, bool Terminated>
+struct hash<::mtp::basic_fixed_string<CharT, N, ::mtp::layout::simd<Width, Terminated>>>
+    : hash<basic_string_view<CharT>>
+{};
+
+MTP_EXPORT template <typename CharT, size_t Capacity>
+struct hash<::mtp::basic_inplace_string<CharT, Capacity>> : hash<basic_string_view<CharT>>
+{};
+
 MTP_EXPORT template <typename CharT, size_t N>
-struct formatter<::mtp::basic_fixed_string<CharT, N>> : formatter<basic_string_view<CharT>>
+struct hash<::mtp::basic_fixed_string_ref<CharT, N>> : hash<basic_string_view<CharT>>
+{};
+
+MTP_EXPORT template <>
+struct hash<::mtp::symbol_id>
+{
+  [[nodiscard]] auto
+  operator()(::mtp::symbol_id id) const noexcept -> size_t
+  {
+    return hash<uint32_t>{}(id.value());
+  }
+};
+
+// structured bindings of the groups of a regex match
+MTP_EXPORT template <typename CharT, size_t Groups>
+struct tuple_size<::mtp::basic_regex_result<CharT, Groups>> : integral_constant<size_t, Groups>
+{};
+
+MTP_EXPORT template <size_t I, typename CharT, size_t Groups>
+struct tuple_element<I, ::mtp::basic_regex_result<CharT, Groups>>
+{
+  using type = basic_string_view<CharT>;
+};
+
+#ifdef MTP_HAS_FORMAT
+MTP_EXPORT template <typename CharT, size_t N, typename Layout>
+struct formatter<::mtp::basic_fixed_string<CharT, N, Layout>> : formatter<basic_string_view<CharT>>
 {
   template <typename format_context>
   auto
-  format(::mtp::basic_fixed_string<CharT, N> const& fs, format_context& ctx) const
+  format(::mtp::basic_fixed_string<CharT, N, Layout> const& fs, format_context& ctx) const
       -> decltype(ctx.out())
   {
     return formatter<basic_string_view<CharT>>::format(basic_string_view<CharT>(fs), ctx);
   }
 };
+
+MTP_EXPORT template <typename CharT, size_t Capacity>
+struct formatter<::mtp::basic_inplace_string<CharT, Capacity>> : formatter<basic_string_view<CharT>>
+{
+  template <typename format_context>
+  auto
+  format(::mtp::basic_inplace_string<CharT, Capacity> const& is, format_context& ctx) const
+      -> decltype(ctx.out())
+  {
+    return formatter<basic_string_view<CharT>>::format(basic_string_view<CharT>(is), ctx);
+  }
+};
+
+MTP_EXPORT template <typename CharT, size_t N>
+struct formatter<::mtp::basic_fixed_string_ref<CharT, N>> : formatter<basic_string_view<CharT>>
+{
+  template <typename format_context>
+  auto
+  format(::mtp::basic_fixed_string_ref<CharT, N> fs, format_context& ctx) const
+      -> decltype(ctx.out())
+  {
+    return formatter<basic_string_view<CharT>>::format(fs.view(), ctx);
+  }
+};
 #endif
 
 } // namespace std
 
 // -------------------------------------------------------------------------------------------------
 
+#undef MTP_HAS_MMAP
+#undef MTP_HAS_AVX2
+#undef MTP_HAS_SSE2
 #undef MTP_HAS_THREE_WAY_COMPARE
 #undef MTP_HAS_CHAR8_TYPE
 #undef MTP_HAS_FROM_RANGE
 #undef MTP_HAS_FORMAT
 #undef MTP_HAS_INCLUDE
+#undef MTP_NOINLINE
 #undef MTP_NOEXCEPT
 #undef MTP_EXPECTS
 #undef MTP_EXPORT
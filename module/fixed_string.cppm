@@ -32,6 +32,16 @@ module;
 #  endif
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define MTP_HAS_SSE2
+#endif
+#if defined(__AVX2__)
+#  define MTP_HAS_AVX2
+#endif
+#if !defined(MTP_NO_MMAP) && MTP_HAS_INCLUDE(<sys/mman.h>) && MTP_HAS_INCLUDE(<unistd.h>)
+#  define MTP_HAS_MMAP
+#endif
+
 #if !defined(MTP_USE_STD_MODULE) && defined(__cpp_lib_modules)
 #  define MTP_USE_STD_MODULE
 #endif
@@ -41,13 +51,32 @@ module;
 #ifndef MTP_USE_STD_MODULE
 #  include <algorithm>
 #  include <array>
+#  include <atomic>
+#  include <bit>
+#  include <charconv>
 #  include <compare>
 #  include <concepts>
+#  ifdef MTP_PARALLEL_SORT
+#    include <condition_variable>
+#  endif
 #  include <cstddef>
+#  include <cstdint>
+#  include <cstring>
+#  if defined(MTP_PARALLEL_SORT) && !defined(MTP_NO_EXCEPTIONS)
+#    include <exception>
+#  endif
 #  ifdef MTP_HAS_FORMAT
 #    include <format>
 #  endif
+#  include <initializer_list>
 #  include <iterator>
+#  include <limits>
+#  include <memory>
+#  ifdef MTP_PARALLEL_SORT
+#    include <mutex>
+#  endif
+#  include <new>
+#  include <optional>
 #  include <ostream>
 #  ifdef MTP_HAS_FROM_RANGE
 #    include <ranges>
@@ -55,8 +84,28 @@ module;
 #  ifndef MTP_NO_EXCEPTIONS
 #    include <stdexcept>
 #  endif
+#  include <span>
 #  include <string_view>
+#  include <system_error>
+#  ifdef MTP_PARALLEL_SORT
+#    include <thread>
+#  endif
+#  include <tuple>
 #  include <type_traits>
+#  include <utility>
+#  include <vector>
+#endif
+
+#if defined(MTP_HAS_SSE2) || defined(MTP_HAS_AVX2)
+#  include <immintrin.h>
+#endif
+
+#ifdef MTP_HAS_MMAP
+#  include <cerrno>
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
 #endif
 
 // -------------------------------------------------------------------------------------------------
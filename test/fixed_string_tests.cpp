@@ -33,6 +33,10 @@ using namespace mtp;
 #  endif
 #endif
 
+#if !defined(MTP_NO_MMAP) && MTP_HAS_INCLUDE(<sys/mman.h>) && MTP_HAS_INCLUDE(<unistd.h>)
+#  define MTP_HAS_MMAP
+#endif
+
 #if !defined(MTP_NO_EXCEPTIONS) and !defined(__EXCEPTIONS)
 #  define MTP_NO_EXCEPTIONS
 #elif defined(MTP_NO_EXCEPTIONS) && defined(__EXCEPTIONS)
@@ -43,18 +47,33 @@ using namespace mtp;
 
 #include <algorithm>
 #include <array>
+#ifdef MTP_PARALLEL_SORT
+#  include <atomic>
+#endif
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#ifdef MTP_HAS_MMAP
+#  include <filesystem>
+#endif
 #ifdef MTP_HAS_FORMAT
 #  include <format>
 #endif
 #include <functional>
 #include <iostream>
+#include <limits>
 #ifdef MTP_HAS_FROM_RANGE
 #  include <ranges>
 #endif
+#include <regex>
 #ifdef MTP_NO_EXCEPTIONS
 #  include <stdexcept>
 #endif
+#include <string>
 #include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 using namespace std::string_view_literals;
 
 // -------------------------------------------------------------------------------------------------
@@ -66,6 +85,399 @@ concat_all() noexcept
   return (fixed_string<0>{ "" } + ... + fixstrs);
 }
 
+template <typename CharT, std::size_t N>
+auto
+check_comparisons() -> void
+{
+  auto chars = std::array<CharT, N>{};
+  for (std::size_t i = 0; i < N; ++i) {
+    chars[i] = static_cast<CharT>('a' + i % 26);
+  }
+  auto const fs = basic_fixed_string<CharT, N>{ chars.begin(), chars.end() };
+
+  for (std::size_t i = 0; i < N; ++i) {
+    for (auto const c : { static_cast<CharT>(chars[i] + 1), std::numeric_limits<CharT>::min(),
+                          std::numeric_limits<CharT>::max() }) {
+      auto other = chars;
+      other[i] = c;
+      auto const fs_other = basic_fixed_string<CharT, N>{ other.begin(), other.end() };
+
+      CHECK(fs != fs_other);
+#ifdef MTP_HAS_THREE_WAY_COMPARE
+      CHECK((fs <=> fs_other) == (fs.view() <=> fs_other.view()));
+      CHECK((fs_other <=> fs) == (fs_other.view() <=> fs.view()));
+#endif
+    }
+  }
+
+  auto const longer = fs + CharT{ 'z' };
+  CHECK(fs == fs);
+  CHECK(fs != longer);
+#ifdef MTP_HAS_THREE_WAY_COMPARE
+  CHECK((fs <=> fs) == std::strong_ordering::equal);
+  CHECK((fs <=> longer) == std::strong_ordering::less);
+  CHECK((longer <=> fs) == std::strong_ordering::greater);
+#endif
+}
+
+template <typename CharT, std::size_t... Ns>
+auto
+check_comparisons_for() -> void
+{
+  (check_comparisons<CharT, Ns>(), ...);
+}
+
+// haystacks over a small alphabet so that partial matches are frequent
+template <typename CharT>
+auto
+make_haystacks() -> std::vector<std::basic_string<CharT>>
+{
+  auto hays = std::vector<std::basic_string<CharT>>{};
+  auto state = std::uint32_t{ 12345 };
+  for (std::size_t length = 0; length < 160; length += 1 + length / 8) {
+    auto hay = std::basic_string<CharT>{};
+    for (std::size_t i = 0; i < length; ++i) {
+      state = state * 1664525u + 1013904223u;
+      hay += static_cast<CharT>("abx"[(state >> 24) % 3]);
+    }
+    hays.push_back(hay);
+  }
+  return hays;
+}
+
+template <basic_fixed_string Needle, typename CharT>
+auto
+check_needle(std::basic_string_view<CharT> sv) -> void
+{
+  CAPTURE(Needle.view());
+  for (std::size_t pos = 0; pos <= sv.size() + 1; ++pos) {
+    CAPTURE(pos);
+    CHECK(find<Needle>(sv, pos) == sv.find(Needle.view(), pos));
+    CHECK(find_first_of<Needle>(sv, pos) == sv.find_first_of(Needle.view(), pos));
+  }
+  CHECK(starts_with<Needle>(sv) == sv.starts_with(Needle.view()));
+  CHECK(ends_with<Needle>(sv) == sv.ends_with(Needle.view()));
+}
+
+template <basic_fixed_string... Needles>
+auto
+check_search() -> void
+{
+  using char_type = detail::pack_char_t<Needles...>;
+  for (auto const& hay : make_haystacks<char_type>()) {
+    CAPTURE(hay);
+    (check_needle<Needles>(std::basic_string_view<char_type>{ hay }), ...);
+  }
+}
+
+// `multi_search` against finding each needle at every end position, longest first, on whole
+// haystacks and on haystacks fed in two chunks split at every position
+template <basic_fixed_string... Needles>
+auto
+check_multi_search() -> void
+{
+  using char_type = detail::pack_char_t<Needles...>;
+  using search = multi_search<Needles...>;
+  auto const needles = std::array{ std::basic_string_view<char_type>{ Needles.view() }... };
+
+  for (auto const& hay : make_haystacks<char_type>()) {
+    CAPTURE(hay);
+    auto const sv = std::basic_string_view<char_type>{ hay };
+    auto expected = std::vector<multi_match>{};
+    for (std::size_t end = 1; end <= sv.size(); ++end) {
+      auto const first = expected.size();
+      for (std::size_t k = 0; k < needles.size(); ++k) {
+        auto const begin = end - std::min(end, needles[k].size());
+        if (sv.substr(begin, end - begin) == needles[k]) {
+          expected.push_back({ k, begin });
+        }
+      }
+      std::sort(expected.begin() + static_cast<std::ptrdiff_t>(first), expected.end(),
+                [&](auto const& lhs, auto const& rhs) {
+                  return needles[lhs.needle].size() > needles[rhs.needle].size();
+                });
+    }
+
+    auto found = std::vector<multi_match>{};
+    auto const collect = [&](multi_match const& match) { found.push_back(match); };
+    search::for_each(sv, collect);
+    CHECK(found == expected);
+    for (std::size_t split = 0; split <= sv.size(); split += 1 + split / 16) {
+      CAPTURE(split);
+      found.clear();
+      auto stream = search{};
+      stream.feed(sv.substr(0, split), collect);
+      stream.feed(sv.substr(split), collect);
+      CHECK(found == expected);
+      CHECK(stream.consumed() == sv.size());
+    }
+    CHECK(search::find(sv)
+          == (expected.empty() ? std::optional<multi_match>{} : std::optional{ expected.front() }));
+  }
+}
+
+// `to_fixed_string` against `std::to_chars` for each value
+template <auto... Values>
+auto
+check_to_chars() -> void
+{
+  auto const check = [](auto const& str, auto value) {
+    auto buffer = std::array<char, 64>{};
+    auto const* end = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value).ptr;
+    CHECK(str.view() == std::string_view(buffer.data(), end));
+  };
+  (check(to_fixed_string<Values>(), Values), ...);
+}
+
+// the bulk kernels of `Column` against element by element comparisons, over codes drawn from a
+// small alphabet so that equal elements and shared prefixes are common
+template <typename Column>
+auto
+check_column() -> void
+{
+  using value_type = typename Column::value_type;
+  using char_type = typename value_type::value_type;
+  constexpr auto n = value_type::size();
+
+  auto state = std::uint32_t{ 2024 };
+  auto column = Column{};
+  auto values = std::vector<value_type>{};
+  for (std::size_t i = 0; i < 300; ++i) {
+    auto code = std::basic_string<char_type>{};
+    for (std::size_t j = 0; j < n; ++j) {
+      state = state * 1664525u + 1013904223u;
+      code += static_cast<char_type>("ab"[(state >> 24) % (j < 2 ? 2 : 1)]);
+    }
+    values.push_back(value_type{ code.begin(), code.end() });
+    column.push_back(values.back());
+  }
+  REQUIRE(column.size() == values.size());
+
+  auto bitmap = std::vector<std::uint64_t>(column.bitmap_size());
+  auto const marked = [&](std::size_t i) { return ((bitmap[i / 64] >> (i % 64)) & 1) != 0; };
+  for (std::size_t k = 0; k < 4; ++k) {
+    CAPTURE(k);
+    auto const& needle = values[k];
+    auto const count = column.equals(needle, bitmap.data());
+    auto expected = std::size_t{ 0 };
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      CAPTURE(i);
+      expected += values[i] == needle;
+      CHECK(marked(i) == (values[i] == needle));
+    }
+    CHECK(count == expected);
+
+    for (std::size_t length = 0; length <= n; ++length) {
+      CAPTURE(length);
+      auto const prefix = needle.view().substr(0, length);
+      auto const prefixed = column.starts_with(prefix, bitmap.data());
+      expected = 0;
+      for (std::size_t i = 0; i < values.size(); ++i) {
+        CAPTURE(i);
+        expected += values[i].view().starts_with(prefix);
+        CHECK(marked(i) == values[i].view().starts_with(prefix));
+      }
+      CHECK(prefixed == expected);
+    }
+  }
+
+  auto hashes = std::vector<std::size_t>(column.size());
+  column.hash_to(hashes.data());
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    CAPTURE(i);
+    CHECK(hashes[i] == mtp::hash<>{}(values[i]));
+  }
+}
+
+// the radix sorts against `std::sort`, over strings sharing long prefixes and using characters at
+// both ends of the range of `CharT`
+template <typename Fs>
+auto
+check_radix_sort(std::size_t count) -> void
+{
+  using char_type = typename Fs::value_type;
+  constexpr auto alphabet = std::array{ std::numeric_limits<char_type>::min(), char_type{ 0 },
+                                        char_type{ 'a' }, char_type{ 'b' },
+                                        std::numeric_limits<char_type>::max() };
+
+  auto state = std::uint32_t{ 99 };
+  auto strings = std::vector<Fs>{};
+  for (std::size_t i = 0; i < count; ++i) {
+    auto str = std::basic_string<char_type>{};
+    for (std::size_t j = 0; j < Fs::size(); ++j) {
+      state = state * 1664525u + 1013904223u;
+      str += j < Fs::size() / 2 && i % 16 != 0 ? char_type{ 'a' }
+                                                : alphabet[(state >> 24) % alphabet.size()];
+    }
+    strings.push_back(Fs{ str.begin(), str.end() });
+  }
+  auto expected = strings;
+  std::sort(expected.begin(), expected.end());
+
+  auto sorted = strings;
+  mtp::sort(sorted);
+  CHECK(sorted == expected);
+  sorted = strings;
+  mtp::stable_sort(sorted);
+  CHECK(sorted == expected);
+#ifdef MTP_PARALLEL_SORT
+  sorted = strings;
+  mtp::parallel_sort(sorted, 4);
+  CHECK(sorted == expected);
+#endif
+}
+
+// the case insensitive kernels against folding both sides first, for pairs of every length up to
+// past two vectors that differ in case or in one character, around the letters and at the top of
+// the range of `CharT`
+template <typename CharT>
+auto
+check_case_insensitive() -> void
+{
+  using string_type = std::basic_string<CharT>;
+  using view_type = std::basic_string_view<CharT>;
+  constexpr auto alphabet =
+      std::array{ CharT{ 'A' }, CharT{ 'Z' }, CharT{ 'a' }, CharT{ 'z' }, CharT{ '@' },
+                  CharT{ '[' }, CharT{ '`' }, CharT{ '{' }, CharT{ '0' },
+                  static_cast<CharT>(std::numeric_limits<CharT>::max() - 'z'),
+                  std::numeric_limits<CharT>::max() };
+
+  auto const lower = [](view_type str) {
+    auto folded = string_type{ str };
+    for (auto& ch : folded) {
+      ch = ch >= CharT{ 'A' } && ch <= CharT{ 'Z' } ? static_cast<CharT>(ch + ('a' - 'A')) : ch;
+    }
+    return folded;
+  };
+  auto const sign = [](auto cmp) { return cmp < 0 ? -1 : cmp > 0 ? 1 : 0; };
+
+  auto state = std::uint32_t{ 7 };
+  for (std::size_t size = 0; size <= 70; ++size) {
+    for (std::size_t round = 0; round < 8; ++round) {
+      auto lhs = string_type{};
+      for (std::size_t i = 0; i < size; ++i) {
+        state = state * 1664525u + 1013904223u;
+        lhs += alphabet[(state >> 24) % alphabet.size()];
+      }
+      auto rhs = lhs;
+      for (auto& ch : rhs) {
+        state = state * 1664525u + 1013904223u;
+        if (ch >= CharT{ 'a' } && ch <= CharT{ 'z' } && (state >> 31) != 0) {
+          ch = static_cast<CharT>(ch - ('a' - 'A'));
+        }
+      }
+      if (size != 0 && round % 2 != 0) {
+        state = state * 1664525u + 1013904223u;
+        rhs[(state >> 16) % size] = alphabet[(state >> 8) % alphabet.size()];
+      }
+
+      CAPTURE(lhs);
+      CAPTURE(rhs);
+      auto const expected = lower(lhs) == lower(rhs);
+      CHECK(iequals(view_type{ lhs }, view_type{ rhs }) == expected);
+      CHECK(sign(icompare(view_type{ lhs }, view_type{ rhs }))
+            == sign(lower(lhs).compare(lower(rhs))));
+      CHECK(sign(icompare(view_type{ lhs }, view_type{ rhs }.substr(0, size / 2)))
+            == sign(lower(lhs).compare(lower(rhs.substr(0, size / 2)))));
+      CHECK(ihash{}(view_type{ lhs }) == mtp::hash<>{}(lower(lhs)));
+      if (expected) {
+        CHECK(ihash{}(lhs) == ihash{}(rhs));
+      }
+    }
+  }
+}
+
+// every code point, between runs of ascii long enough for the vector path that end at every offset
+// within a vector, through `From` and `To` and back to utf-32
+template <typename From, typename To>
+auto
+check_transcode() -> void
+{
+  for (auto cp = char32_t{}; cp <= 0x10FFFF; cp += cp < 0x800 ? 1 : 61) {
+    if (cp >= 0xD800 && cp <= 0xDFFF) {
+      continue;
+    }
+    INFO("code point " << static_cast<std::uint32_t>(cp));
+    auto const text = std::u32string(cp % 37, U'a') + cp + U"-" + std::u32string(17, U'z');
+
+    From source[64] = {};
+    auto const source_size = transcoded_size<From>(std::u32string_view{ text });
+    std::ignore = transcode(std::u32string_view{ text }, source, source + 64);
+
+    To encoded[64] = {};
+    auto const size = transcoded_size<To>(std::basic_string_view<From>{ source, source_size });
+    auto const [in, out, ec] =
+        transcode(std::basic_string_view<From>{ source, source_size }, encoded, encoded + 64);
+    CHECK(ec == std::errc{});
+    CHECK(in == source + source_size);
+    CHECK(static_cast<std::size_t>(out - encoded) == size);
+
+    char32_t decoded[64] = {};
+    auto const back = transcode(std::basic_string_view<To>{ encoded, size }, decoded, decoded + 64);
+    CHECK(back.ec == std::errc{});
+    CHECK(std::u32string_view{ decoded, back.out } == text);
+  }
+}
+
+// `regex_match` and `regex_search` against `std::regex` (ecmascript) on each input, groups included
+template <basic_fixed_string Pattern>
+auto
+check_regex(std::initializer_list<std::string_view> inputs) -> void
+{
+  auto const re = std::regex{ Pattern.data(), Pattern.size() };
+  auto const check = [](std::string_view function, auto const& result, auto const& expected,
+                        std::string_view input) {
+    CAPTURE(function);
+    CHECK(static_cast<bool>(result) == !expected.empty());
+    for (std::size_t g = 0; g < result.size() && !expected.empty(); ++g) {
+      CAPTURE(g);
+      auto const& group = expected[g];
+      CHECK((result[g].data() != nullptr) == group.matched);
+      if (group.matched) {
+        CHECK(result[g] == group.str());
+        CHECK(result[g].data() - input.data() == group.first - input.begin());
+      }
+    }
+  };
+
+  for (auto const input : inputs) {
+    CAPTURE(input);
+    auto expected = std::match_results<std::string_view::const_iterator>{};
+    std::regex_match(input.begin(), input.end(), expected, re);
+    check("regex_match", regex_match<Pattern>(input), expected, input);
+    std::regex_search(input.begin(), input.end(), expected, re);
+    check("regex_search", regex_search<Pattern>(input), expected, input);
+  }
+}
+
+// `regex_search` against the ecmascript captures, for patterns where libstdc++'s `std::regex`
+// keeps the captures of earlier iterations or takes an empty one past the minimum; each group is
+// its offset into `input`, -1 when unset, and its text, an empty list meaning no match
+template <basic_fixed_string Pattern>
+auto
+check_regex_captures(std::string_view input,
+                     std::initializer_list<std::pair<std::ptrdiff_t, std::string_view>> groups)
+    -> void
+{
+  CAPTURE(input);
+  auto const result = regex_search<Pattern>(input);
+  CHECK(static_cast<bool>(result) == (groups.size() != 0));
+  if (!result || groups.size() == 0) {
+    return;
+  }
+  CHECK(result.size() == groups.size());
+  auto g = std::size_t{ 0 };
+  for (auto const& [offset, text] : groups) {
+    CAPTURE(g);
+    CHECK((result[g].data() != nullptr) == (offset >= 0));
+    if (offset >= 0) {
+      CHECK(result[g].data() - input.data() == offset);
+      CHECK(result[g] == text);
+    }
+    ++g;
+  }
+}
+
 // -------------------------------------------------------------------------------------------------
 
 TEST_CASE("constructors")
@@ -271,6 +683,32 @@ TEST_CASE("swap")
   std::swap(fs_0, fs_1);
   CHECK(std::string_view{ fs_0 } == "123"sv);
   CHECK(std::string_view{ fs_1 } == "abc"sv);
+
+  { // past the outline threshold, at run time and at compile time
+    constexpr auto make = [](char ch) {
+      auto chars = std::array<char, detail::outline_bytes + 3>{};
+      chars.fill(ch);
+      return fixed_string<chars.size()>{ chars.begin(), chars.end() };
+    };
+    static_assert(detail::outline<char, decltype(make('x'))::size()>);
+
+    auto fs_2 = make('x');
+    auto fs_3 = make('y');
+    fs_2.swap(fs_3);
+    CHECK(fs_2 == make('y'));
+    CHECK(fs_3 == make('x'));
+    CHECK(fs_3.c_str()[fs_3.size()] == '\0');
+    static_assert([make] {
+      auto lhs = make('x');
+      auto rhs = make('y');
+      lhs.swap(rhs);
+      return lhs == make('y') && rhs == make('x');
+    }());
+#ifndef MTP_NO_EXCEPTIONS
+    CHECK_THROWS_WITH_AS(std::ignore = fs_2.at(fs_2.size()), "mtp::basic_fixed_string::at",
+                         std::out_of_range);
+#endif
+  }
 }
 
 TEST_CASE("concat")
@@ -289,6 +727,30 @@ TEST_CASE("concat")
 
     constexpr auto fs_1 = "12" + ('3' + fixed_string<1>{ '4' });
     static_assert(fs_1.view() == "1234"sv);
+
+    using padded = basic_fixed_string<char, 2, layout::simd<16>>;
+    static_assert(std::same_as<decltype(padded{ "12" } + fixed_string<1>{ "3" }),
+                               basic_fixed_string<char, 3, layout::simd<16>>>);
+    static_assert((padded{ "12" } + '3').view() == "123"sv);
+  }
+
+  { // concat and join
+    static_assert(concat(fixed_string<3>{ "net" }, '.', "http", fixed_string<0>{}) == "net.http"sv);
+    static_assert(std::same_as<decltype(concat("ab", 'c', fixed_string<2>{ "de" })),
+                               fixed_string<5>>);
+    static_assert(concat('x') == "x"sv);
+    static_assert(concat(u"wide", u'!') == u"wide!"sv);
+    static_assert(join<", ">(fixed_string<1>{ "a" }, "bc", 'd') == "a, bc, d"sv);
+    static_assert(join<"::">("std") == "std"sv);
+    static_assert(std::same_as<decltype(join<"/">("a", "b", "c")), fixed_string<5>>);
+    static_assert(concat_all<"01", "23", "45", "67", "89">()
+                  == concat("01", "23", "45", "67", "89"));
+
+    auto const host = fixed_string<5>{ "db-01" };
+    auto const port = to_fixed_string<5432>();
+    CHECK(concat(host, ':', port) == "db-01:5432"sv);
+    CHECK(join<".">(host, "eu", fixed_string<4>{ "prod" }) == "db-01.eu.prod"sv);
+    CHECK(concat(host, host, host).c_str()[15] == '\0');
   }
 }
 
@@ -319,6 +781,14 @@ TEST_CASE("comparisons")
     static_assert(fs_0 == fs_1);
     static_assert(fs_0 != fs_2);
   }
+
+  { // sizes and character types
+    check_comparisons_for<char, 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65,
+                          100>();
+    check_comparisons_for<wchar_t, 0, 1, 3, 4, 5, 8, 9, 16, 17, 40>();
+    check_comparisons_for<char16_t, 0, 1, 2, 3, 4, 7, 8, 9, 16, 17, 33>();
+    check_comparisons_for<char32_t, 0, 1, 2, 3, 4, 5, 8, 9, 17, 40>();
+  }
 }
 
 #ifdef MTP_HAS_THREE_WAY_COMPARE
@@ -340,6 +810,42 @@ TEST_CASE("sort")
 
   std::sort(fixstrs.begin(), fixstrs.end());
   CHECK(fixstrs == sorted);
+
+  check_radix_sort<fixed_string<1>>(1000);
+  check_radix_sort<fixed_string<12>>(5000);
+  check_radix_sort<fixed_string<12>>(40000);
+  check_radix_sort<fixed_string<20>>(20000);
+  check_radix_sort<basic_fixed_string<char, 20, layout::simd<32>>>(3000);
+  check_radix_sort<fixed_wstring<3>>(3000);
+  check_radix_sort<fixed_u16string<4>>(20000);
+  check_radix_sort<fixed_u32string<2>>(3000);
+
+#if defined(MTP_PARALLEL_SORT) && !defined(MTP_NO_EXCEPTIONS)
+  SUBCASE("a throwing step")
+  {
+    // `run` rethrows only once every thread is done with the step, and the threads stay usable
+    auto workers = detail::thread_workers{ 4 };
+    auto calls = std::atomic<std::size_t>{ 0 };
+    CHECK_THROWS_WITH_AS(workers.run([&](std::size_t t) {
+      ++calls;
+      if (t % 2 == 1) {
+        throw std::runtime_error{ "worker" };
+      }
+    }),
+                         "worker", std::runtime_error);
+    CHECK(calls == 4);
+    CHECK_THROWS_WITH_AS(workers.run([&](std::size_t t) {
+      ++calls;
+      if (t == 0) {
+        throw std::runtime_error{ "caller" };
+      }
+    }),
+                         "caller", std::runtime_error);
+    CHECK(calls == 8);
+    workers.run([&](std::size_t) { ++calls; });
+    CHECK(calls == 12);
+  }
+#endif
 }
 #endif
 
@@ -353,6 +859,58 @@ TEST_CASE("hash")
   CHECK(std::hash<fixed_string<3>>{}(fs_1) != std::hash<std::string_view>{}(sv));
 }
 
+TEST_CASE("mtp::hash")
+{
+  { // run time
+    auto const fs = fixed_string<5>{ "hello" };
+    auto const str = std::string{ "hello" };
+
+    CHECK(mtp::hash<fixed_string<5>>{}(fs) == mtp::hash<std::string_view>{}(str));
+    CHECK(mtp::hash<>{}(fs) == mtp::hash<>{}(str));
+    CHECK(mtp::hash<>{}(fs) == mtp::hash_v<"hello">);
+    CHECK(mtp::hash<>{}(fs) != mtp::hash<>{}("hellO"sv));
+    CHECK(mtp::hash<>{}(fs) != mtp::hash<>{}("hell"sv));
+    CHECK(mtp::hash<>{}(fixed_string<0>{}) == mtp::hash<>{}(""sv));
+  }
+
+  { // compile time
+    constexpr auto fs = fixed_string<5>{ "hello" };
+
+    static_assert(mtp::hash<fixed_string<5>>{}(fs) == mtp::hash<std::string_view>{}("hello"sv));
+    static_assert(mtp::hash_v<"hello"> == mtp::hash<>{}(fs));
+    static_assert(mtp::hash_v<u"hello"> == mtp::hash<>{}(u"hello"sv));
+    static_assert(mtp::hash_v<U"hello"> == mtp::hash<>{}(U"hello"sv));
+    static_assert(mtp::hash_v<L"hello"> == mtp::hash<>{}(L"hello"sv));
+    static_assert(mtp::hash_v<u8"hello"> == mtp::hash<>{}(u8"hello"sv));
+    static_assert(mtp::prehashed_v<"hello">.hash == mtp::hash_v<"hello">);
+  }
+
+  { // consistent for all sizes
+    auto const str = std::u16string{ u"the quick brown fox jumps over the lazy dog" };
+    for (std::size_t i = 0; i <= str.size(); ++i) {
+      auto const sv = std::u16string_view{ str }.substr(0, i);
+      auto const copy = std::u16string{ sv };
+      CHECK(mtp::hash<>{}(sv) == mtp::hash<>{}(copy));
+      if (i > 0) {
+        CHECK(mtp::hash<>{}(sv) != mtp::hash<>{}(std::u16string_view{ str }.substr(1, i)));
+      }
+    }
+    static_assert(mtp::hash_v<"the quick brown fox jumps over the lazy dog">
+                  == mtp::hash<>{}("the quick brown fox jumps over the lazy dog"sv));
+  }
+
+  { // heterogeneous lookup
+    auto map = std::unordered_map<fixed_string<3>, int, mtp::hash<>, mtp::equal_to>{};
+    map.emplace(fixed_string<3>{ "abc" }, 1);
+    map.emplace(fixed_string<3>{ "xyz" }, 2);
+
+    CHECK(map.find("abc"sv)->second == 1);
+    CHECK(map.find(std::string{ "xyz" })->second == 2);
+    CHECK(map.find(mtp::prehashed_v<"xyz">)->second == 2);
+    CHECK(map.find("abd"sv) == map.end());
+  }
+}
+
 #ifdef MTP_HAS_FORMAT
 TEST_CASE("format")
 {
@@ -366,3 +924,1509 @@ TEST_CASE("stream")
   auto const fs = fixed_string<14>{ "Hello, World!\n" };
   std::cout << fs;
 }
+
+TEST_CASE("static_map")
+{
+  using methods = static_map<int, "GET", "PUT", "POST", "DELETE", "HEAD", "OPTIONS", "PATCH">;
+
+  { // run time
+    auto map = methods{ 1, 2, 3, 4, 5, 6, 7 };
+    auto const sv = std::string{ "DELETE" };
+
+    CHECK(map.size() == 7);
+    CHECK(map.index_of(sv) == 3);
+    CHECK(map.at(sv) == 4);
+    CHECK(*map.find("PATCH"sv) == 7);
+    CHECK(map.find("PATCHES"sv) == nullptr);
+    CHECK(map.find("get"sv) == nullptr);
+    CHECK(map.find(""sv) == nullptr);
+    CHECK(not map.contains("TRACE"sv));
+#ifndef MTP_NO_EXCEPTIONS
+    CHECK_THROWS_WITH_AS(std::ignore = map.at("TRACE"sv), "mtp::static_map::at", std::out_of_range);
+#endif
+
+    map.at("GET"sv) = 10;
+    *map.find("PUT"sv) += 10;
+    map.get<"POST">() = 30;
+    CHECK(map.values() == std::array{ 10, 12, 30, 4, 5, 6, 7 });
+  }
+
+  { // compile time
+    constexpr auto map = methods{ 1, 2, 3, 4, 5, 6, 7 };
+
+    static_assert(map.index_of("GET"sv) == 0);
+    static_assert(map.at("OPTIONS"sv) == 6);
+    static_assert(map.find("CONNECT"sv) == nullptr);
+    static_assert(map.get<"HEAD">() == 5);
+    static_assert(map.keys()[2] == "POST"sv);
+  }
+
+  { // many keys
+    using headers =
+        static_map<std::size_t, "accept", "accept-charset", "accept-encoding", "accept-language",
+                   "authorization", "cache-control", "connection", "content-encoding",
+                   "content-length", "content-type", "cookie", "date", "expect", "forwarded",
+                   "from", "host", "if-match", "if-modified-since", "if-none-match", "if-range",
+                   "if-unmodified-since", "max-forwards", "origin", "pragma",
+                   "proxy-authorization", "range", "referer", "te", "trailer",
+                   "transfer-encoding", "upgrade", "user-agent", "via", "warning">;
+    auto const map = headers{};
+
+    for (std::size_t i = 0; i < map.size(); ++i) {
+      CHECK(map.index_of(std::string{ map.keys()[i] }) == i);
+      CHECK(not map.contains(std::string{ map.keys()[i] } + "x"));
+    }
+  }
+
+  { // hundreds of keys, within the default constexpr evaluation limits
+    constexpr auto map = []<std::size_t... I>(std::index_sequence<I...>) {
+      return static_map<std::size_t, concat("field_name_", to_fixed_string<I>())...>{ I... };
+    }(std::make_index_sequence<400>{});
+
+    static_assert(map.at("field_name_399"sv) == 399);
+    for (std::size_t i = 0; i < map.size(); ++i) {
+      CHECK(map.at(std::string{ map.keys()[i] }) == i);
+    }
+    CHECK(not map.contains("field_name_400"sv));
+  }
+
+  { // other character types
+    constexpr auto map = static_map<char, u"alpha", u"beta", u"gamma">{ 'a', 'b', 'c' };
+    static_assert(map.at(u"beta"sv) == 'b');
+    CHECK(map.at(std::u16string{ u"gamma" }) == 'c');
+    CHECK(not map.contains(u"delta"sv));
+  }
+}
+
+TEST_CASE("string_switch")
+{
+  auto const method = [](std::string_view sv) {
+    return string_switch<"GET", "PUT", "POST", "PATCH", "DELETE", "HEAD", "">(
+        sv, [] { return 1; }, [] { return 2; }, [] { return 3; }, [] { return 4; },
+        [] { return 5; }, [] { return 6; }, [] { return 7; }, [] { return 0; });
+  };
+
+  { // run time
+    CHECK(method(std::string{ "GET" }) == 1);
+    CHECK(method(std::string{ "PUT" }) == 2);
+    CHECK(method(std::string{ "POST" }) == 3);
+    CHECK(method(std::string{ "PATCH" }) == 4);
+    CHECK(method(std::string{ "DELETE" }) == 5);
+    CHECK(method(std::string{ "HEAD" }) == 6);
+    CHECK(method(std::string{ "" }) == 7);
+    CHECK(method(std::string{ "GOT" }) == 0);
+    CHECK(method(std::string{ "PUSH" }) == 0);
+    CHECK(method(std::string{ "DELETED" }) == 0);
+
+    auto calls = std::string{};
+    string_switch<"a", "b">("b"sv, [&] { calls += 'a'; }, [&] { calls += 'b'; });
+    string_switch<"a", "b">("c"sv, [&] { calls += 'a'; }, [&] { calls += 'b'; });
+    CHECK(calls == "b");
+  }
+
+  { // compile time
+    static_assert(method("PATCH"sv) == 4);
+    static_assert(method("PATCHY"sv) == 0);
+    static_assert(string_switch_index<"x", "y", "z">("y"sv) == 1);
+    static_assert(string_switch_index<"x", "y", "z">("w"sv) == 3);
+    static_assert(string_switch_index<u"xy", u"yx", u"xx">(u"xx"sv) == 2);
+  }
+
+  { // many cases sharing prefixes
+    constexpr auto index = [](std::string_view sv) {
+      return string_switch_index<"content-encoding", "content-language", "content-length",
+                                 "content-location", "content-md5", "content-range",
+                                 "content-type", "contents", "content", "con">(sv);
+    };
+    static_assert(index("content-length"sv) == 2);
+    static_assert(index("content-lengtx"sv) == 10);
+    static_assert(index("content-type"sv) == 6);
+    static_assert(index("content"sv) == 8);
+    static_assert(index("contend"sv) == 10);
+    static_assert(index("con"sv) == 9);
+    CHECK(index(std::string{ "content-location" }) == 3);
+    CHECK(index(std::string{ "content-md6" }) == 10);
+  }
+
+  { // many cases of one length
+    constexpr auto index = []<std::size_t... Is>(std::string_view sv, std::index_sequence<Is...>) {
+      return string_switch_index<fixed_string<3>{ 't', static_cast<char>('a' + Is % 16),
+                                                  static_cast<char>('a' + Is / 16) }...>(sv);
+    };
+    static_assert(index("taa"sv, std::make_index_sequence<256>{}) == 0);
+    static_assert(index("tpb"sv, std::make_index_sequence<256>{}) == 31);
+    static_assert(index("tpp"sv, std::make_index_sequence<256>{}) == 255);
+    static_assert(index("tpq"sv, std::make_index_sequence<256>{}) == 256);
+    CHECK(index(std::string{ "tcd" }, std::make_index_sequence<256>{}) == 50);
+  }
+
+  { // handlers returning references
+    auto get = 0;
+    auto put = 0;
+    auto other = 0;
+    auto const counter = [&](std::string_view sv) -> int& {
+      return string_switch<"GET", "PUT">(
+          sv, [&]() -> int& { return get; }, [&]() -> int& { return put; },
+          [&]() -> int& { return other; });
+    };
+    static_assert(std::is_same_v<decltype(string_switch<"a">(""sv, [&]() -> int& { return get; },
+                                                             [&]() -> int& { return put; })),
+                                 int&>);
+    ++counter(std::string{ "PUT" });
+    ++counter(std::string{ "PUT" });
+    ++counter(std::string{ "POST" });
+    CHECK(get == 0);
+    CHECK(put == 2);
+    CHECK(other == 1);
+    CHECK(&counter("GET"sv) == &get);
+  }
+}
+
+TEST_CASE("inplace_string")
+{
+  static_assert(std::is_trivially_copyable_v<inplace_string<15>>);
+  static_assert(sizeof(inplace_string<15>) == 17);
+  static_assert(sizeof(inplace_string<255>::_size) == 1);
+  static_assert(sizeof(inplace_string<256>::_size) == 2);
+  static_assert(inplace_string<15>::capacity() == 15);
+
+  { // run time
+    auto is = inplace_string<16>{};
+    CHECK(is.empty());
+    CHECK(std::string_view{ is.c_str() } == ""sv);
+
+    is.append("host"sv).push_back('-');
+    is += fixed_string<2>{ "01" };
+    CHECK(is == "host-01"sv);
+    CHECK(std::string_view{ is.c_str() } == "host-01"sv);
+
+    is.insert(4, ".example"sv);
+    CHECK(is == "host.example-01"sv);
+    is.erase(4, 8);
+    CHECK(is == "host-01"sv);
+    is.insert(0, 2, '*');
+    CHECK(is == "**host-01"sv);
+    CHECK(*is.erase(is.begin(), is.begin() + 2) == 'h');
+    CHECK(*is.insert(is.end(), '!') == '!');
+    is.erase(is.end() - 1);
+    CHECK(is == "host-01"sv);
+
+    is.insert(0, is.view().substr(4));
+    CHECK(is == "-01host-01"sv);
+    is.assign(is.view().substr(3, 4));
+    CHECK(is == "host"sv);
+
+    is.resize(6, 'x');
+    CHECK(is == "hostxx"sv);
+    is.resize(2);
+    CHECK(is == "ho"sv);
+    CHECK(std::string_view{ is.c_str() } == "ho"sv);
+    is.pop_back();
+    is.front() = 'H';
+    CHECK(is == "H"sv);
+    is.clear();
+    CHECK(is.empty());
+
+#ifndef MTP_NO_EXCEPTIONS
+    auto full = inplace_string<4>{ "abcd" };
+    CHECK_THROWS_WITH_AS(full.push_back('e'), "mtp::basic_inplace_string::push_back",
+                         std::length_error);
+    CHECK_THROWS_WITH_AS(full.append("e"sv), "mtp::basic_inplace_string::append",
+                         std::length_error);
+    CHECK_THROWS_WITH_AS(full.insert(5, "e"sv), "mtp::basic_inplace_string::insert",
+                         std::out_of_range);
+    CHECK_THROWS_WITH_AS(std::ignore = full.at(4), "mtp::basic_inplace_string::at",
+                         std::out_of_range);
+    CHECK(full == "abcd"sv);
+#endif
+  }
+
+  { // interconversion
+    constexpr auto fs = fixed_string<3>{ "abc" };
+    auto is = inplace_string<8>{ fs };
+    CHECK(is == fs);
+    CHECK(fs == is);
+    CHECK(static_cast<fixed_string<3>>(is) == fs);
+    CHECK(std::string_view{ is } == "abc"sv);
+    CHECK(inplace_string<8>{ "abc"sv } == is);
+    CHECK(inplace_string<4>{ is.begin(), is.end() } == is);
+    CHECK(inplace_string<4>{ 3, 'a' } == "aaa"sv);
+#ifdef MTP_HAS_THREE_WAY_COMPARE
+    CHECK((is <=> inplace_string<4>{ "abd" }) == std::strong_ordering::less);
+    CHECK((is <=> "abc"sv) == std::strong_ordering::equal);
+#endif
+    CHECK(std::hash<inplace_string<8>>{}(is) == std::hash<std::string_view>{}("abc"sv));
+    CHECK(mtp::hash<inplace_string<8>>{}(is) == mtp::hash<>{}(fs));
+    CHECK(mtp::hash<>{}(is) == mtp::hash<>{}(fs));
+  }
+
+  { // compile time
+    constexpr auto is = [] {
+      auto str = inplace_u16string<8>{ u"ab" };
+      str.append(u"cd"sv);
+      str.insert(1, u"--"sv);
+      str.erase(2, 1);
+      return str;
+    }();
+    static_assert(is == u"a-bcd"sv);
+    static_assert(is.size() == 5);
+    static_assert(static_cast<fixed_u16string<5>>(is) == u"a-bcd");
+  }
+}
+
+TEST_CASE("search")
+{
+  { // run time
+    auto const fs = fixed_string<24>{ "GET /index.html HTTP/1.1" };
+
+    CHECK(fs.find("HTTP"sv) == 16);
+    CHECK(fs.find<"HTTP">() == 16);
+    CHECK(fs.find<"HTTP">(17) == fs.npos);
+    CHECK(fs.find('/') == 4);
+    CHECK(fs.rfind('/') == 20);
+    CHECK(fs.rfind("T"sv) == 18);
+    CHECK(fs.find_first_of(" ."sv) == 3);
+    CHECK(fs.find_first_of<" .">(4) == 10);
+    CHECK(fs.contains("index"sv));
+    CHECK(fs.contains<"index">());
+    CHECK(not fs.contains<"indey">());
+    CHECK(fs.contains('G'));
+    CHECK(fs.starts_with<"GET ">());
+    CHECK(not fs.starts_with<"GET /index.html HTTP/1.1 ">());
+    CHECK(fs.ends_with<"1.1">());
+    CHECK(fs.ends_with('1'));
+    CHECK(not fs.ends_with<"1.0">());
+  }
+
+  { // compile time
+    constexpr auto fs = fixed_string<11>{ "hello world" };
+
+    static_assert(fs.find<"world">() == 6);
+    static_assert(fs.find<"">(11) == 11);
+    static_assert(fs.find<"o">(5) == 7);
+    static_assert(fs.find_first_of<"wd">() == 6);
+    static_assert(fs.starts_with<"hello">());
+    static_assert(fs.ends_with<"world">());
+    static_assert(find<u"lo">(u"hello"sv) == 3);
+    static_assert(contains<u"ll">(u"hello"sv));
+  }
+
+  { // against basic_string_view
+    check_search<"", "a", "b", "x", "ab", "ba", "aab", "abx", "xxa", "abab", "aaaa", "babxa",
+                 "abxabxab", "aaaaaaaaaaaaaaaax", "abaabaabaabaabaabaabaabaabaabaabaabx",
+                 "xbaxbaxbaxbaxbaxbaxbaxbaxbaxbaxbaxbaxbaxbaxba">();
+    check_search<u"", u"a", u"ab", u"aab", u"abab", u"babxa", u"aaaaaaaaaaaaaaaax">();
+    check_search<U"a", U"ab", U"xxa", U"abxabxab", U"\U0001F600a">();
+  }
+}
+
+TEST_CASE("mtp::format")
+{
+  { // run time
+    auto const host = fixed_string<9>{ "localhost" };
+    auto const line = mtp::format<"{}:{} {}">(host, 8080, true);
+    CHECK(line == "localhost:8080 true"sv);
+    CHECK(line.capacity() == max_formatted_size_v<"{}:{} {}", fixed_string<9>, int, bool>);
+
+    CHECK(mtp::format<"{{{}}} {{}}">(1) == "{1} {}"sv);
+    CHECK(mtp::format<"{1}-{0}-{1}">('a', "bc") == "bc-a-bc"sv);
+    CHECK(mtp::format<"[{:>6}|{:<6}|{:^6}|{:*^7}]">(42, "ab", 'c', true)
+          == "[    42|ab    |  c   |*true**]"sv);
+    CHECK(mtp::format<"{:+} {: } {:-} {:+05} {:05}">(1, 2, -3, -4, 5u) == "+1  2 -3 -0004 00005"sv);
+    CHECK(mtp::format<"{:b} {:#B} {:o} {:#o} {:#o} {:x} {:#X}">(5, 5, 8, 8, 0, 255, 255)
+          == "101 0B101 10 010 0 ff 0XFF"sv);
+    CHECK(mtp::format<"{:#010x}|{:d}|{:c}|{:x}">(255, 'A', 66, true) == "0x000000ff|65|B|1"sv);
+    CHECK(mtp::format<"{} {} {}">(std::numeric_limits<std::int64_t>::min(),
+                                  std::numeric_limits<std::uint64_t>::max(),
+                                  std::numeric_limits<std::int8_t>::min())
+          == "-9223372036854775808 18446744073709551615 -128"sv);
+    CHECK(mtp::format<"{:b}">(std::numeric_limits<std::uint64_t>::max()) == std::string(64, '1'));
+
+    CHECK(mtp::format<"{} {} {} {}">(1.5, -0.1f, 1e100, 0.0) == "1.5 -0.1 1e+100 0"sv);
+    CHECK(mtp::format<"{:.3} {:e} {:.2E} {:f} {:.1f} {:g} {:G}">(3.14159, 1234.5, 1234.5, 0.5, 2.25,
+                                                                 1e-5, 1e-5)
+          == "3.14 1.234500e+03 1.23E+03 0.500000 2.2 1e-05 1E-05"sv);
+    CHECK(mtp::format<"{:+08.2f}|{:08}|{:<8}|{:+}">(-1.5, 1.0 / 0.0, 2.5, 0.5)
+          == "-0001.50|     inf|2.5     |+0.5"sv);
+
+    CHECK(mtp::format<"{:.3}|{:>5.2}">(std::string_view{ "abcdef" }, std::string{ "xyz" })
+          == "abc|   xy"sv);
+    CHECK(mtp::format<"{}{}">(inplace_string<4>{ "ab" }, "cd") == "abcd"sv);
+  }
+
+  { // compile time
+    constexpr auto str = mtp::format<"{:*^9}|{:08x}|{:>+6}|{}">("ab", 0xbeefu, 12, false);
+    static_assert(str == "***ab****|0000beef|   +12|false"sv);
+    static_assert(mtp::format<u"{}={:#x}">(u"key", 16) == u"key=0x10"sv);
+    static_assert(max_formatted_size_v<"{}", std::int32_t> == 11);
+    static_assert(max_formatted_size_v<"{:>20}", bool> == 20);
+    static_assert(max_formatted_size_v<"{}", std::string_view> == std::string_view::npos);
+    static_assert(max_formatted_size_v<"{:.8}", std::string_view> == 8);
+  }
+
+  { // format_to and formatted_size
+    auto const name = std::string{ "a longer runtime string" };
+    auto buffer = std::array<char, 64>{};
+    auto const* end = mtp::format_to<"{}: {:>4}">(buffer.data(), name, 7);
+    CHECK(std::string_view(buffer.data(), end) == "a longer runtime string:    7"sv);
+    CHECK(mtp::formatted_size<"{}: {:>4}">(name, 7) == 29);
+    CHECK(mtp::formatted_size<"{:.4}|{:<30}">(name, name) == 35);
+    CHECK(mtp::formatted_size<"{:+}">(12) == 3);
+  }
+
+#ifdef MTP_HAS_FORMAT
+  { // against std::format
+    CHECK(mtp::format<"{:+#010x}|{:^9.3e}|{:<5}|{:08.3f}">(-255, 1.5, 'x', 3.0)
+          == std::format("{:+#010x}|{:^9.3e}|{:<5}|{:08.3f}", -255, 1.5, 'x', 3.0));
+  }
+#endif
+}
+
+TEST_CASE("numeric conversions")
+{
+  enum class level : short
+  {
+    low = -3,
+    high = 0x7f
+  };
+
+  { // to_fixed_string
+    static_assert(to_fixed_string<1234>() == "1234"sv);
+    static_assert(std::same_as<decltype(to_fixed_string<-56>()), fixed_string<3>>);
+    static_assert(to_fixed_string<0u>() == "0"sv);
+    static_assert(to_fixed_string<std::numeric_limits<std::int64_t>::min()>()
+                  == "-9223372036854775808"sv);
+    static_assert(to_fixed_string<std::numeric_limits<std::uint64_t>::max(), 16>()
+                  == "ffffffffffffffff"sv);
+    static_assert(to_fixed_string<-10, 2>() == "-1010"sv);
+    static_assert(to_fixed_string<35, 36>() == "z"sv);
+    static_assert(to_fixed_string<level::low>() == "-3"sv);
+    static_assert(to_fixed_string<level::high, 16, char16_t>() == u"7f"sv);
+    static_assert("port=" + to_fixed_string<8080>() == "port=8080"sv);
+
+    static_assert(to_fixed_string<0.1>() == "0.1"sv);
+    static_assert(to_fixed_string<-1.5f>() == "-1.5"sv);
+    static_assert(to_fixed_string<1e100>() == "1e+100"sv);
+    static_assert(to_fixed_string<5e-324>() == "5e-324"sv);
+    static_assert(to_fixed_string<-0.0>() == "-0"sv);
+
+    check_to_chars<0.0, 1.0, 100.0, 123.456, 0.3, 1e21, 1e22, 1e23, 1e-7, 0.001, 1234567.0,
+                   12345678901234567.0, 9007199254740993.0, 2.2250738585072014e-308,
+                   4.9406564584124654e-324, std::numeric_limits<double>::max(),
+                   std::numeric_limits<double>::min(), 0x1p-1022, 0x1p+1000, 1.0 / 3, 2.0 / 3,
+                   5e-310, 1.7976931348623157e308, 0x1.fffffffffffffp-1, 9.5367431640625e-07>();
+    check_to_chars<0.0f, 1.0f, 0.1f, 0.3f, 3.4028235e38f, 1e-45f, 1.17549435e-38f, 16777217.0f,
+                   1e10f, 7.038531e-26f, 0x1p-126f, 123456.789f, 1.0f / 3>();
+    check_to_chars<std::numeric_limits<double>::infinity(),
+                   -std::numeric_limits<double>::infinity(),
+                   std::numeric_limits<float>::quiet_NaN()>();
+  }
+
+  { // parse
+    static_assert(parse<int, "1234">() == 1234);
+    static_assert(parse<int, "-2147483648">() == std::numeric_limits<int>::min());
+    static_assert(parse<std::uint64_t, "18446744073709551615">()
+                  == std::numeric_limits<std::uint64_t>::max());
+    static_assert(parse<std::int8_t, "-128">() == -128);
+    static_assert(parse<unsigned, "fF", 16>() == 255);
+    static_assert(parse<long, u"-zz", 36>() == -1295);
+    static_assert(parse<int, to_fixed_string<-77>()>() == -77);
+  }
+
+  { // from_chars against std::from_chars
+    auto const inputs = std::array{ ""sv,
+                                    "0"sv,
+                                    "-"sv,
+                                    "-0"sv,
+                                    "7"sv,
+                                    "12ab"sv,
+                                    "0000000000000000000000042"sv,
+                                    "1234567812345678"sv,
+                                    "123456781234567x9"sv,
+                                    "-2147483648"sv,
+                                    "2147483648"sv,
+                                    "-9223372036854775808"sv,
+                                    "9223372036854775808"sv,
+                                    "18446744073709551615"sv,
+                                    "18446744073709551616"sv,
+                                    "99999999999999999999"sv,
+                                    "123456789012345678901234"sv,
+                                    "+1"sv,
+                                    " 1"sv,
+                                    "255"sv,
+                                    "256"sv,
+                                    "-129"sv };
+    auto const check = [&]<typename T>(T, int base) {
+      for (auto const input : inputs) {
+        auto value = T{ 42 };
+        auto expected_value = T{ 42 };
+        auto const [ptr, ec] = mtp::from_chars(input, value, base);
+        auto const expected =
+            std::from_chars(input.data(), input.data() + input.size(), expected_value, base);
+        CHECK(ptr == expected.ptr);
+        CHECK(ec == expected.ec);
+        CHECK(value == expected_value);
+      }
+    };
+    check(int{}, 10);
+    check(std::uint64_t{}, 10);
+    check(std::int64_t{}, 10);
+    check(std::int8_t{}, 10);
+    check(std::uint8_t{}, 10);
+    check(int{}, 16);
+    check(unsigned{}, 36);
+
+    constexpr auto parsed = [] {
+      auto value = 0;
+      mtp::from_chars("-0012345678x"sv, value);
+      return value;
+    }();
+    static_assert(parsed == -12345678);
+  }
+
+  { // fixed width
+    auto const date = "20241017T093000"sv;
+    auto year = 0;
+    auto month = std::uint8_t{};
+    auto const [ptr, ec] = mtp::from_chars<4>(date, year);
+    CHECK(ec == std::errc{});
+    CHECK(ptr == date.data() + 4);
+    CHECK(year == 2024);
+    CHECK(mtp::from_chars<2>(date.substr(4), month).ec == std::errc{});
+    CHECK(month == 10);
+
+    auto wide = std::uint64_t{};
+    CHECK(mtp::from_chars<8>("12345678"sv, wide).ec == std::errc{});
+    CHECK(wide == 12345678);
+    CHECK(mtp::from_chars<16>("0123456789012345"sv, wide).ec == std::errc{});
+    CHECK(wide == 123456789012345);
+    CHECK(mtp::from_chars<19>("9999999999999999999"sv, wide).ec == std::errc{});
+    CHECK(wide == 9999999999999999999u);
+
+    auto small = std::uint8_t{ 7 };
+    CHECK(mtp::from_chars<3>("256"sv, small).ec == std::errc::result_out_of_range);
+    CHECK(mtp::from_chars<4>("12:4"sv, year).ec == std::errc::invalid_argument);
+    CHECK(mtp::from_chars<8>("1234567"sv, wide).ec == std::errc::invalid_argument);
+    CHECK(mtp::from_chars<8>("1234/678"sv, wide).ec == std::errc::invalid_argument);
+    CHECK(mtp::from_chars<8>("1234:678"sv, wide).ec == std::errc::invalid_argument);
+    CHECK(small == 7);
+    static_assert([] {
+      auto value = 0;
+      return mtp::from_chars<6>("093000"sv, value).ec == std::errc{} && value == 93000;
+    }());
+  }
+}
+
+TEST_CASE("consteval transforms")
+{
+  { // substr
+    static_assert(substr<"hello world", 6>() == "world"sv);
+    static_assert(substr<"hello world", 0, 5>() == "hello"sv);
+    static_assert(substr<"hello", 2, 100>() == "llo"sv);
+    static_assert(substr<"hello", 5>().empty());
+    static_assert(std::same_as<decltype(substr<"hello world", 6>()), fixed_string<5>>);
+    static_assert(std::same_as<decltype(substr<u"hello", 1, 2>()), fixed_u16string<2>>);
+  }
+
+  { // trim
+    static_assert(trim<"  \t key \n">() == "key"sv);
+    static_assert(trim_left<"  key  ">() == "key  "sv);
+    static_assert(trim_right<"  key  ">() == "  key"sv);
+    static_assert(trim<"--key-", "-">() == "key"sv);
+    static_assert(trim<"   ">().empty());
+    static_assert(std::same_as<decltype(trim<" key ">()), fixed_string<3>>);
+    static_assert(trim<L" wide ">() == L"wide"sv);
+  }
+
+  { // replace
+    static_assert(replace<"a.b.c", ".", "::">() == "a::b::c"sv);
+    static_assert(replace<"a::b::c", "::", "/">() == "a/b/c"sv);
+    static_assert(replace<"aaaa", "aa", "b">() == "bb"sv);
+    static_assert(replace<"key", "x", "y">() == "key"sv);
+    static_assert(replace<"prefix.key", "prefix.", "">() == "key"sv);
+    static_assert(std::same_as<decltype(replace<"a.b", ".", "::">()), fixed_string<4>>);
+  }
+
+  { // split
+    constexpr auto parts = split<"net.http.timeout", '.'>();
+    static_assert(std::tuple_size_v<decltype(parts)> == 3);
+    static_assert(std::get<0>(parts) == "net"sv);
+    static_assert(std::get<1>(parts) == "http"sv);
+    static_assert(std::get<2>(parts) == "timeout"sv);
+    static_assert(std::same_as<std::remove_cvref_t<decltype(std::get<1>(parts))>, fixed_string<4>>);
+
+    constexpr auto scoped = split<"std::chrono::seconds", "::">();
+    static_assert(std::get<1>(scoped) == "chrono"sv);
+
+    constexpr auto empty_parts = split<".a.", '.'>();
+    static_assert(std::tuple_size_v<decltype(empty_parts)> == 3);
+    static_assert(std::get<0>(empty_parts).empty() && std::get<2>(empty_parts).empty());
+    static_assert(std::tuple_size_v<decltype(split<"key", '.'>())> == 1);
+  }
+
+  { // case and order
+    static_assert(to_upper<"Content-Type: 42">() == "CONTENT-TYPE: 42"sv);
+    static_assert(to_lower<"Content-Type: 42">() == "content-type: 42"sv);
+    static_assert(to_lower<u"ÀB">() == u"Àb"sv);
+    static_assert(mtp::reverse<"abc">() == "cba"sv);
+    static_assert(mtp::reverse<"">().empty());
+  }
+
+  { // results are template arguments themselves
+    static_assert(symbol<to_lower<trim<" KEY ">()>()>::name() == "key"sv);
+    static_assert(parse<int, std::get<1>(split<"v.42.0", '.'>())>() == 42);
+    using padded = basic_fixed_string<char, 4, layout::simd<16>>;
+    static_assert(std::same_as<decltype(substr<padded{ "abcd" }, 1>()),
+                               basic_fixed_string<char, 3, layout::simd<16>>>);
+  }
+}
+
+TEST_CASE("case insensitive")
+{
+  static_assert(iequals("Content-Type"sv, "content-TYPE"sv));
+  static_assert(!iequals("Content-Type"sv, "Content-Typo"sv));
+  static_assert(!iequals("Content"sv, "Content-Type"sv));
+  static_assert(iequals<"Content-Length">("CONTENT-LENGTH"sv));
+  static_assert(!iequals<"Content-Length">("CONTENT-LENGTHS"sv));
+  static_assert(iequals(fixed_string<4>{ "Host" }, "hOST"sv));
+  static_assert(icompare("abc"sv, "ABD"sv) < 0);
+  static_assert(icompare("ABC"sv, "ab"sv) > 0);
+  static_assert(icompare<"Accept">("aCCEPT"sv) == 0);
+  static_assert(icompare("a"sv, "_"sv) > 0);
+  static_assert(ihash{}("X-Request-ID"sv) == ihash{}("x-request-id"sv));
+  static_assert(ihash_v<"X-Request-ID"> == ihash{}("X-REQUEST-id"sv));
+  static_assert(ihash_v<"Host"> == hash_v<"host">);
+  static_assert(iequals(u"Ärger"sv, u"äRGER"sv) == false);
+  static_assert(iequals(U"Host"sv, U"HOST"sv));
+
+  auto const header = std::string{ "Transfer-Encoding" };
+  CHECK(iequals<"transfer-encoding">(header));
+  CHECK(iequals(header, fixed_string<17>{ "TRANSFER-ENCODING" }));
+  CHECK(ihash{}(header) == ihash_v<"transfer-encoding">);
+  CHECK(iequals<"a-header-name-longer-than-one-vector-of-32">(
+      "A-HEADER-NAME-LONGER-THAN-ONE-VECTOR-OF-32"sv));
+
+  check_case_insensitive<char>();
+  check_case_insensitive<wchar_t>();
+  check_case_insensitive<char16_t>();
+  check_case_insensitive<char32_t>();
+
+  auto headers = std::unordered_map<std::string, int, ihash, iequal_to>{};
+  headers.emplace("Content-Type", 1);
+  CHECK(headers.find("content-type"sv) != headers.end());
+  CHECK(headers.count("CONTENT-TYPE"sv) == 1);
+
+  auto sorted = std::vector<std::string_view>{ "b", "A", "c", "B" };
+  std::stable_sort(sorted.begin(), sorted.end(), iless{});
+  CHECK(sorted == std::vector<std::string_view>{ "A", "b", "B", "c" });
+}
+
+TEST_CASE("transcode")
+{
+  { // at compile time
+    static_assert(transcode<char16_t, "héllo €\U0001D11E">() == u"héllo €\U0001D11E"sv);
+    static_assert(transcode<char, U"é\U0001D11E">() == "é\U0001D11E"sv);
+    static_assert(transcode<char32_t, u"\U0001F600">() == U"\U0001F600"sv);
+    static_assert(std::same_as<decltype(transcode<char16_t, "café">()), fixed_u16string<4>>);
+    static_assert(std::same_as<decltype(transcode<char, u"€">()), fixed_string<3>>);
+    static_assert(std::same_as<decltype(transcode<char32_t, "\U0001D11E">()), fixed_u32string<1>>);
+    static_assert(transcode<wchar_t, "key">() == L"key"sv);
+    static_assert(transcoded_size<char16_t>("\U0001D11E"sv) == 2);
+  }
+
+  { // invalid input
+    constexpr auto invalid = [](auto str) {
+      char32_t out[8] = {};
+      auto const result = transcode(str, out, out + 8);
+      constexpr auto npos = std::string_view::npos;
+      return result.ec == std::errc::illegal_byte_sequence && transcoded_size<char32_t>(str) == npos
+             ? static_cast<std::size_t>(result.in - str.data())
+             : npos;
+    };
+    static_assert(invalid("a\xC0\x80"sv) == 1);          // overlong
+    static_assert(invalid("\xE0\x80\x80"sv) == 0);       // overlong
+    static_assert(invalid("ab\xED\xA0\x80"sv) == 2);     // surrogate
+    static_assert(invalid("\xF4\x90\x80\x80"sv) == 0);   // past U+10FFFF
+    static_assert(invalid("\xF5\x80\x80\x80"sv) == 0);
+    static_assert(invalid("\xE2\x82"sv) == 0);           // truncated
+    static_assert(invalid("a\x80"sv) == 1);              // stray continuation
+    static_assert(invalid(u"a\xD800"sv) == 1);           // unpaired high surrogate
+    static_assert(invalid(u"\xDC00\xD800"sv) == 0);
+    static_assert(invalid(U"\x110000"sv) == 0);
+    static_assert(invalid(U"\xDFFF"sv) == 0);
+
+    auto const text = std::string(40, 'a') + "\xFF" + std::string(40, 'b');
+    char16_t out[128] = {};
+    auto const result = transcode(std::string_view{ text }, out, out + 128);
+    CHECK(result.ec == std::errc::illegal_byte_sequence);
+    CHECK(result.in == text.data() + 40);
+    CHECK(result.out == out + 40);
+  }
+
+  { // output too small
+    char16_t out[4] = {};
+    auto const str = "ab\U0001D11E"sv;
+    auto const result = transcode(str, out, out + 3);
+    CHECK(result.ec == std::errc::value_too_large);
+    CHECK(result.in == str.data() + 2);
+    CHECK(result.out == out + 2);
+
+    auto is = inplace_u16string<8>{};
+    CHECK(transcode("über"sv, is).ec == std::errc{});
+    CHECK(is == u"über"sv);
+    CHECK(transcode(std::string_view{ "a string longer than eight" }, is).ec
+          == std::errc::value_too_large);
+    CHECK(is == u"a string"sv);
+  }
+
+  check_transcode<char, char16_t>();
+  check_transcode<char, char32_t>();
+  check_transcode<char16_t, char>();
+  check_transcode<char32_t, char>();
+  check_transcode<char16_t, char32_t>();
+  check_transcode<wchar_t, char>();
+}
+
+TEST_CASE("symbol")
+{
+  static_assert(std::is_empty_v<symbol<"click">>);
+  static_assert(symbol<"click">::name() == "click"sv);
+
+  // ids are handed out in order of first use across the program, so only their identity is checked
+  auto const click = symbol<"click">::id();
+  auto const scroll = symbol<"scroll">::id();
+  CHECK(click.valid());
+  CHECK(scroll.valid());
+  CHECK(click != scroll);
+  CHECK(click == symbol<"click">{});
+  CHECK(symbol<"click">::id() == click);
+  CHECK(click.name() == "click"sv);
+  CHECK(scroll.name() == "scroll"sv);
+  CHECK(symbol_id{ scroll.value() } == scroll);
+  CHECK(symbol_id{ scroll.value() }.name() == "scroll"sv);
+
+  CHECK_FALSE(symbol_id{}.valid());
+  CHECK(symbol_id{}.name().empty());
+  CHECK(std::hash<symbol_id>{}(click) == std::hash<std::uint32_t>{}(click.value()));
+
+  using events = symbol_table<"click", "scroll", "key_down", "key_up">;
+  CHECK(events::find("scroll") == scroll);
+  CHECK(events::find("key_up") == symbol<"key_up">::id());
+  CHECK(events::find("key_up")->name() == "key_up"sv);
+  CHECK_FALSE(events::find("key").has_value());
+  CHECK_FALSE(events::find("").has_value());
+  CHECK(events::ids()[0] == click);
+
+  auto counts = std::unordered_map<symbol_id, int>{};
+  for (auto const name : { "click"sv, "scroll"sv, "click"sv, "resize"sv }) {
+    if (auto const id = events::find(name)) {
+      ++counts[*id];
+    }
+  }
+  CHECK(counts.size() == 2);
+  CHECK(counts[symbol<"click">{}] == 2);
+}
+
+template <typename T>
+concept has_c_str = requires(T const& str) { str.c_str(); };
+
+TEST_CASE("layout")
+{
+  using padded5 = basic_fixed_string<char, 5, layout::simd<32>>;
+  using padded32 = basic_fixed_string<char, 32, layout::simd<32>>;
+  using bare32 = basic_fixed_string<char, 32, layout::simd<32, false>>;
+  using wide = basic_fixed_string<char16_t, 9, layout::simd<16>>;
+
+  static_assert(sizeof(padded5) == 32 && alignof(padded5) == 32);
+  static_assert(sizeof(padded32) == 64);
+  static_assert(sizeof(bare32) == 32);
+  static_assert(sizeof(wide) == 32 && alignof(wide) == 16);
+  static_assert(has_c_str<padded5> && !has_c_str<bare32>);
+
+  { // compile time, and as template arguments
+    constexpr auto hello = padded5{ "hello" };
+    static_assert(hello == fixed_string<5>{ "hello" });
+    static_assert(hello.view() == "hello"sv);
+    static_assert(std::all_of(hello._data + hello.size(), hello._data + sizeof(hello),
+                              [](char ch) { return ch == '\0'; }));
+    static_assert(concat_all<hello, "!">() == "hello!");
+    static_assert(std::same_as<decltype(hello + fixed_string<1>{ "!" }),
+                               basic_fixed_string<char, 6, layout::simd<32>>>);
+    static_assert(find<hello>("say hello"sv) == 4);
+  }
+
+  { // run time kernels against views
+    auto const make = []<typename Fs>(std::type_identity<Fs>, std::string_view str) {
+      return Fs{ str.begin(), str.end() };
+    };
+    auto strings = std::vector<std::string>{};
+    for (std::size_t i = 0; i < 200; ++i) {
+      auto str = std::string(40, 'a');
+      for (std::size_t j = 0; j < str.size(); ++j) {
+        str[j] = "abc\0"[(i * 7 + j * j * 13 + i * j) % (j % 11 == 3 ? 4 : 3)];
+      }
+      strings.push_back(str);
+    }
+
+    using p20 = basic_fixed_string<char, 20, layout::simd<32>>;
+    using p24 = basic_fixed_string<char, 24, layout::simd<32, false>>;
+    using q20 = basic_fixed_string<char, 20, layout::simd<16>>;
+    using p40 = basic_fixed_string<char, 40, layout::simd<16>>;
+
+    for (std::size_t i = 0; i < strings.size(); ++i) {
+      CAPTURE(i);
+      auto const a = std::string_view{ strings[i] }.substr(0, 20);
+      auto const b = std::string_view{ strings[(i * 31) % strings.size()] }.substr(i % 3, 20);
+      auto const c = std::string_view{ strings[(i * 31) % strings.size()] }.substr(0, 24);
+      auto const fa = make(std::type_identity<p20>{}, a);
+      auto const fb = make(std::type_identity<p20>{}, b);
+      auto const fc = make(std::type_identity<p24>{}, c);
+      auto const qb = make(std::type_identity<q20>{}, b);
+      auto const pb = make(std::type_identity<fixed_string<20>>{}, b);
+
+      CHECK((fa == fb) == (a == b));
+      CHECK(fa == fa);
+      CHECK((fa == qb) == (a == b));
+      CHECK((fa == pb) == (a == b));
+#ifdef MTP_HAS_THREE_WAY_COMPARE
+      CHECK((fa <=> fb) == (a <=> b));
+      CHECK((fa <=> fc) == (a <=> c));
+      CHECK((fc <=> fa) == (c <=> a));
+      CHECK((fa <=> qb) == (a <=> b));
+#endif
+      CHECK(mtp::hash<>{}(fa) == mtp::hash<>{}(a));
+      CHECK(std::hash<p20>{}(fa) == std::hash<std::string_view>{}(a));
+
+      auto const long_view = std::string_view{ strings[i] };
+      auto const f40 = make(std::type_identity<p40>{}, long_view);
+      for (std::size_t pos = 0; pos <= 42; ++pos) {
+        CAPTURE(pos);
+        CHECK(f40.find<"ab">(pos) == long_view.find("ab", pos));
+        CHECK(f40.find<"cab">(pos) == long_view.find("cab", pos));
+        CHECK(f40.find<"aaaa">(pos) == long_view.find("aaaa", pos));
+        CHECK(f40.find<"c">(pos) == long_view.find('c', pos));
+        CHECK(fa.find<"bc">(pos) == a.find("bc", pos));
+        CHECK(fa.find<"abcabcabcabcabcabcabc">(pos) == a.find("abcabcabcabcabcabcabc", pos));
+      }
+    }
+
+    auto const head = std::string_view{ strings[0] }.substr(0, 20);
+    auto const joined = make(std::type_identity<p20>{}, head) + fixed_string<2>{ "!?" };
+    CHECK(joined.view() == strings[0].substr(0, 20) + "!?");
+    CHECK(inplace_string<32>{ joined }.view() == joined.view());
+  }
+}
+
+TEST_CASE("fixed_string_column")
+{
+  using isins = fixed_string_column<12>;
+  using padded = fixed_string_column<12, layout::simd<16>>;
+
+  static_assert(isins::stride() == 12 && padded::stride() == 16);
+  static_assert(fixed_u16string_column<5, layout::simd<32>>::stride() == 16);
+  static_assert(std::random_access_iterator<isins::iterator>);
+  static_assert(std::random_access_iterator<isins::const_iterator>);
+
+  { // elements
+    auto column = padded{};
+    column.push_back(fixed_string<12>{ "US0378331005" });
+    column.push_back("US5949181045"sv);
+    column.push_back(basic_fixed_string<char, 12, layout::simd<32>>{ "GB0002634946" });
+    REQUIRE(column.size() == 3);
+    CHECK(column[0] == "US0378331005"sv);
+    CHECK(column.back().view() == "GB0002634946");
+    CHECK(fixed_string<12>{ column[1] } == fixed_string<12>{ "US5949181045" });
+    CHECK(std::string_view{ column.front() } == "US0378331005");
+    CHECK(column[1] > column[0]);
+
+    column[0] = column[2];
+    CHECK(column[0] == "GB0002634946"sv);
+    CHECK(std::ranges::count(column, "GB0002634946"sv) == 2);
+    CHECK(column.end() - column.begin() == 3);
+    CHECK(column.begin()[1] == "US5949181045"sv);
+
+    auto const& view = column;
+    auto it = view.begin();
+    it += 2;
+    CHECK(*it == "GB0002634946"sv);
+
+#ifndef MTP_NO_EXCEPTIONS
+    CHECK_THROWS_WITH_AS(column.push_back("US03783310"sv),
+                         "mtp::basic_fixed_string_column::push_back", std::length_error);
+    CHECK_THROWS_WITH_AS(std::ignore = column.at(3), "mtp::basic_fixed_string_column::at",
+                         std::out_of_range);
+#endif
+
+    auto const indices = std::array<std::size_t, 4>{ 2, 1, 1, 0 };
+    auto gathered = padded{};
+    column.gather(indices.data(), indices.size(), gathered);
+    REQUIRE(gathered.size() == 4);
+    CHECK(gathered[1] == "US5949181045"sv);
+    CHECK(gathered[2] == "US5949181045"sv);
+
+    auto replacements = padded{};
+    replacements.push_back("FR0000120271"sv);
+    replacements.push_back("DE0007164600"sv);
+    auto const targets = std::array<std::size_t, 2>{ 3, 0 };
+    gathered.scatter(targets.data(), replacements);
+    CHECK(gathered[0] == "DE0007164600"sv);
+    CHECK(gathered[3] == "FR0000120271"sv);
+    CHECK(gathered != column);
+
+    column.pop_back();
+    CHECK(column.size() == 2);
+  }
+
+  check_column<fixed_string_column<1>>();
+  check_column<fixed_string_column<2>>();
+  check_column<fixed_string_column<3>>();
+  check_column<isins>();
+  check_column<padded>();
+  check_column<fixed_string_column<13>>();
+  check_column<fixed_string_column<31>>();
+  check_column<fixed_string_column<40>>();
+  check_column<fixed_string_column<6, layout::simd<8>>>();
+  check_column<fixed_string_column<12, layout::simd<64>>>();
+  check_column<fixed_string_column<100, layout::simd<16>>>();
+  check_column<fixed_u16string_column<3>>();
+  check_column<fixed_u16string_column<12, layout::simd<16>>>();
+  check_column<fixed_u32string_column<5, layout::simd<32>>>();
+
+  { // padded records are compared whole, a block at a time
+    using wide = fixed_string_column<40, layout::simd<16>>;
+    static_assert(wide::stride() == 48);
+    auto const a = fixed_string<40>{ "0123456789012345678901234567890123456789" };
+    auto const b = fixed_string<40>{ "0123456789012345678901234567890123456780" };
+    auto column = wide{};
+    column.push_back(a);
+    column.push_back(b);
+    column.push_back(a);
+    column[2] = b;
+    column[2] = a;
+    auto bitmap = std::vector<std::uint64_t>(column.bitmap_size());
+    CHECK(column.equals(a, bitmap.data()) == 2);
+    CHECK(bitmap[0] == 0b101);
+    auto const padded_b = basic_fixed_string<char, 40, layout::simd<32>>{ b.begin(), b.end() };
+    CHECK(column.equals(padded_b, bitmap.data()) == 1);
+    CHECK(bitmap[0] == 0b010);
+  }
+}
+
+TEST_CASE("fixed_string_ref")
+{
+  // 32 byte records: a 12 character isin, a 4 character currency, an 8 byte price and padding
+  constexpr auto record_size = std::size_t{ 32 };
+  auto bytes = std::vector<unsigned char>{};
+  auto const add = [&](std::string_view isin, std::string_view currency, std::int64_t price) {
+    auto record = std::array<unsigned char, record_size>{};
+    std::memcpy(record.data(), isin.data(), 12);
+    std::memcpy(record.data() + 12, currency.data(), 4);
+    std::memcpy(record.data() + 16, &price, sizeof(price));
+    bytes.insert(bytes.end(), record.begin(), record.end());
+  };
+  add("US0378331005", "USD ", 18'950);
+  add("GB0002634946", "GBP ", 1'250);
+  add("US5949181045", "USD ", 41'520);
+  bytes.push_back(0); // a partial record
+
+  { // refs
+    auto const fs = fixed_string<12>{ "US0378331005" };
+    auto const ref = fixed_string_ref<12>{ fs };
+    auto const other = fixed_string_ref<12>{ reinterpret_cast<char const*>(bytes.data()) };
+    CHECK(ref.data() == fs.data());
+    CHECK(ref == other);
+    CHECK(ref == fs);
+    CHECK(fs == ref);
+    CHECK(ref == "US0378331005"sv);
+    CHECK(ref != fixed_string_ref<4>{ "USD " });
+    CHECK(ref.view() == "US0378331005");
+    CHECK(ref.value() == fs);
+    CHECK(ref.front() == 'U');
+    CHECK(ref.back() == '5');
+    CHECK(ref.find<"0378">() == 2);
+    CHECK(ref.starts_with("US"));
+#ifdef MTP_HAS_THREE_WAY_COMPARE
+    CHECK((ref <=> fixed_string<12>{ "GB0002634946" }) == std::strong_ordering::greater);
+    CHECK((ref <=> "US1"sv) == std::strong_ordering::less);
+#endif
+    CHECK(mtp::hash<>{}(ref) == mtp::hash<>{}(fs));
+    CHECK(std::hash<fixed_string_ref<12>>{}(ref) == std::hash<std::string_view>{}(fs.view()));
+#ifndef MTP_NO_EXCEPTIONS
+    CHECK_THROWS_WITH_AS(std::ignore = ref.at(12), "mtp::basic_fixed_string_ref::at",
+                         std::out_of_range);
+#endif
+    static_assert(!std::is_constructible_v<fixed_string_ref<3>, fixed_string<3>>);
+    static_assert(std::is_constructible_v<fixed_string_ref<3>, fixed_string<3> const&>);
+  }
+
+  { // past the outline threshold
+    constexpr auto size = detail::outline_bytes + 5;
+    static_assert(detail::outline<char, size>);
+    auto chars = std::string(2 * size, 'x');
+    chars[2 * size - 1] = 'y';
+    auto const lhs = fixed_string_ref<size>{ chars.data() };
+    auto const rhs = fixed_string_ref<size>{ chars.data() + size };
+    CHECK(lhs == fixed_string_ref<size>{ chars.data() + 1 });
+    CHECK(lhs != rhs);
+    CHECK(lhs != fixed_string_ref<size - 1>{ chars.data() });
+#ifdef MTP_HAS_THREE_WAY_COMPARE
+    CHECK((lhs <=> rhs) == std::strong_ordering::less);
+    CHECK((rhs <=> lhs) == std::strong_ordering::greater);
+    CHECK((lhs <=> fixed_string_ref<size - 1>{ chars.data() }) == std::strong_ordering::greater);
+#endif
+  }
+
+  { // records and fields of a buffer
+    auto const rows = records<record_size>(bytes.data(), bytes.size());
+    static_assert(std::random_access_iterator<decltype(rows.begin())>);
+    REQUIRE(rows.size() == 3);
+    CHECK(rows[1].field<0, 12>() == "GB0002634946"sv);
+    CHECK(rows[1].field<12, 3>() == "GBP"sv);
+    CHECK(rows.back().read<std::int64_t, 16>() == 41'520);
+
+    auto const isins = fields<record_size, 0, 12>(bytes.data(), bytes.size());
+    CHECK(std::count_if(isins.begin(), isins.end(), [](auto isin) {
+            return isin.starts_with("US");
+          }) == 2);
+    CHECK(*std::max_element(isins.begin(), isins.end()) == "US5949181045"sv);
+    CHECK(isins.end() - isins.begin() == 3);
+  }
+
+#ifdef MTP_HAS_MMAP
+  { // a mapped file
+    auto const path =
+        (std::filesystem::temp_directory_path() / "mtp_fixed_string_ref.bin").string();
+    auto* const out = std::fopen(path.c_str(), "wb");
+    REQUIRE(out != nullptr);
+    std::fwrite(bytes.data(), 1, bytes.size(), out);
+    std::fclose(out);
+
+    auto ec = std::error_code{};
+    auto file = mapped_file::open(path.c_str(), { .populate = true }, ec);
+    REQUIRE(!ec);
+    CHECK(file.size() == bytes.size());
+    file.prefetch(40, 1000);
+    file.advise(mapped_file::access::random);
+
+    auto const moved = std::move(file);
+    CHECK(file.empty());
+    auto const currencies = fields<record_size, 12, 3>(moved.data(), moved.size());
+    CHECK(currencies[0] == "USD"sv);
+    CHECK(currencies[1] == fixed_string<3>{ "GBP" });
+    std::filesystem::remove(path);
+
+    std::ignore = mapped_file::open(path.c_str(), {}, ec);
+    CHECK(ec == std::errc::no_such_file_or_directory);
+#  ifndef MTP_NO_EXCEPTIONS
+    CHECK_THROWS_AS(std::ignore = mapped_file{ path.c_str() }, std::system_error);
+#  endif
+  }
+#endif
+}
+
+TEST_CASE("fixed_string_map")
+{
+  using prices = fixed_string_map<12, std::string>;
+  static_assert(std::forward_iterator<prices::iterator>);
+  static_assert(std::forward_iterator<prices::const_iterator>);
+  static_assert(std::is_same_v<fixed_string_set<3>::iterator, fixed_string_set<3>::const_iterator>);
+  static_assert(detail::map_key<char[4], char>);
+  static_assert(!detail::map_key<char16_t[4], char>);
+  static_assert(!detail::map_key<char*, char>);
+
+  { // string literals
+    auto set = fixed_string_set<3>{};
+    CHECK(set.insert("abc").second);
+    CHECK(!set.insert("abc").second);
+    CHECK(set.contains("abc"));
+    CHECK(set.find("abd") == set.end());
+    CHECK(set.count("ab") == 0);
+    CHECK(set.erase("abc") == 1);
+    CHECK(set.empty());
+  }
+
+  { // elements
+    auto map = prices{ { fixed_string<12>{ "US0378331005" }, "AAPL" },
+                       { fixed_string<12>{ "US5949181045" }, "MSFT" } };
+    REQUIRE(map.size() == 2);
+    CHECK(map.at(fixed_string<12>{ "US0378331005" }) == "AAPL");
+    CHECK(map.at("US5949181045"sv) == "MSFT");
+    CHECK(map.contains("US0378331005"sv));
+    CHECK(!map.contains("US03783310"sv));
+    CHECK(map.find("GB0002634946"sv) == map.end());
+    CHECK(map.count(std::string{ "US5949181045" }) == 1);
+    CHECK(map.find("US0378331005")->second == "AAPL");
+    CHECK(map.at("US5949181045") == "MSFT");
+    CHECK(!map.contains("US03783310"));
+    CHECK(!map.contains("US03783310050"));
+
+    auto const [it, inserted] = map.try_emplace("GB0002634946"sv, 3, 'x');
+    CHECK(inserted);
+    CHECK(it->first == "GB0002634946"sv);
+    CHECK(it->second == "xxx");
+    CHECK(!map.try_emplace("GB0002634946"sv, "BP").second);
+    CHECK(!map.insert({ fixed_string<12>{ "GB0002634946" }, "BP" }).second);
+    CHECK(!map.insert_or_assign("GB0002634946"sv, "BP").second);
+    CHECK(map["GB0002634946"sv] == "BP");
+    CHECK(map["FR0000120271"sv].empty());
+    CHECK(map.size() == 4);
+    CHECK(map["FR0000120271"].empty());
+    CHECK(map.size() == 4);
+
+    auto count = std::size_t{ 0 };
+    for (auto& [isin, ticker] : map) {
+      CHECK(map.find(isin)->second == ticker);
+      ++count;
+    }
+    CHECK(count == map.size());
+
+    CHECK(map.erase("US0378331005"sv) == 1);
+    CHECK(map.erase("US0378331005"sv) == 0);
+    map.erase(map.find("FR0000120271"sv));
+    CHECK(map.size() == 2);
+    CHECK(!map.contains("FR0000120271"sv));
+
+    auto const copy = map;
+    CHECK(copy.size() == 2);
+    CHECK(copy.at("GB0002634946"sv) == "BP");
+    auto moved = std::move(map);
+    CHECK(map.empty());
+    CHECK(moved.at("US5949181045"sv) == "MSFT");
+    map = copy;
+    CHECK(map.size() == 2);
+    map.clear();
+    CHECK(map.empty());
+    CHECK(map.begin() == map.end());
+    CHECK(map.capacity() != 0);
+
+#ifndef MTP_NO_EXCEPTIONS
+    CHECK_THROWS_WITH_AS(std::ignore = copy.at("US0378331005"sv),
+                         "mtp::basic_fixed_string_map::at", std::out_of_range);
+    CHECK_THROWS_WITH_AS(map["US03783310"sv], "mtp::basic_fixed_string_map::insert",
+                         std::length_error);
+#endif
+  }
+
+  { // growth, erasing and rehashing
+    auto const key = [](std::size_t i) {
+      auto chars = std::array<char, 8>{};
+      for (auto& c : chars) {
+        c = static_cast<char>('a' + i % 26);
+        i /= 26;
+      }
+      return fixed_string<8>{ chars.begin(), chars.end() };
+    };
+    constexpr auto count = std::size_t{ 5000 };
+
+    auto set = fixed_string_set<8>{};
+    CHECK(set.find(key(0)) == set.end());
+    for (std::size_t i = 0; i < count; ++i) {
+      CHECK(set.insert(key(i)).second);
+      CHECK(set.load_factor() <= set.max_load_factor());
+    }
+    CHECK(set.size() == count);
+    CHECK(std::all_of(set.begin(), set.end(), [&](auto const& k) { return set.contains(k); }));
+
+    // erasing and inserting in turn reuses the slots without growing
+    auto const capacity = set.capacity();
+    for (std::size_t round = 0; round < 4; ++round) {
+      for (std::size_t i = 0; i < count; i += 2) {
+        CHECK(set.erase(key(i)) == 1);
+      }
+      for (std::size_t i = 0; i < count; ++i) {
+        CHECK(set.contains(key(i)) == (i % 2 == 1));
+      }
+      for (std::size_t i = 0; i < count; i += 2) {
+        CHECK(set.insert(std::string_view{ key(i) }).second);
+      }
+    }
+    CHECK(set.capacity() == capacity);
+    CHECK(std::distance(set.begin(), set.end()) == static_cast<std::ptrdiff_t>(count));
+
+    auto kept = std::size_t{ 0 };
+    for (auto it = set.begin(); it != set.end();) {
+      kept += (*it)[0] >= 'n';
+      it = (*it)[0] < 'n' ? set.erase(it) : std::next(it);
+    }
+    CHECK(set.size() == kept);
+    set.rehash(0);
+    CHECK(set.capacity() < capacity);
+    for (std::size_t i = 0; i < count; ++i) {
+      CHECK(set.contains(key(i)) == (key(i)[0] >= 'n'));
+    }
+
+    auto reserved = fixed_string_set<8>{ count };
+    auto const reserved_capacity = reserved.capacity();
+    for (std::size_t i = 0; i < count; ++i) {
+      reserved.insert(key(i));
+    }
+    CHECK(reserved.capacity() == reserved_capacity);
+    reserved.reserve(count * 2);
+    CHECK(reserved.capacity() > reserved_capacity);
+    CHECK(reserved.size() == count);
+    reserved.rehash(0);
+    CHECK(reserved.capacity() == reserved_capacity);
+
+    auto empty = fixed_string_set<8>{};
+    empty.rehash(0);
+    CHECK(empty.capacity() == 0);
+  }
+
+#ifndef MTP_NO_EXCEPTIONS
+  { // a copy that throws while growing leaves the map as it was
+    struct fragile
+    {
+      int value;
+      int* copies_left;
+
+      fragile(int v, int* copies)
+          : value{ v }
+          , copies_left{ copies }
+      {}
+
+      fragile(fragile const& other)
+          : value{ other.value }
+          , copies_left{ other.copies_left }
+      {
+        if ((*copies_left)-- == 0) {
+          throw std::runtime_error{ "fragile" };
+        }
+      }
+
+      // may throw, so growing copies the elements instead
+      fragile(fragile&& other)
+          : fragile{ std::as_const(other) }
+      {}
+    };
+
+    auto const key = [](int i) {
+      auto const digits = std::to_string(10'000 + i);
+      return fixed_string<4>{ digits.end() - 4, digits.end() };
+    };
+    auto copies = 1'000'000;
+    auto map = fixed_string_map<4, fragile>{};
+    auto i = 0;
+    for (; i < 100; ++i) {
+      map.try_emplace(key(i), i, &copies);
+    }
+
+    copies = 10;
+    auto const capacity = map.capacity();
+    for (; map.capacity() == capacity && i < 10'000; ++i) {
+      auto const size = map.size();
+      try {
+        map.try_emplace(key(i), i, &copies);
+      }
+      catch (std::runtime_error const&) {
+        CHECK(map.size() == size);
+        break;
+      }
+    }
+    CHECK(map.capacity() == capacity);
+    CHECK(!map.contains(key(i)));
+    for (auto k = 0; k < i; ++k) {
+      CHECK(map.at(key(k)).value == k);
+    }
+
+    copies = 1'000'000;
+    CHECK(map.try_emplace(key(i), i, &copies).second);
+    CHECK(map.capacity() > capacity);
+    CHECK(map.size() == static_cast<std::size_t>(i) + 1);
+  }
+#endif
+
+  { // other character types
+    auto wide = fixed_wstring_map<3, int>{};
+    wide[fixed_wstring<3>{ L"EUR" }] = 1;
+    ++wide[L"EUR"sv];
+    CHECK(wide.at(L"EUR"sv) == 2);
+
+    auto u16 = fixed_u16string_set<40>{};
+    auto const long_key =
+        basic_fixed_string<char16_t, 40>{ u"0123456789012345678901234567890123456789" };
+    CHECK(u16.insert(long_key).second);
+    CHECK(u16.contains(std::u16string{ long_key.view() }));
+    CHECK(!u16.contains(u"0123456789"sv));
+  }
+}
+
+TEST_CASE("regex")
+{
+  static_assert(regex_match<"[A-Z]{3}[0-9]{4}">("ABC1234"sv));
+  static_assert(!regex_match<"[A-Z]{3}[0-9]{4}">("ABC123"sv));
+  static_assert(regex_search<"\\d+">("abc 123"sv)[0] == "123"sv);
+  static_assert(decltype(regex_match<"(a)(?:b)(c)">(""sv))::size() == 3);
+
+  { // groups
+    auto const isin = regex_match<"([A-Z]{2})([A-Z0-9]{9})(\\d)">("US0378331005"sv);
+    REQUIRE(isin);
+    auto const [all, country, nsin, check] = isin;
+    CHECK(all == "US0378331005"sv);
+    CHECK(country == "US"sv);
+    CHECK(nsin == "037833100"sv);
+    CHECK(check == "5"sv);
+    CHECK(isin.get<2>() == "037833100"sv);
+    CHECK(std::distance(isin.begin(), isin.end()) == 4);
+
+    auto const date = regex_search<"(\\d{4})-(\\d\\d)-(\\d\\d)(T\\d\\d)?">("due 2024-03-15."sv);
+    REQUIRE(date);
+    CHECK(date[0] == "2024-03-15"sv);
+    CHECK(date[2] == "03"sv);
+    CHECK(date[4].data() == nullptr);
+    CHECK(!regex_search<"(\\d{4})-(\\d\\d)">("due 2024-3-15"sv));
+    CHECK(regex_search<"b+">("abbbcbb"sv, 5)[0] == "bb"sv);
+    CHECK(!regex_search<"^b">("ab"sv));
+  }
+
+  { // other character types
+    CHECK(regex_match<L"\\w+-\\d{2}">(L"abc-42"sv));
+    CHECK(regex_match<u"[\u03b1-\u03c9]+">(u"\u03bb\u03bf\u03b3\u03bf\u03c2"sv));
+    CHECK(!regex_match<u"[^\u03b1-\u03c9]">(u"\u03bb"sv));
+    CHECK(regex_search<U"[\u4e00-\u9fff]+">(U"abc\u4e2d\u6587def"sv)[0].size() == 2);
+  }
+
+  check_regex<"[A-Z]{3}[0-9]{4}">({ "ABC1234", "abc1234", "ABC12345", "", "XYZ0000 " });
+  check_regex<"([A-Z]{2})([A-Z0-9]{9})(\\d)">({ "US0378331005", "GB00026349", "xUS0378331005" });
+  check_regex<"a*ab">({ "aaab", "ab", "b", "xaab" });
+  check_regex<"(a|ab)(c|bcd)(d*)">({ "abcd", "acd", "abcdd", "zabcdz" });
+  check_regex<"(a+)(b+)?c">({ "aac", "abbc", "ac", "bc", "aabbx aac" });
+  check_regex<"x(?:ab|cd)*y">({ "xy", "xabcdaby", "xaby", "xacy", "zz xcdy" });
+  check_regex<"\\bfoo\\b">({ "foo", "a foo b", "foobar", "barfoo foo" });
+  check_regex<"\\w+@\\w+\\.com">({ "me@example.com", "to: me@example.com!", "me@examplecom" });
+  check_regex<"[^,]*,(.*)">({ "a,b,c", ",", "abc", "x,\ny" });
+  check_regex<"a{2,3}?a">({ "aaa", "aaaa", "aaaaa", "aa" });
+  check_regex<"^ab|cd$">({ "ab", "cd", "abcd", "xcd", "abx", "xab" });
+  check_regex<"[-a-c\\]]+">({ "a-b]c", "d", "x]]y" });
+  check_regex<"\\s*\\S+\\B">({ "  abc", "a", " ", "ab cd" });
+  check_regex<"(\\d+)\\.(\\d{1,2})?">({ "3.14", "3.", "10.5", "x 12.345" });
+  check_regex<"colou?r">({ "color", "colour", "colouur", "the colour red" });
+  check_regex<"(a.*?)(b.*)">({ "axbyb", "ab", "ba" });
+  check_regex<"(?:(\\w)(\\d))+">({ "a1b2c3", "a1b", "a1b2c" });
+  check_regex<"">({ "", "a" });
+  check_regex<"(a|aa)*b">({ "aaab", "b", "aa", "xaab" });
+  check_regex<"(?:a|b)*?b">({ "aab", "abab", "a", "cab" });
+  check_regex<"(ab|a){2,3}c">({ "aabc", "ababac", "abc", "aaaac", "x abac" });
+  check_regex<"^(?:ab)+|cd">({ "abab", "xcd", "abx", "cdab" });
+  check_regex_captures<"((a)|b)+">("ab", { { 0, "ab" }, { 1, "b" }, { -1, "" } });
+  check_regex_captures<"((a)|b)+">("ba", { { 0, "ba" }, { 1, "a" }, { 1, "a" } });
+  check_regex_captures<"((a)|b)+">("c", {});
+  check_regex_captures<"(a*)+b">("b", { { 0, "b" }, { 0, "" } });
+  check_regex_captures<"(a*)+b">("aab", { { 0, "aab" }, { 0, "aa" } });
+  check_regex_captures<"(a*)+b">("a", {});
+  check_regex_captures<"(?:(a)|(b))*?c\\b">("abc", { { 0, "abc" }, { -1, "" }, { 1, "b" } });
+  check_regex_captures<"(?:(a)|(b))*?c\\b">("bac d", { { 0, "bac" }, { 1, "a" }, { -1, "" } });
+  check_regex_captures<"(?:(a)|(b))*?c\\b">("ac1", {});
+  check_regex_captures<"(a|b*){2,4}?(a?)">("", { { 0, "" }, { 0, "" }, { 0, "" } });
+  check_regex_captures<"(a|b*){2,4}?(a?)">("bba", { { 0, "bba" }, { 2, "a" }, { 3, "" } });
+  check_regex_captures<"(a|b*){2,4}?(a?)">("abab", { { 0, "aba" }, { 1, "b" }, { 2, "a" } });
+  check_regex_captures<"(?:(\\w)|-)+?\\b(x)?">("a-b", { { 0, "a" }, { 0, "a" }, { -1, "" } });
+  check_regex_captures<"(?:(\\w)|-)+?\\b(x)?">("-x", { { 0, "-x" }, { -1, "" }, { 1, "x" } });
+  check_regex_captures<"(?:(\\w)|-)+?\\b(x)?">("--", {});
+  CHECK(regex_match<"((a)|b)+">("ab"sv)[2].data() == nullptr);
+
+  SUBCASE("long subjects")
+  {
+    // a repeated group is run by `regex_vm`, which neither recurses per iteration nor backtracks
+    static_assert(regex_match<"(?:ab)*c">("ababc"sv));
+    auto subject = std::string(1 << 20, 'a');
+    for (std::size_t i = 1; i < subject.size(); i += 2) {
+      subject[i] = 'b';
+    }
+    CHECK(regex_match<"(?:ab)*">(subject));
+    CHECK(!regex_search<"(?:ab)+c">(subject));
+    CHECK(regex_search<"(?:ba)+">(subject)[0].size() == subject.size() - 2);
+
+    auto const failing = std::string(1000, 'a') + "!";
+    CHECK(!regex_match<"(a|aa)*b">(failing));
+    CHECK(!regex_search<"(a|aa)*b">(failing));
+    auto const matching = std::string(1000, 'a') + "b";
+    CHECK(regex_match<"(a|aa)*b">(matching)[1] == "a"sv);
+  }
+}
+
+TEST_CASE("multi_search")
+{
+  using keywords = multi_search<"he", "she", "his", "hers">;
+  static_assert(keywords::size() == 4);
+  static_assert(keywords::find("ushers"sv) == multi_match{ 1, 1 });
+  static_assert(!keywords::contains("hi hs"sv));
+
+  { // a stream
+    auto search = multi_search<"ERROR", "WARN", "timeout">{};
+    auto found = std::vector<multi_match>{};
+    auto const collect = [&](multi_match const& match) { found.push_back(match); };
+    CHECK(search.feed("INFO ok\nWAR"sv, collect));
+    CHECK(search.feed("N disk\nERR"sv, collect));
+    CHECK(search.feed("OR: timeout"sv, collect));
+    CHECK(search.consumed() == 32);
+    CHECK(found == std::vector<multi_match>{ { 1, 8 }, { 0, 18 }, { 2, 25 } });
+
+    CHECK(!search.feed("WARN ERROR"sv, [](multi_match const&) { return false; }));
+    search.reset();
+    CHECK(search.consumed() == 0);
+  }
+
+  { // skipping ahead from the start state
+    using methods = multi_search<"GET", "POST", "PUT", "DELETE", "HEAD", "PATCH", "OPTIONS">;
+    auto const log = std::string(100, '.') + "PATCH /a" + std::string(40, '-') + "OPTION GET";
+    CHECK(methods::find(log) == multi_match{ 5, 100 });
+    auto count = std::size_t{ 0 };
+    methods::for_each(log, [&](multi_match const&) { ++count; });
+    CHECK(count == 2);
+    CHECK(!methods::contains(std::string(200, 'x')));
+  }
+
+  { // wide characters
+    auto found = std::vector<multi_match>{};
+    multi_search<u"\u4e2d\u6587", u"\u6587\u5b57", u"a">::for_each(
+        u"\u4e2d\u6587\u5b57a\u00e9"sv, [&](multi_match const& match) { found.push_back(match); });
+    CHECK(found == std::vector<multi_match>{ { 0, 0 }, { 1, 1 }, { 2, 3 } });
+  }
+
+  check_multi_search<"a", "b">();
+  check_multi_search<"ab", "ba", "abx", "xx", "bab">();
+  check_multi_search<"aaaa", "aa", "ab", "b">();
+  check_multi_search<"xab", "abxab", "bxa", "xx", "ba", "aab", "bb", "abab", "xbxbx">();
+  check_multi_search<"aab", "abx", "bxa", "xxb", "bab", "xab", "bbx", "axa", "xbx", "bba", "abab",
+                     "xaxx">();
+  check_multi_search<"aaa", "aab", "aax", "aba", "abb", "abx", "axa", "axb", "axx", "baa", "bab",
+                     "bax", "bba", "bbb", "bbx", "bxa", "bxb">();
+  check_multi_search<u"ab", u"xba", u"bab">();
+  check_multi_search<U"xa", U"axb">();
+}
+
+TEST_CASE("wire")
+{
+  auto buffer = std::array<std::byte, 64>{};
+  auto const bytes = [&](std::size_t first, std::size_t count) {
+    return std::string{ reinterpret_cast<char const*>(buffer.data() + first), count };
+  };
+
+  { // padding
+    auto rest = encode<wire_string<8>>(buffer, "AAPL"sv);
+    rest = encode<wire_string<8, wire_padding::space>>(rest, fixed_string<4>{ "MSFT" });
+    rest = encode<wire_string<8, wire_padding::length_prefix>>(rest, "IBM  "sv);
+    CHECK(rest.size() == buffer.size() - 25);
+    CHECK(bytes(0, 25) == std::string{ "AAPL\0\0\0\0MSFT    \5IBM  \0\0\0"sv });
+
+    auto const in = std::span<std::byte const>{ buffer };
+    CHECK(decode<wire_string<8>>(in) == "AAPL");
+    CHECK(decode<wire_string<8, wire_padding::space>>(in.subspan(8)) == "MSFT");
+    CHECK(decode<wire_string<8, wire_padding::length_prefix>>(in.subspan(16)) == "IBM  ");
+    // decoded `char` fields point into the buffer
+    CHECK(decode<wire_string<8>>(in).data() == reinterpret_cast<char const*>(buffer.data()));
+
+    encode<wire_string<4>>(buffer, fixed_string<4>{ "FULL" });
+    CHECK(decode<wire_string<4>>(buffer) == "FULL");
+    encode<wire_string<4, wire_padding::space>>(buffer, ""sv);
+    CHECK(decode<wire_string<4, wire_padding::space>>(buffer).empty());
+  }
+
+  { // byte order
+    using big = wire_u16string<3>;
+    using little = wire_u16string<3, wire_padding::length_prefix, std::endian::little>;
+    encode<big>(buffer, u"ét"sv);
+    encode<little>(std::span{ buffer }.subspan(big::size), fixed_u16string<2>{ u"ét" });
+    CHECK(bytes(0, 13) == std::string{ "\0\xe9\0t\0\0\2\xe9\0t\0\0\0"sv });
+    CHECK(decode<big>(buffer) == u"ét"sv);
+    CHECK(decode<little>(std::span{ buffer }.subspan(big::size)) == u"ét"sv);
+
+    using space = wire_u32string<2, wire_padding::space, std::endian::little>;
+    encode<space>(buffer, U"\U0001F600"sv);
+    CHECK(bytes(0, 8) == std::string{ "\0\xf6\1\0 \0\0\0"sv });
+    CHECK(decode<space>(buffer) == basic_inplace_string<char32_t, 2>{ U"\U0001F600" });
+  }
+
+  { // layouts
+    using order = wire_layout<wire_string<4>, wire_u16string<2, wire_padding::space>,
+                              wire_string<6, wire_padding::length_prefix>>;
+    static_assert(order::size() == 15);
+    static_assert(order::offset<0> == 0 && order::offset<1> == 4 && order::offset<2> == 8);
+    using values = std::tuple<std::string_view, inplace_u16string<2>, std::string_view>;
+    static_assert(std::same_as<order::value_type, values>);
+
+    CHECK(order::encode(buffer, fixed_string<3>{ "BUY" }, u"X"sv, "ACME"sv).size()
+          == buffer.size() - 15);
+    CHECK(bytes(0, 15) == std::string{ "BUY\0\0X\0 \4ACME\0\0"sv });
+    auto const [side, venue, symbol] = order::decode(buffer);
+    CHECK(side == "BUY");
+    CHECK(venue == u"X"sv);
+    CHECK(symbol == "ACME");
+  }
+
+#ifndef MTP_NO_EXCEPTIONS
+  auto const small = std::span{ buffer }.first(7);
+  CHECK_THROWS_WITH_AS(encode<wire_string<8>>(small, "A"sv), "mtp::encode", std::out_of_range);
+  CHECK_THROWS_WITH_AS(std::ignore = decode<wire_string<8>>(small), "mtp::decode",
+                       std::out_of_range);
+  CHECK_THROWS_WITH_AS(encode<wire_string<2>>(buffer, "ABC"sv), "mtp::encode", std::length_error);
+  CHECK_THROWS_WITH_AS(wire_layout<wire_string<8>>::encode(small, "A"sv),
+                       "mtp::wire_layout::encode", std::out_of_range);
+  using prefixed = wire_string<8, wire_padding::length_prefix>;
+  buffer[0] = std::byte{ 9 };
+  CHECK_THROWS_WITH_AS(std::ignore = decode<prefixed>(buffer), "mtp::decode", std::length_error);
+#endif
+  static_assert(!detail::wire_value<fixed_string<3>, wire_string<2>>);
+  static_assert(detail::wire_value<fixed_string<2>, wire_string<2>>);
+}
+
+TEST_CASE("enum_names")
+{
+  enum class ord_status : char
+  {
+    fresh,
+    partially_filled,
+    filled,
+    reserved,
+    canceled,
+  };
+  using statuses = enum_names<ord_status, "NEW", "PARTIALLY_FILLED", "FILLED", "", "CANCELED">;
+  static_assert(statuses::size() == 5);
+  static_assert(statuses::name(ord_status::partially_filled) == "PARTIALLY_FILLED");
+  static_assert(statuses::value("CANCELED") == ord_status::canceled);
+
+  for (auto const s : { ord_status::fresh, ord_status::partially_filled, ord_status::filled,
+                        ord_status::canceled }) {
+    CHECK(statuses::value(statuses::name(s)) == s);
+  }
+  CHECK(statuses::name(ord_status::reserved).empty());
+  CHECK(statuses::name(static_cast<ord_status>(5)).empty());
+  CHECK(statuses::name(static_cast<ord_status>(-1)).empty());
+  for (auto const sv : { ""sv, "NEWS"sv, "NE"sv, "FILLEE"sv, "new"sv, "CANCELLED"sv }) {
+    CHECK(!statuses::value(sv));
+  }
+
+  enum class plain
+  {
+    a,
+    b,
+  };
+  static_assert(enum_names<plain, u"α", u"β">::name(plain::b) == u"β");
+  static_assert(enum_names<plain, "">::value("") == std::nullopt);
+
+  enum class access : unsigned char
+  {
+    read = 1,
+    write = 2,
+    exec = 8,
+  };
+  using accesses = flag_names<access, "READ", "WRITE", "", "EXEC">;
+  static_assert(accesses::name(access::exec) == "EXEC");
+  static_assert(accesses::name(static_cast<access>(3)).empty());
+  static_assert(accesses::value("WRITE") == access::write);
+
+  CHECK(accesses::format(static_cast<access>(0)).empty());
+  CHECK(accesses::format(access::write) == "WRITE");
+  CHECK(accesses::format(static_cast<access>(11)) == "READ|WRITE|EXEC");
+  CHECK(accesses::format(static_cast<access>(0xF5)) == "READ|0xf4");
+  CHECK(accesses::format<','>(static_cast<access>(0xFF)) == "READ,WRITE,EXEC,0xf4");
+  using formatted = decltype(accesses::format(access::read));
+  static_assert(formatted::capacity() >= "READ|WRITE|EXEC|0xff"sv.size());
+
+  CHECK(accesses::parse("") == static_cast<access>(0));
+  CHECK(accesses::parse("EXEC|READ") == static_cast<access>(9));
+  CHECK(accesses::parse<','>("WRITE,EXEC") == static_cast<access>(10));
+  for (auto const sv : { "READ|"sv, "|READ"sv, "READ||EXEC"sv, "READ|0x4"sv, "READ,EXEC"sv }) {
+    CHECK(!accesses::parse(sv));
+  }
+}